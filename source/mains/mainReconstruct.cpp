@@ -218,6 +218,142 @@ int main( int argc, char * argv[] )
         std::cout << " ---  DONE  ---  ;)" << std::endl;
     }
 
+    if( false )
+    {
+        auto reconstructionResult = recons::OSSART( tomoGeometry.get(), projectionsImage, 5, 8, 0.5F, std::nullopt, resultDirPath );
+        if( reconstructionResult.has_error() )
+        {
+            std::cout << PrintErrorCode( reconstructionResult.error() );
+            glob::WaitForKeyTyping();
+            return 1;
+        }
+        auto resultingVolume = reconstructionResult.value();
+
+        auto tiffWriterBackProj = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterBackProj->SetFileName( ( resultDirPath + "OSSARTReconstructedImage.tiff" ).c_str() );
+        tiffWriterBackProj->SetInputData( resultingVolume );
+        tiffWriterBackProj->Write();
+        std::cout << "OS-SART reconstruction performed" << std::endl;
+        std::cout << " ---  DONE  ---  ;)" << std::endl;
+    }
+
+    if( false )
+    {
+        auto reconstructionResult = recons::OSEM( tomoGeometry.get(), projectionsImage, 5, 8, 1.F, std::nullopt, resultDirPath );
+        if( reconstructionResult.has_error() )
+        {
+            std::cout << PrintErrorCode( reconstructionResult.error() );
+            glob::WaitForKeyTyping();
+            return 1;
+        }
+        auto resultingVolume = reconstructionResult.value();
+
+        auto tiffWriterBackProj = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterBackProj->SetFileName( ( resultDirPath + "OSEMReconstructedImage.tiff" ).c_str() );
+        tiffWriterBackProj->SetInputData( resultingVolume );
+        tiffWriterBackProj->Write();
+        std::cout << "OSEM reconstruction performed" << std::endl;
+        std::cout << " ---  DONE  ---  ;)" << std::endl;
+    }
+
+    if( false )
+    {
+        auto reconstructionResult = recons::CGLS( tomoGeometry.get(), projectionsImage, 10, std::nullopt, resultDirPath );
+        if( reconstructionResult.has_error() )
+        {
+            std::cout << PrintErrorCode( reconstructionResult.error() );
+            glob::WaitForKeyTyping();
+            return 1;
+        }
+        auto resultingVolume = reconstructionResult.value();
+
+        auto tiffWriterBackProj = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterBackProj->SetFileName( ( resultDirPath + "CGLSReconstructedImage.tiff" ).c_str() );
+        tiffWriterBackProj->SetInputData( resultingVolume );
+        tiffWriterBackProj->Write();
+        std::cout << "CGLS reconstruction performed" << std::endl;
+        std::cout << " ---  DONE  ---  ;)" << std::endl;
+    }
+
+    if( false )
+    {
+        auto reconstructionResult = recons::ChambollePockTV( tomoGeometry.get(), projectionsImage, 50, 0.01F, std::nullopt, resultDirPath );
+        if( reconstructionResult.has_error() )
+        {
+            std::cout << PrintErrorCode( reconstructionResult.error() );
+            glob::WaitForKeyTyping();
+            return 1;
+        }
+        auto resultingVolume = reconstructionResult.value();
+
+        auto tiffWriterBackProj = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterBackProj->SetFileName( ( resultDirPath + "TVReconstructedImage.tiff" ).c_str() );
+        tiffWriterBackProj->SetInputData( resultingVolume );
+        tiffWriterBackProj->Write();
+        std::cout << "TV reconstruction performed" << std::endl;
+        std::cout << " ---  DONE  ---  ;)" << std::endl;
+    }
+
+    if( false )
+    {
+        auto reconstructionResult = recons::FBP( tomoGeometry.get(), projectionsImage, FilterParameters{ 0.8F, 1.F }, resultDirPath );
+        if( reconstructionResult.has_error() )
+        {
+            std::cout << PrintErrorCode( reconstructionResult.error() );
+            glob::WaitForKeyTyping();
+            return 1;
+        }
+        auto resultingVolume = reconstructionResult.value();
+
+        auto tiffWriterBackProj = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterBackProj->SetFileName( ( resultDirPath + "FBPReconstructedImage.tiff" ).c_str() );
+        tiffWriterBackProj->SetInputData( resultingVolume );
+        tiffWriterBackProj->Write();
+        std::cout << "FBP reconstruction performed" << std::endl;
+        std::cout << " ---  DONE  ---  ;)" << std::endl;
+    }
+
+    if( false )
+    {
+        auto reconstructionResult = recons::MITS( tomoGeometry.get(), projectionsImage, 0.01F, resultDirPath );
+        if( reconstructionResult.has_error() )
+        {
+            std::cout << PrintErrorCode( reconstructionResult.error() );
+            glob::WaitForKeyTyping();
+            return 1;
+        }
+        auto resultingVolume = reconstructionResult.value();
+
+        auto tiffWriterBackProj = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterBackProj->SetFileName( ( resultDirPath + "MITSReconstructedImage.tiff" ).c_str() );
+        tiffWriterBackProj->SetInputData( resultingVolume );
+        tiffWriterBackProj->Write();
+        std::cout << "MITS reconstruction performed" << std::endl;
+        std::cout << " ---  DONE  ---  ;)" << std::endl;
+    }
+
+    if( false )
+    {
+        auto mlem = []( TomoGeometry * p_geometry, ImageDataPtr p_projections, int p_iterationNumber, std::optional<ImageDataPtr> p_initialVolume, std::optional<std::string> p_outputDirectoryPath ) {
+            return recons::MLEM( p_geometry, p_projections, p_iterationNumber, 1.F, p_initialVolume, p_outputDirectoryPath );
+        };
+        auto reconstructionResult = recons::Multiresolution( tomoGeometry.get(), projectionsImage, { { 4, 4 }, { 2, 3 }, { 1, 2 } }, mlem, std::nullopt, resultDirPath );
+        if( reconstructionResult.has_error() )
+        {
+            std::cout << PrintErrorCode( reconstructionResult.error() );
+            glob::WaitForKeyTyping();
+            return 1;
+        }
+        auto resultingVolume = reconstructionResult.value();
+
+        auto tiffWriterBackProj = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterBackProj->SetFileName( ( resultDirPath + "multiresolutionMLEMReconstructedImage.tiff" ).c_str() );
+        tiffWriterBackProj->SetInputData( resultingVolume );
+        tiffWriterBackProj->Write();
+        std::cout << "Multiresolution MLEM reconstruction performed" << std::endl;
+        std::cout << " ---  DONE  ---  ;)" << std::endl;
+    }
+
     glob::WaitForKeyTyping();
     return 0;
 }
\ No newline at end of file
@@ -1,49 +1,60 @@
 #include "modules/dataHandling/PhantomMaker.h"
+#include "modules/geometry/PositionsBatch.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <execution>
-#include <numeric>
 #include <vector>
 
 
 ImageDataPtr PhantomMaker::GetPhantom() const
 {
     // todo: add some checks
-    auto indices = m_volume->GetVoxelsIndices() ;
-    auto voxelsGridPositions = m_volume->GetGridPositions() ;
-    std::vector<float> voxelsDensities( indices.size() );
-    auto phantomFiller = [this, &voxelsGridPositions, &voxelsDensities]( int p_index ) {
-        voxelsDensities[p_index] = m_backgroundDensity;
+    auto size = m_volume->GetSize3D();
+    auto voxelSpacing = m_volume->GetVoxelSpacing();
+    auto outputVtkImage = ImageDataPtr::New();
+    outputVtkImage->SetDimensions( size.x, size.y, size.z );
+    outputVtkImage->SetSpacing( voxelSpacing.x, voxelSpacing.y, voxelSpacing.z );
+    outputVtkImage->AllocateScalars( VTK_FLOAT, 1 );
+
+    // one batch of positions per row of voxels, the containment tests being vectorized along the row. The densities
+    // are written in place
+    const auto voxelGrid = m_volume->GetVoxelGrid();
+    const auto rowLength = size.x;
+    auto voxelsDensities = static_cast<float *>( outputVtkImage->GetScalarPointer() );
+    const auto xPositions = voxelGrid.GetXPositions();
+    const std::vector<float> rowXPositions( xPositions.begin(), xPositions.end() );
+    auto rowFiller = [this, &voxelGrid, &rowXPositions, rowLength, voxelsDensities]( int p_rowIndex ) {
+        const auto firstVoxel = voxelGrid.GetVoxel( p_rowIndex * rowLength );
+        // the batch and the mask of the row, grown once per worker thread
+        thread_local Positions3DBatch positions;
+        thread_local std::vector<uint8_t> isInside;
+        positions.x = rowXPositions;
+        positions.y.assign( rowLength, voxelGrid.GetYPositions()[firstVoxel.y] );
+        positions.z.assign( rowLength, voxelGrid.GetZPositions()[firstVoxel.z] );
+        isInside.resize( rowLength );
+        auto densities = voxelsDensities + static_cast<size_t>( p_rowIndex ) * rowLength;
+        std::fill_n( densities, rowLength, m_backgroundDensity );
         for( const auto & paveAndDensity : m_paves )
         {
-            if( paveAndDensity.pave.Contains( voxelsGridPositions[p_index] ) )
+            positions.IsInside( paveAndDensity.pave, isInside.data() );
+            for( auto x{ 0 }; x < rowLength; x++ )
             {
-                voxelsDensities[p_index] += paveAndDensity.density;
+                densities[x] += isInside[x] ? paveAndDensity.density : 0.F;
             }
         }
         for( const auto & sphereAndDensity : m_spheres )
         {
-            if( sphereAndDensity.sphere.Contains( voxelsGridPositions[p_index] ) )
+            positions.IsInside( sphereAndDensity.sphere, isInside.data() );
+            for( auto x{ 0 }; x < rowLength; x++ )
             {
-                voxelsDensities[p_index] += sphereAndDensity.density;
+                densities[x] += isInside[x] ? sphereAndDensity.density : 0.F;
             }
         }
     };
 
-
-    std::for_each( std::execution::par_unseq, indices.cbegin(), indices.cend(), phantomFiller );
-
-    auto size = m_volume->GetSize3D();
-
-    auto voxelSpacing = m_volume->GetVoxelSpacing();
-    auto outputVtkImage = ImageDataPtr::New();
-    outputVtkImage->SetDimensions( size.x, size.y, size.z );
-    outputVtkImage->SetSpacing( voxelSpacing.x, voxelSpacing.y, voxelSpacing.z );
-
-    auto byteCount = voxelsDensities.size() * sizeof( float );
-    outputVtkImage->AllocateScalars( VTK_FLOAT, 1 );
-    // copy the internal cv::Mat data into the vtkImageData pointer
-    std::memcpy( outputVtkImage->GetScalarPointer(), voxelsDensities.data(), byteCount );
+    const IndexRange rows{ size.y * size.z };
+    std::for_each( std::execution::par, rows.begin(), rows.end(), rowFiller );
 
     outputVtkImage->Modified();
 
@@ -36,25 +36,6 @@ struct Cylinder
     {}
 
 
-    Cylinder( const Cylinder & p_originalCylinder )
-      : basisCenter( p_originalCylinder.basisCenter )
-      , orientation( p_originalCylinder.orientation )
-      , basisRadius( p_originalCylinder.basisRadius )
-      , height( p_originalCylinder.height )
-    {}
-
-    Cylinder & operator=( const Cylinder & p_originalCylinder )
-    {
-        if( this != &p_originalCylinder )
-        {
-            basisCenter = p_originalCylinder.basisCenter;
-            orientation = p_originalCylinder.orientation;
-            basisRadius = p_originalCylinder.basisRadius;
-            height = p_originalCylinder.height;
-        }
-        return *this;
-    }
-
     bool Contains( const Position3D & p_point ) const
     {
         if( orientation == Axis::X )
@@ -17,41 +17,28 @@ struct Dim2
 { 
     Dim2() = delete;
  
-    Dim2( T const & p_x, T const & p_y)
+    constexpr Dim2( T const & p_x, T const & p_y)
+      : x{ p_x }
+      , y{ p_y }
     { 
-        x = p_x;
-        y = p_y;
-    } 
- 
-    Dim2( Dim2<T> const & p_original)
-    { 
-        x = p_original.x;
-        y = p_original.y;
     } 
 
-    virtual ~Dim2() = default;
+    // implicit copy and destruction: the geometric values stay trivially copyable
 
-    Dim2 & operator*=( T p_lambda )
+    constexpr Dim2 & operator*=( T p_lambda )
     {
         x *= p_lambda;
         y *= p_lambda;
         return *this;
     }
 
-    Dim2 & operator=( Dim2<T> const & p_original )
-    {
-        x = p_original.x;
-        y = p_original.y;
-        return *this;
-    }
- 
-    friend Dim2 operator*( T p_lambda, Dim2 p_rhs )
+    friend constexpr Dim2 operator*( T p_lambda, Dim2 p_rhs )
     {
         p_rhs *= p_lambda;
         return p_rhs;
     }
 
-    friend Dim2 operator*( Dim2 p_lhs, T p_lambda )
+    friend constexpr Dim2 operator*( Dim2 p_lhs, T p_lambda )
     {
         p_lhs *= p_lambda;
         return p_lhs;
@@ -96,9 +83,13 @@ struct Dim2
     T x{ 0 };
     T y{ 0 };
 
-    int const size = glob::TWO;
+    static constexpr int size = glob::TWO;
 };
 
+// the coordinates are copied raw, e.g. by the positions batches
+static_assert( std::is_trivially_copyable_v<Dim2<float>> && std::is_standard_layout_v<Dim2<float>> && sizeof( Dim2<float> ) == 2 * sizeof( float ) );
+static_assert( std::is_trivially_copyable_v<Dim2<int>> && std::is_standard_layout_v<Dim2<int>> && sizeof( Dim2<int> ) == 2 * sizeof( int ) );
+
 template<typename T>
 std::ostream &operator<<(std::ostream &p_outputStream, Dim2<T> const & p_data) { 
     return p_outputStream << "(" << p_data.x << "," << p_data.y << ")";
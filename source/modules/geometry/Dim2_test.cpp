@@ -1,7 +1,15 @@
 #include "modules/geometry/Dim2.h"
+#include "modules/geometry/Pixel.h"
+#include "modules/geometry/PixelSpacing.h"
+#include "modules/geometry/Position2D.h"
+#include "modules/geometry/Size2D.h"
+#include "modules/geometry/Vector2D.h"
+#include "modules/geometry/WSize2D.h"
 #include "test_utils/GenericMethods.h" 
 #include "test_utils/TestInitializer.h"
 
+#include <type_traits>
+
 constexpr int nbRepetitions = 100;
  
 int main( int p_argc, char ** p_argv )
@@ -259,5 +267,11 @@ TEST( Dim2Test, FromStringWithWrongValues)
     floatPoint = Dim2<float>::FromString(stringValues) ;
     EXPECT_FALSE(floatPoint.has_value());
 }
- 
- 
\ No newline at end of file
+
+TEST( Dim2Test, DerivedValuesAreTriviallyCopyable )
+{
+    static_assert( std::is_trivially_copyable_v<Position2D> && std::is_trivially_copyable_v<Pixel> && std::is_trivially_copyable_v<Size2D>
+                   && std::is_trivially_copyable_v<PixelSpacing> && std::is_trivially_copyable_v<Vector2D> && std::is_trivially_copyable_v<WSize2D> );
+    static_assert( sizeof( Position2D ) == 2 * sizeof( float ) && sizeof( Pixel ) == 2 * sizeof( int ) );
+    static_assert( Dim2<int>::size == 2 );
+}
@@ -7,50 +7,36 @@
 #include <array>  
 #include <numeric>
 #include <optional>
+#include <type_traits>
 
 template<typename T>
 struct Dim3
 {    
     Dim3() = delete;
  
-    Dim3( T const & p_x, T const & p_y, T const & p_z)
+    constexpr Dim3( T const & p_x, T const & p_y, T const & p_z)
+      : x{ p_x }
+      , y{ p_y }
+      , z{ p_z }
     { 
-        x = p_x;
-        y = p_y;
-        z = p_z;
     } 
 
-    Dim3( Dim3<T> const & p_original)
-    { 
-        x = p_original.x;
-        y = p_original.y;
-        z = p_original.z;
-    } 
-
-    virtual ~Dim3() = default;
+    // implicit copy and destruction: the geometric values stay trivially copyable
  
-    Dim3 & operator*=( T p_lambda )
+    constexpr Dim3 & operator*=( T p_lambda )
     {
         x *= p_lambda;
         y *= p_lambda;
         z *= p_lambda;
         return *this;
     }
-    Dim3 & operator=( Dim3<T> const & p_original)
-    { 
-        x = p_original.x;
-        y = p_original.y;
-        z = p_original.z;
-        return *this;
-    } 
-
-    friend Dim3 operator*( T p_lambda, Dim3 p_rhs )
+    friend constexpr Dim3 operator*( T p_lambda, Dim3 p_rhs )
     {
         p_rhs *= p_lambda;
         return p_rhs;
     }
 
-    friend Dim3 operator*( Dim3 p_lhs, T p_lambda )
+    friend constexpr Dim3 operator*( Dim3 p_lhs, T p_lambda )
     {
         p_lhs *= p_lambda;
         return p_lhs;
@@ -98,9 +84,13 @@ struct Dim3
     T y{ 0 };
     T z{ 0 };
     
-    int const size = glob::THREE;
+    static constexpr int size = glob::THREE;
 };
 
+// the coordinates are copied raw, e.g. by the positions batches
+static_assert( std::is_trivially_copyable_v<Dim3<float>> && std::is_standard_layout_v<Dim3<float>> && sizeof( Dim3<float> ) == 3 * sizeof( float ) );
+static_assert( std::is_trivially_copyable_v<Dim3<int>> && std::is_standard_layout_v<Dim3<int>> && sizeof( Dim3<int> ) == 3 * sizeof( int ) );
+
 template<typename T>
 std::ostream &operator<<(std::ostream &p_outputStream, Dim3<T> const & p_data) { 
     return p_outputStream << "(" << p_data.x << "," << p_data.y << "," << p_data.z << ")";
@@ -1,9 +1,17 @@
 #include "modules/geometry/Dim3.h"
+#include "modules/geometry/Position3D.h"
+#include "modules/geometry/Size3D.h"
+#include "modules/geometry/Vector3D.h"
+#include "modules/geometry/Voxel.h"
+#include "modules/geometry/VoxelSpacing.h"
 #include "test_utils/GenericMethods.h" 
 #include "test_utils/TestInitializer.h"
 
 #include <array>
+#include <cstring>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 constexpr int nbRepetitions = 100;
  
@@ -279,4 +287,20 @@ TEST( Dim3Test, FromStringWithWrongValues)
     floatPoint = Dim3<float>::FromString(stringValues) ;
     EXPECT_FALSE(floatPoint.has_value());
 }
- 
+
+TEST( Dim3Test, DerivedValuesAreTriviallyCopyable )
+{
+    static_assert( std::is_trivially_copyable_v<Position3D> && std::is_trivially_copyable_v<Voxel> && std::is_trivially_copyable_v<Size3D>
+                   && std::is_trivially_copyable_v<VoxelSpacing> && std::is_trivially_copyable_v<Vector3D> );
+    static_assert( sizeof( Position3D ) == 3 * sizeof( float ) && sizeof( Voxel ) == 3 * sizeof( int ) );
+    constexpr Position3D position( 1.F, 2.F, 3.F );
+    constexpr auto scaled = position * 2.F;
+    static_assert( scaled.x == 2.F && scaled.y == 4.F && scaled.z == 6.F );
+    static_assert( Dim3<int>::size == 3 );
+
+    // raw copy of packed coordinates, Position3D having no trivial default constructor
+    std::vector<Position3D> positions( 4, Position3D( 0.F, 0.F, 0.F ) );
+    const std::vector<float> coordinates = { 1.F, 2.F, 3.F, 4.F, 5.F, 6.F, 7.F, 8.F, 9.F, 10.F, 11.F, 12.F };
+    std::memcpy( static_cast<void *>( positions.data() ), coordinates.data(), coordinates.size() * sizeof( float ) );
+    EXPECT_EQ( positions[2], Position3D( 7.F, 8.F, 9.F ) );
+}
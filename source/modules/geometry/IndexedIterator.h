@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// Random access iterator over the values p_function( index ), computed on dereference: the lazy geometric views
+// (voxel grid, detector pixels) are ranges of such iterators, usable by the standard (parallel) algorithms without
+// materializing one element per voxel or pixel
+template <typename Function>
+class IndexedIterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = decltype( std::declval<const Function &>()( std::ptrdiff_t{ 0 } ) );
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    IndexedIterator() = default;
+    IndexedIterator( const Function & p_function, std::ptrdiff_t p_index )
+      : m_function{ p_function }
+      , m_index{ p_index }
+    {
+    }
+
+    value_type operator*() const { return m_function( m_index ); }
+    value_type operator[]( difference_type p_offset ) const { return m_function( m_index + p_offset ); }
+
+    IndexedIterator & operator++()
+    {
+        m_index++;
+        return *this;
+    }
+    IndexedIterator operator++( int )
+    {
+        auto previous = *this;
+        m_index++;
+        return previous;
+    }
+    IndexedIterator & operator--()
+    {
+        m_index--;
+        return *this;
+    }
+    IndexedIterator operator--( int )
+    {
+        auto previous = *this;
+        m_index--;
+        return previous;
+    }
+    IndexedIterator & operator+=( difference_type p_offset )
+    {
+        m_index += p_offset;
+        return *this;
+    }
+    IndexedIterator & operator-=( difference_type p_offset )
+    {
+        m_index -= p_offset;
+        return *this;
+    }
+
+    friend IndexedIterator operator+( IndexedIterator p_iterator, difference_type p_offset ) { return p_iterator += p_offset; }
+    friend IndexedIterator operator+( difference_type p_offset, IndexedIterator p_iterator ) { return p_iterator += p_offset; }
+    friend IndexedIterator operator-( IndexedIterator p_iterator, difference_type p_offset ) { return p_iterator -= p_offset; }
+    friend difference_type operator-( const IndexedIterator & p_lhs, const IndexedIterator & p_rhs ) { return p_lhs.m_index - p_rhs.m_index; }
+
+    // iterators of the same range only
+    friend bool operator==( const IndexedIterator & p_lhs, const IndexedIterator & p_rhs ) { return p_lhs.m_index == p_rhs.m_index; }
+    friend bool operator!=( const IndexedIterator & p_lhs, const IndexedIterator & p_rhs ) { return p_lhs.m_index != p_rhs.m_index; }
+    friend bool operator<( const IndexedIterator & p_lhs, const IndexedIterator & p_rhs ) { return p_lhs.m_index < p_rhs.m_index; }
+    friend bool operator>( const IndexedIterator & p_lhs, const IndexedIterator & p_rhs ) { return p_lhs.m_index > p_rhs.m_index; }
+    friend bool operator<=( const IndexedIterator & p_lhs, const IndexedIterator & p_rhs ) { return p_lhs.m_index <= p_rhs.m_index; }
+    friend bool operator>=( const IndexedIterator & p_lhs, const IndexedIterator & p_rhs ) { return p_lhs.m_index >= p_rhs.m_index; }
+
+private:
+    Function m_function{};
+    std::ptrdiff_t m_index{ 0 };
+};
+
+// Indices [0, count[, e.g. for the parallel loops over voxels or pixels
+struct IndexRange
+{
+    int count{ 0 };
+
+    int operator()( std::ptrdiff_t p_index ) const { return static_cast<int>( p_index ); }
+    int size() const { return count; }
+    IndexedIterator<IndexRange> begin() const { return { *this, 0 }; }
+    IndexedIterator<IndexRange> end() const { return { *this, count }; }
+};
@@ -24,23 +24,8 @@ struct Pave
       , wsize( p_xSize, p_ySize, p_zSize )
     {}
 
-    Pave( const Pave & p_originalPave )
-      : bottomLeftFront( p_originalPave.bottomLeftFront )
-      , wsize( p_originalPave.wsize )
-    {}
-
     friend std::ostream &operator<<(std::ostream &p_outputStream, Pave const & p_data) ;
 
-    Pave & operator=( const Pave & p_originalPave )
-    {
-        if( this != &p_originalPave )
-        {
-            bottomLeftFront = p_originalPave.bottomLeftFront;
-            wsize = p_originalPave.wsize;
-        }
-        return *this;
-    }
-
     Position3D GetTopRightBack() const
     {
         return Position3D{bottomLeftFront.x + wsize.x,bottomLeftFront.y + wsize.y,bottomLeftFront.z + wsize.z};
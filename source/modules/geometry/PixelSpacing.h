@@ -6,7 +6,6 @@ struct Size2D;
 struct WSize2D;
 struct PixelSpacing : public Dim2<float>
 {
-    PixelSpacing(float p_x,float p_y): Dim2<float>(p_x,p_y) {}
-    ~PixelSpacing() override = default;
+    constexpr PixelSpacing(float p_x,float p_y): Dim2<float>(p_x,p_y) {}
     static PixelSpacing FromSizes( const Size2D & p_dimensions, const WSize2D & p_sizeInWorld, bool & p_allDimensionsValid );
 };
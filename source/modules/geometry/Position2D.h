@@ -6,9 +6,8 @@ struct Vector2D;
 struct Pixel;
 struct Position2D : public Dim2<float>
 {  
-    Position2D(float p_x,float p_y): Dim2<float>(p_x,p_y) {}
+    constexpr Position2D(float p_x,float p_y): Dim2<float>(p_x,p_y) {}
     explicit Position2D(Pixel const & p_pixel);
-    ~Position2D() override = default;
     float DistanceL1To( const Position2D & p_point ) const;
     float DistanceL2To( const Position2D & p_point ) const;
     Position2D & operator+=( Vector2D const & p_rhs );
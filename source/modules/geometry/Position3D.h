@@ -6,9 +6,8 @@ struct Vector3D;
 struct Voxel;
 struct Position3D : public Dim3<float>
 {  
-    Position3D(float p_x,float p_y,float p_z): Dim3<float>(p_x,p_y,p_z) {}
+    constexpr Position3D(float p_x,float p_y,float p_z): Dim3<float>(p_x,p_y,p_z) {}
     explicit Position3D(Voxel const & p_voxel);
-    ~Position3D() override = default;
     float DistanceL1To( const Position3D & p_point ) const;
     float DistanceL2To( const Position3D & p_point ) const;
     Position3D & operator+=( Vector3D const & p_rhs );
@@ -0,0 +1,95 @@
+#include "modules/geometry/PositionsBatch.h"
+
+#include "commons/Maths.h"
+
+namespace    // anonymous namespace
+{
+// p_value >= p_bound up to AlmostEqualRelative, without branch (bitwise | on purpose) so that the loops vectorize
+inline bool IsAboveOrEqual( float p_value, float p_bound )
+{
+    return ( p_value > p_bound ) | AlmostEqualRelative( p_value, p_bound );
+}
+
+inline bool IsBelowOrEqual( float p_value, float p_bound )
+{
+    return ( p_value < p_bound ) | AlmostEqualRelative( p_value, p_bound );
+}
+}    // end of anonymous namespace
+
+void Positions3DBatch::Transform( const Dim3<float> & p_scale, const Vector3D & p_translation )
+{
+    const auto count = this->size();
+    auto xs = x.data();
+    auto ys = y.data();
+    auto zs = z.data();
+    for( auto index{ 0 }; index < count; index++ )
+    {
+        xs[index] = xs[index] * p_scale.x + p_translation.x;
+        ys[index] = ys[index] * p_scale.y + p_translation.y;
+        zs[index] = zs[index] * p_scale.z + p_translation.z;
+    }
+}
+
+void Positions3DBatch::IsInside( const Pave & p_pave, uint8_t * p_mask ) const
+{
+    const auto count = this->size();
+    const auto xs = x.data();
+    const auto ys = y.data();
+    const auto zs = z.data();
+    // copies: the mask writes could alias the parameters
+    const auto bottomLeftFront = p_pave.bottomLeftFront;
+    const auto topRightBack = p_pave.GetTopRightBack();
+    for( auto index{ 0 }; index < count; index++ )
+    {
+        const auto isInside = IsAboveOrEqual( xs[index], bottomLeftFront.x ) & IsBelowOrEqual( xs[index], topRightBack.x ) & IsAboveOrEqual( ys[index], bottomLeftFront.y )
+                              & IsBelowOrEqual( ys[index], topRightBack.y ) & IsAboveOrEqual( zs[index], bottomLeftFront.z ) & IsBelowOrEqual( zs[index], topRightBack.z );
+        p_mask[index] = static_cast<uint8_t>( isInside );
+    }
+}
+
+void Positions3DBatch::IsInside( const Sphere & p_sphere, uint8_t * p_mask ) const
+{
+    const auto count = this->size();
+    const auto xs = x.data();
+    const auto ys = y.data();
+    const auto zs = z.data();
+    // copies: the mask writes could alias the parameters
+    const auto center = p_sphere.center;
+    const auto squaredRadius = p_sphere.radius * p_sphere.radius;
+    for( auto index{ 0 }; index < count; index++ )
+    {
+        const auto lagX = center.x - xs[index];
+        const auto lagY = center.y - ys[index];
+        const auto lagZ = center.z - zs[index];
+        p_mask[index] = static_cast<uint8_t>( lagX * lagX + lagY * lagY + lagZ * lagZ < squaredRadius );
+    }
+}
+
+void Positions2DBatch::Transform( const Dim2<float> & p_scale, const Vector2D & p_translation )
+{
+    const auto count = this->size();
+    auto xs = x.data();
+    auto ys = y.data();
+    for( auto index{ 0 }; index < count; index++ )
+    {
+        xs[index] = xs[index] * p_scale.x + p_translation.x;
+        ys[index] = ys[index] * p_scale.y + p_translation.y;
+    }
+}
+
+void Positions2DBatch::IsInside( const Position2D & p_bottomLeft, const WSize2D & p_wsize, uint8_t * p_mask ) const
+{
+    const auto count = this->size();
+    const auto xs = x.data();
+    const auto ys = y.data();
+    // copies: the mask writes could alias the parameters
+    const auto left = p_bottomLeft.x;
+    const auto bottom = p_bottomLeft.y;
+    const auto right = p_bottomLeft.x + p_wsize.x;
+    const auto top = p_bottomLeft.y + p_wsize.y;
+    for( auto index{ 0 }; index < count; index++ )
+    {
+        const auto isInside = IsAboveOrEqual( xs[index], left ) & ( xs[index] < right ) & IsAboveOrEqual( ys[index], bottom ) & ( ys[index] < top );
+        p_mask[index] = static_cast<uint8_t>( isInside );
+    }
+}
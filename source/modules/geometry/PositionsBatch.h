@@ -0,0 +1,113 @@
+#pragma once
+
+#include "modules/geometry/Dim2.h"
+#include "modules/geometry/Dim3.h"
+#include "modules/geometry/Pave.h"
+#include "modules/geometry/Position2D.h"
+#include "modules/geometry/Position3D.h"
+#include "modules/geometry/Sphere.h"
+#include "modules/geometry/Vector2D.h"
+#include "modules/geometry/Vector3D.h"
+#include "modules/geometry/WSize2D.h"
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// Structure of arrays of 3D positions for the bulk geometric work: each coordinate being contiguous, the transform and
+// containment loops have no per position call and are vectorized by the compiler. Sequential, the callers parallelize
+// over batches (e.g. one batch per row of voxels)
+struct Positions3DBatch
+{
+    Positions3DBatch() = default;
+    explicit Positions3DBatch( int p_size ) { this->Resize( p_size ); }
+    // any range of Position3D: std::vector, VoxelGrid, ...
+    template <typename Iterator>
+    Positions3DBatch( Iterator p_first, Iterator p_last )
+    {
+        this->Assign( p_first, p_last );
+    }
+
+    int size() const { return static_cast<int>( x.size() ); }
+    void Resize( int p_size )
+    {
+        x.resize( p_size );
+        y.resize( p_size );
+        z.resize( p_size );
+    }
+    template <typename Iterator>
+    void Assign( Iterator p_first, Iterator p_last )
+    {
+        this->Resize( static_cast<int>( std::distance( p_first, p_last ) ) );
+        for( auto index{ 0 }; p_first != p_last; p_first++, index++ )
+        {
+            this->Set( index, *p_first );
+        }
+    }
+
+    Position3D operator[]( int p_index ) const { return Position3D( x[p_index], y[p_index], z[p_index] ); }
+    void Set( int p_index, const Position3D & p_position )
+    {
+        x[p_index] = p_position.x;
+        y[p_index] = p_position.y;
+        z[p_index] = p_position.z;
+    }
+
+    // position * p_scale + p_translation, component wise
+    void Transform( const Dim3<float> & p_scale, const Vector3D & p_translation );
+
+    // p_mask[i] = 1 when the position i is inside the shape (same bounds as Pave::Contains and Sphere::Contains), 0
+    // otherwise. p_mask holds size() elements
+    void IsInside( const Pave & p_pave, uint8_t * p_mask ) const;
+    void IsInside( const Sphere & p_sphere, uint8_t * p_mask ) const;
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+};
+
+// Structure of arrays of 2D positions, e.g. detector pixels
+struct Positions2DBatch
+{
+    Positions2DBatch() = default;
+    explicit Positions2DBatch( int p_size ) { this->Resize( p_size ); }
+    // any range of Position2D: std::vector, ProjectionPixelsGrid, ...
+    template <typename Iterator>
+    Positions2DBatch( Iterator p_first, Iterator p_last )
+    {
+        this->Assign( p_first, p_last );
+    }
+
+    int size() const { return static_cast<int>( x.size() ); }
+    void Resize( int p_size )
+    {
+        x.resize( p_size );
+        y.resize( p_size );
+    }
+    template <typename Iterator>
+    void Assign( Iterator p_first, Iterator p_last )
+    {
+        this->Resize( static_cast<int>( std::distance( p_first, p_last ) ) );
+        for( auto index{ 0 }; p_first != p_last; p_first++, index++ )
+        {
+            this->Set( index, *p_first );
+        }
+    }
+
+    Position2D operator[]( int p_index ) const { return Position2D( x[p_index], y[p_index] ); }
+    void Set( int p_index, const Position2D & p_position )
+    {
+        x[p_index] = p_position.x;
+        y[p_index] = p_position.y;
+    }
+
+    // position * p_scale + p_translation, component wise
+    void Transform( const Dim2<float> & p_scale, const Vector2D & p_translation );
+
+    // p_mask[i] = 1 when the position i is inside the rectangle [bottomLeft, bottomLeft + wsize[ (same bounds as
+    // TomoProjectionsSet::ContainsInside), 0 otherwise. p_mask holds size() elements
+    void IsInside( const Position2D & p_bottomLeft, const WSize2D & p_wsize, uint8_t * p_mask ) const;
+
+    std::vector<float> x;
+    std::vector<float> y;
+};
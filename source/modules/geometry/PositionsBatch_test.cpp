@@ -0,0 +1,84 @@
+#include "modules/geometry/PositionsBatch.h"
+#include "modules/geometry/Size3D.h"
+#include "modules/geometry/VoxelGrid.h"
+#include "test_utils/TestInitializer.h"
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( PositionsBatchTest, ShapesAreTriviallyCopyable )
+{
+    static_assert( std::is_trivially_copyable_v<Pave> && std::is_trivially_copyable_v<Sphere> && sizeof( Pave ) == 6 * sizeof( float ) );
+}
+
+TEST( PositionsBatchTest, BatchOperationsMatchScalarOperations )
+{
+    std::mt19937 generator( 7 );
+    std::uniform_real_distribution<float> distribution( -20.F, 20.F );
+    std::vector<Position3D> positions;
+    for( auto index{ 0 }; index < 1003; index++ )
+    {
+        positions.emplace_back( distribution( generator ), distribution( generator ), distribution( generator ) );
+    }
+    const Pave pave( -5.F, -7.5F, 0.F, 10.F, 12.F, 8.F );
+    const Sphere sphere( 2.F, -1.F, 3.F, 9.F );
+    // bounds of the pave, inside with the scalar tests
+    positions.emplace_back( -5.F, -7.5F, 0.F );
+    positions.push_back( pave.GetTopRightBack() );
+
+    Positions3DBatch batch( positions.cbegin(), positions.cend() );
+    ASSERT_EQ( batch.size(), static_cast<int>( positions.size() ) );
+    std::vector<uint8_t> isInsidePave( positions.size() );
+    std::vector<uint8_t> isInsideSphere( positions.size() );
+    batch.IsInside( pave, isInsidePave.data() );
+    batch.IsInside( sphere, isInsideSphere.data() );
+    for( auto index{ 0 }; index < batch.size(); index++ )
+    {
+        EXPECT_EQ( batch[index], positions[index] );
+        EXPECT_EQ( isInsidePave[index] == 1, pave.Contains( positions[index] ) );
+        EXPECT_EQ( isInsideSphere[index] == 1, sphere.Contains( positions[index] ) );
+    }
+    EXPECT_EQ( isInsidePave.back(), 1 );
+
+    batch.Transform( Dim3<float>( 2.F, 0.5F, -1.F ), Vector3D( 1.F, 2.F, 3.F ) );
+    for( auto index{ 0 }; index < batch.size(); index++ )
+    {
+        const auto & position = positions[index];
+        EXPECT_EQ( batch[index], Position3D( position.x * 2.F + 1.F, position.y * 0.5F + 2.F, position.z * -1.F + 3.F ) );
+    }
+
+    // from a lazy view
+    const VoxelGrid voxelGrid( Position3D( -1.F, 0.F, 2.F ), VoxelSpacing( 0.5F, 1.F, 2.F ), Size3D( 8, 3, 2 ) );
+    const Positions3DBatch gridBatch( voxelGrid.begin(), voxelGrid.end() );
+    ASSERT_EQ( gridBatch.size(), voxelGrid.size() );
+    EXPECT_EQ( gridBatch[29], voxelGrid[29] );
+
+    std::vector<Position2D> positions2D;
+    for( auto index{ 0 }; index < 517; index++ )
+    {
+        positions2D.emplace_back( distribution( generator ), distribution( generator ) );
+    }
+    const Position2D bottomLeft( -3.F, 4.F );
+    const WSize2D wsize( 9.F, 6.F );
+    positions2D.push_back( bottomLeft );
+    Positions2DBatch batch2D( positions2D.cbegin(), positions2D.cend() );
+    std::vector<uint8_t> isInsideRectangle( positions2D.size() );
+    batch2D.IsInside( bottomLeft, wsize, isInsideRectangle.data() );
+    for( auto index{ 0 }; index < batch2D.size(); index++ )
+    {
+        const auto & position = positions2D[index];
+        const auto expected = ( position.x > bottomLeft.x || AlmostEqualRelative( position.x, bottomLeft.x ) ) && position.x < bottomLeft.x + wsize.x
+                              && ( position.y > bottomLeft.y || AlmostEqualRelative( position.y, bottomLeft.y ) ) && position.y < bottomLeft.y + wsize.y;
+        EXPECT_EQ( isInsideRectangle[index] == 1, expected );
+    }
+    EXPECT_EQ( isInsideRectangle.back(), 1 );
+    batch2D.Transform( Dim2<float>( 3.F, 1.F ), Vector2D( -1.F, 0.F ) );
+    EXPECT_EQ( batch2D[0], Position2D( positions2D[0].x * 3.F - 1.F, positions2D[0].y ) );
+}
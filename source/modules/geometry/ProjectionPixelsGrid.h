@@ -0,0 +1,72 @@
+#pragma once
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/geometry/Pixel.h"
+#include "modules/geometry/PixelOnProjection.h"
+#include "modules/geometry/PixelSpacing.h"
+#include "modules/geometry/Position2D.h"
+#include "modules/geometry/Size2D.h"
+#include "modules/geometry/VoxelGrid.h"
+
+#include <vector>
+
+// Positions of the pixels of a set of projections, computed from the pixel index instead of being stored: pixel
+// ( x, y ) of projection p, of index ( p * size.y + y ) * size.x + x, is at bottomLeft[p] + ( x, y ) * pixelSpacing.
+// Only the bottom left positions of the projections are stored
+class ProjectionPixelsGrid
+{
+public:
+    // per index computation, referencing the bottom left positions of the grid: the iterators of a grid are valid as
+    // long as the grid is
+    struct Positions
+    {
+        const Position2D * bottomLeftPositions{ nullptr };
+        float xSpacing{ 0.F };
+        float ySpacing{ 0.F };
+        int xCount{ 0 };
+        int yCount{ 0 };
+
+        Position2D operator()( std::ptrdiff_t p_index ) const
+        {
+            const auto index = static_cast<int>( p_index );
+            const auto & bottomLeft = bottomLeftPositions[index / ( xCount * yCount )];
+            return Position2D( bottomLeft.x + static_cast<float>( index % xCount ) * xSpacing, bottomLeft.y + static_cast<float>( ( index / xCount ) % yCount ) * ySpacing );
+        }
+    };
+
+    ProjectionPixelsGrid() = default;
+    ProjectionPixelsGrid( const std::vector<Position2D> & p_bottomLeftPositions, const PixelSpacing & p_pixelSpacing, const Size2D & p_size )
+      : m_bottomLeftPositions( p_bottomLeftPositions )
+      , m_pixelSpacing( p_pixelSpacing )
+      , m_size( p_size )
+    {
+    }
+
+    int size() const { return this->GetNProjections() * this->GetProjectionPixelsNumber(); }
+    int GetNProjections() const { return static_cast<int>( m_bottomLeftPositions.size() ); }
+    int GetProjectionPixelsNumber() const { return m_size.x * m_size.y; }
+    AxisPositions GetXPositions( int p_projectionIndex ) const { return { m_bottomLeftPositions[p_projectionIndex].x, m_pixelSpacing.x, m_size.x }; }
+    AxisPositions GetYPositions( int p_projectionIndex ) const { return { m_bottomLeftPositions[p_projectionIndex].y, m_pixelSpacing.y, m_size.y }; }
+    IndexRange GetIndices() const { return { this->size() }; }
+
+    int GetIndex( int p_projectionIndex, const Pixel & p_pixel ) const { return ( p_projectionIndex * m_size.y + p_pixel.y ) * m_size.x + p_pixel.x; }
+    PixelOnProjection GetPixelOnProjection( int p_index ) const
+    {
+        return PixelOnProjection( p_index % m_size.x, ( p_index / m_size.x ) % m_size.y, p_index / this->GetProjectionPixelsNumber() );
+    }
+    Position2D GetPosition( int p_projectionIndex, const Pixel & p_pixel ) const
+    {
+        const auto & bottomLeft = m_bottomLeftPositions[p_projectionIndex];
+        return Position2D( bottomLeft.x + static_cast<float>( p_pixel.x ) * m_pixelSpacing.x, bottomLeft.y + static_cast<float>( p_pixel.y ) * m_pixelSpacing.y );
+    }
+
+    Positions GetPositions() const { return { m_bottomLeftPositions.data(), m_pixelSpacing.x, m_pixelSpacing.y, m_size.x, m_size.y }; }
+    Position2D operator[]( int p_index ) const { return this->GetPositions()( p_index ); }
+    IndexedIterator<Positions> begin() const { return { this->GetPositions(), 0 }; }
+    IndexedIterator<Positions> end() const { return { this->GetPositions(), this->size() }; }
+
+private:
+    std::vector<Position2D> m_bottomLeftPositions;
+    PixelSpacing m_pixelSpacing{ 0.F, 0.F };
+    Size2D m_size{ 0, 0 };
+};
@@ -0,0 +1,67 @@
+#include "modules/geometry/ProjectionPixelsGrid.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( ProjectionPixelsGridTest, PositionsMatchNestedLoops )
+{
+    const std::vector<Position2D> bottomLeftPositions = { Position2D( -12.F, 3.F ), Position2D( 0.5F, -7.25F ), Position2D( 40.F, 0.F ) };
+    const PixelSpacing pixelSpacing( 0.25F, 0.5F );
+    const Size2D size( 6, 4 );
+    const ProjectionPixelsGrid pixelsGrid( bottomLeftPositions, pixelSpacing, size );
+    ASSERT_EQ( pixelsGrid.size(), 3 * 6 * 4 );
+    ASSERT_EQ( pixelsGrid.GetNProjections(), 3 );
+
+    auto index{ 0 };
+    auto iterator = pixelsGrid.begin();
+    for( auto projectionIndex{ 0 }; projectionIndex < 3; projectionIndex++ )
+    {
+        const auto & bottomLeft = bottomLeftPositions[projectionIndex];
+        for( auto y{ 0 }; y < size.y; y++ )
+        {
+            for( auto x{ 0 }; x < size.x; x++ )
+            {
+                const Position2D expected( bottomLeft.x + x * pixelSpacing.x, bottomLeft.y + y * pixelSpacing.y );
+                EXPECT_EQ( pixelsGrid[index], expected );
+                EXPECT_EQ( *iterator, expected );
+                EXPECT_EQ( pixelsGrid.GetPosition( projectionIndex, Pixel( x, y ) ), expected );
+                EXPECT_EQ( pixelsGrid.GetIndex( projectionIndex, Pixel( x, y ) ), index );
+                EXPECT_EQ( pixelsGrid.GetPixelOnProjection( index ), PixelOnProjection( x, y, projectionIndex ) );
+                index++;
+                iterator++;
+            }
+        }
+    }
+    EXPECT_EQ( iterator, pixelsGrid.end() );
+    EXPECT_EQ( pixelsGrid.end() - pixelsGrid.begin(), pixelsGrid.size() );
+
+    const auto yPositions = pixelsGrid.GetYPositions( 1 );
+    EXPECT_EQ( std::vector<float>( yPositions.begin(), yPositions.end() ), std::vector<float>( { -7.25F, -6.75F, -6.25F, -5.75F } ) );
+}
+
+TEST( ProjectionPixelsGridTest, RangesWorkWithParallelAlgorithms )
+{
+    const std::vector<Position2D> bottomLeftPositions( 5, Position2D( 1.F, 2.F ) );
+    const ProjectionPixelsGrid pixelsGrid( bottomLeftPositions, PixelSpacing( 1.F, 1.F ), Size2D( 90, 70 ) );
+    const auto indices = pixelsGrid.GetIndices();
+    std::vector<float> sums( indices.size() );
+    std::for_each( std::execution::par_unseq, indices.begin(), indices.end(), [&]( int p_index ) {
+        const auto position = pixelsGrid[p_index];
+        sums[p_index] = position.x + position.y;
+    } );
+    std::vector<float> transformedSums( pixelsGrid.size() );
+    std::transform( std::execution::par, pixelsGrid.begin(), pixelsGrid.end(), transformedSums.begin(), []( const Position2D & p_position ) {
+        return p_position.x + p_position.y;
+    } );
+    EXPECT_EQ( sums, transformedSums );
+    const auto pixelOnProjection = pixelsGrid.GetPixelOnProjection( 23456 );
+    EXPECT_EQ( pixelOnProjection.projectionIndex, 23456 / ( 90 * 70 ) );
+    EXPECT_EQ( sums[23456], static_cast<float>( 1 + pixelOnProjection.pixel.x + 2 + pixelOnProjection.pixel.y ) );
+}
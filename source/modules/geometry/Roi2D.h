@@ -21,21 +21,6 @@ struct Roi2D
       , size( p_xSize, p_ySize )
     {}
 
-    Roi2D( const Roi2D & p_originalRoi2D )
-      : bottomLeftFront( p_originalRoi2D.bottomLeftFront )
-      , size( p_originalRoi2D.size )
-    {}
-
-    Roi2D & operator=( const Roi2D & p_originalRoi2D )
-    {
-        if( this != &p_originalRoi2D )
-        {
-            bottomLeftFront = p_originalRoi2D.bottomLeftFront;
-            size = p_originalRoi2D.size;
-        }
-        return *this;
-    }
-
     Pixel GetTopRightBack() const
     {
         return Pixel {bottomLeftFront.x + size.x,bottomLeftFront.y + size.y };
@@ -21,21 +21,6 @@ struct Roi3D
       , size( p_xSize, p_ySize, p_zSize )
     {}
 
-    Roi3D( const Roi3D & p_originalRoi3D )
-      : bottomLeftFront( p_originalRoi3D.bottomLeftFront )
-      , size( p_originalRoi3D.size )
-    {}
-
-    Roi3D & operator=( const Roi3D & p_originalRoi3D )
-    {
-        if( this != &p_originalRoi3D )
-        {
-            bottomLeftFront = p_originalRoi3D.bottomLeftFront;
-            size = p_originalRoi3D.size;
-        }
-        return *this;
-    }
-
     Voxel GetTopRightBack() const
     {
         return Voxel{bottomLeftFront.x + size.x,bottomLeftFront.y + size.y,bottomLeftFront.z + size.z};
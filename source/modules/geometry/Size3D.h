@@ -6,7 +6,6 @@ struct VoxelSpacing;
 struct WSize3D;
 struct Size3D : public Dim3<int>
 {  
-    Size3D(int p_x,int p_y,int p_z): Dim3<int>(p_x,p_y,p_z) {}
-    ~Size3D() override = default;
+    constexpr Size3D(int p_x,int p_y,int p_z): Dim3<int>(p_x,p_y,p_z) {}
     static Size3D FromVoxelSpacingAndSizeInWorld( const VoxelSpacing & p_voxelSpacing, const WSize3D & p_sizeInWorld, bool & p_allDimensionsValid );
 };
@@ -19,24 +19,13 @@ struct Sphere
       , radius( p_radius )
     {}
 
-    Sphere( Sphere const & p_originalSphere )
-      : center{ p_originalSphere.center }
-      , radius( p_originalSphere.radius )
-    {}
-
-    Sphere & operator=( const Sphere & p_originalSphere )
-    {
-        if( this != &p_originalSphere )
-        {
-            center = p_originalSphere.center;
-            radius = p_originalSphere.radius;
-        }
-        return *this;
-    }
-
     bool Contains( const Position3D & p_point ) const
     {
-        return ( center.DistanceL2To( p_point ) < radius );
+        // squared distances, as Cylinder: no square root
+        auto lagX = center.x - p_point.x;
+        auto lagY = center.y - p_point.y;
+        auto lagZ = center.z - p_point.z;
+        return ( lagX * lagX + lagY * lagY + lagZ * lagZ < radius * radius );
     }
 };
 
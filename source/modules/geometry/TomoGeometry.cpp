@@ -436,6 +436,18 @@ TomoGeometry::TomoGeometry( const std::string & p_xmlGeometryFilePath )
     m_isValid = true;
 }
 
+TomoGeometry::TomoGeometry( const TomoGeometry & p_tomoGeometry )
+  : m_filePath{ p_tomoGeometry.m_filePath }
+  , m_volume{ p_tomoGeometry.m_volume ? std::make_unique<TomoVolume>( *p_tomoGeometry.m_volume ) : nullptr }
+  , m_projections{ p_tomoGeometry.m_projections ? std::make_unique<TomoProjectionsSet>( *p_tomoGeometry.m_projections ) : nullptr }
+  , m_projectionsRois{ p_tomoGeometry.m_projectionsRois ? std::make_unique<TomoProjectionsSet>( *p_tomoGeometry.m_projectionsRois ) : nullptr }
+  , m_table{ p_tomoGeometry.m_table ? std::make_unique<TomoTable>( *p_tomoGeometry.m_table ) : nullptr }
+  , m_projectionROIsBLPixelPositionOnDetector{ p_tomoGeometry.m_projectionROIsBLPixelPositionOnDetector }
+  , m_fulcrum{ p_tomoGeometry.m_fulcrum }
+  , m_isValid{ p_tomoGeometry.m_isValid }
+{
+}
+
 // getters for volume
 Size3D TomoGeometry::volumeSize3D() const
 {
@@ -473,13 +485,9 @@ std::vector<float> TomoGeometry::volumeXs() const
 {
     return m_volume->GetXPositions();
 }
-std::vector<int> TomoGeometry::volumeVoxelsIndices() const
-{
-    return m_volume->GetVoxelsIndices();
-}
-std::vector<Position3D> TomoGeometry::volumeGridPositions() const
+VoxelGrid TomoGeometry::volumeVoxelGrid() const
 {
-    return m_volume->GetGridPositions();
+    return m_volume->GetVoxelGrid();
 }
 
 std::vector<float> TomoGeometry::sourcesYPositions() const
@@ -512,9 +520,9 @@ std::vector<Position2D> TomoGeometry::projectionsBottomLeftPositions() const
 {
     return m_projections->GetBottomLeftPositions();
 }
-std::vector<Position2D> TomoGeometry::projectionsPositions() const
+const ProjectionPixelsGrid & TomoGeometry::projectionsPixelsGrid() const
 {
-    return m_projections->GetProjectionPositions();
+    return m_projections->GetPixelsGrid();
 }
 Size2D TomoGeometry::projectionsSize() const
 {
@@ -537,11 +545,6 @@ PixelSpacing TomoGeometry::projectionsPixelSpacing() const
     return m_projections->GetPixelSpacing();
 }
 
-// mainly used for parallelization
-std::vector<int> TomoGeometry::projectionsPositionsIndices() const
-{
-    return m_projections->GetProjectionPixelsIndices();
-}
 // std::vector<PixelOnProjection> TomoGeometry::projectionIndiceAndPixels() const
 //{
 //     return m_projections->GetProjectionIndiceAndPixels();
@@ -555,9 +558,9 @@ std::vector<Position2D> TomoGeometry::projectionsRoisBottomLeftPositions() const
 {
     return m_projectionsRois->GetBottomLeftPositions();
 }
-std::vector<Position2D> TomoGeometry::projectionsRoisPositions() const
+const ProjectionPixelsGrid & TomoGeometry::projectionsRoisPixelsGrid() const
 {
-    return m_projectionsRois->GetProjectionPositions();
+    return m_projectionsRois->GetPixelsGrid();
 }
 Size2D TomoGeometry::projectionsRoisSize() const
 {
@@ -580,11 +583,6 @@ PixelSpacing TomoGeometry::projectionsRoisPixelSpacing() const
     return m_projectionsRois->GetPixelSpacing();
 }
 
-// mainly used for parallelization
-std::vector<int> TomoGeometry::projectionsRoisPositionsIndices() const
-{
-    return m_projectionsRois->GetProjectionPixelsIndices();
-}
 // std::vector<PixelOnProjection> TomoGeometry::projectionRoisIndiceAndPixels() const
 //{
 //     return m_projectionsRois->GetProjectionIndiceAndPixels();
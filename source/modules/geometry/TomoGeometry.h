@@ -5,11 +5,13 @@
 #include "modules/geometry/PixelSpacing.h"
 #include "modules/geometry/Position2D.h"
 #include "modules/geometry/Position3D.h"
+#include "modules/geometry/ProjectionPixelsGrid.h"
 #include "modules/geometry/Size2D.h"
 #include "modules/geometry/Size3D.h"
 #include "modules/geometry/TomoProjectionsSet.h"
 #include "modules/geometry/TomoTable.h"
 #include "modules/geometry/TomoVolume.h"
+#include "modules/geometry/VoxelGrid.h"
 #include "modules/geometry/VoxelSpacing.h"
 #include "modules/geometry/WSize2D.h"
 #include "modules/geometry/WSize3D.h"
@@ -22,7 +24,10 @@ class TomoGeometry
 {
 public:
     TomoGeometry( const std::string & p_xmlGeometryFilePath );
+    // deep copy, which can then be adapted (e.g. its volume grid) without changing the original
+    TomoGeometry( const TomoGeometry & p_tomoGeometry );
     ~TomoGeometry() = default;
+    TomoGeometry & operator=( const TomoGeometry & ) = delete;
 
     friend std::ostream & operator<<( std::ostream & p_outputStream, TomoGeometry const & p_data );
     bool IsValid() const { return m_isValid; }
@@ -41,28 +46,24 @@ public:
     // detectors geometric features
     int nbProjections() const;
     std::vector<Position2D> projectionsBottomLeftPositions() const;
-    std::vector<Position2D> projectionsPositions() const;
+    const ProjectionPixelsGrid & projectionsPixelsGrid() const;    // held by the geometry: its iterators stay valid with it
     Size2D projectionsSize() const;
     WSize2D projectionsWSize() const;
     std::vector<std::vector<float>> projectionsXPositions() const;
     std::vector<std::vector<float>> projectionsYPositions() const;
     PixelSpacing projectionsPixelSpacing() const;
 
-    // mainly used for parallelization
-    std::vector<int> projectionsPositionsIndices() const;
     // std::vector<PixelOnProjection> projectionIndiceAndPixels() const;
 
     int nbProjectionsRois() const;
     std::vector<Position2D> projectionsRoisBottomLeftPositions() const;
-    std::vector<Position2D> projectionsRoisPositions() const;
+    const ProjectionPixelsGrid & projectionsRoisPixelsGrid() const;    // held by the geometry: its iterators stay valid with it
     Size2D projectionsRoisSize() const;
     WSize2D projectionsRoisWSize() const;
     std::vector<std::vector<float>> projectionsRoisXPositions() const;
     std::vector<std::vector<float>> projectionsRoisYPositions() const;
     PixelSpacing projectionsRoisPixelSpacing() const;
 
-    // mainly used for parallelization
-    std::vector<int> projectionsRoisPositionsIndices() const;
     // std::vector<PixelOnProjection> projectionRoisIndiceAndPixels() const;
 
     // volume geometric features
@@ -75,14 +76,11 @@ public:
     std::vector<float> volumeZs() const;
     std::vector<float> volumeYs() const;
     std::vector<float> volumeXs() const;
-    std::vector<Position3D> volumeGridPositions() const;
+    VoxelGrid volumeVoxelGrid() const;
 
     WSize3D fulcrum() const { return m_fulcrum; }
     WSize3D rotationCenter() const { return m_fulcrum; }
 
-    // mainly used for parallelization
-    std::vector<int> volumeVoxelsIndices() const;
-
     TomoVolume * GetVolume() const { return m_volume.get(); }
     TomoProjectionsSet * GetProjections() const { return m_projections.get(); }
     TomoProjectionsSet * GetProjectionsRois() const { return m_projectionsRois.get(); }
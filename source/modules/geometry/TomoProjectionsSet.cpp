@@ -101,10 +101,8 @@ TomoProjectionsSet & TomoProjectionsSet::operator=( const TomoProjectionsSet & p
         m_size = p_originalTomoProjectionsSet.m_size;
         m_wSize = p_originalTomoProjectionsSet.m_wSize;
         m_pixelSpacing = p_originalTomoProjectionsSet.m_pixelSpacing;
-        m_xPositions = p_originalTomoProjectionsSet.m_xPositions;
-        m_yPositions = p_originalTomoProjectionsSet.m_yPositions;
-        m_projectionPositions = p_originalTomoProjectionsSet.m_projectionPositions;
-        m_projectionPixelsIndices = p_originalTomoProjectionsSet.m_projectionPixelsIndices;
+        m_pixelsGrid = p_originalTomoProjectionsSet.m_pixelsGrid;
+        m_nProjections = p_originalTomoProjectionsSet.m_nProjections;
     }
     return *this;
 }
@@ -127,19 +125,23 @@ PixelSpacing TomoProjectionsSet::GetPixelSpacing() const
 }
 std::vector<std::vector<float>> TomoProjectionsSet::GetXPositions() const
 {
-    return m_xPositions;
+    std::vector<std::vector<float>> xPositions;
+    for( auto projectionIndex{ 0 }; projectionIndex < m_nProjections; projectionIndex++ )
+    {
+        const auto projectionXPositions = m_pixelsGrid.GetXPositions( projectionIndex );
+        xPositions.emplace_back( projectionXPositions.begin(), projectionXPositions.end() );
+    }
+    return xPositions;
 }
 std::vector<std::vector<float>> TomoProjectionsSet::GetYPositions() const
 {
-    return m_yPositions;
-}
-std::vector<Position2D> TomoProjectionsSet::GetProjectionPositions() const
-{
-    return m_projectionPositions;
-}
-std::vector<int> TomoProjectionsSet::GetProjectionPixelsIndices() const
-{
-    return m_projectionPixelsIndices;
+    std::vector<std::vector<float>> yPositions;
+    for( auto projectionIndex{ 0 }; projectionIndex < m_nProjections; projectionIndex++ )
+    {
+        const auto projectionYPositions = m_pixelsGrid.GetYPositions( projectionIndex );
+        yPositions.emplace_back( projectionYPositions.begin(), projectionYPositions.end() );
+    }
+    return yPositions;
 }
 // std::vector<PixelOnProjection> TomoProjectionsSet::GetProjectionIndiceAndPixels() const
 //{
@@ -151,7 +153,7 @@ int TomoProjectionsSet::GetNProjections() const
 }
 Position2D TomoProjectionsSet::GetPosition( int p_projectionIndex, Pixel p_pixelPosition ) const
 {
-    return Position2D( m_xPositions[p_projectionIndex][p_pixelPosition.x], m_yPositions[p_projectionIndex][p_pixelPosition.y] );
+    return m_pixelsGrid.GetPosition( p_projectionIndex, p_pixelPosition );
 }
 Pixel TomoProjectionsSet::GetPixel( int p_projectionIndex, Position2D p_pixelPosition ) const
 {
@@ -171,45 +173,7 @@ bool TomoProjectionsSet::ContainsInside( const Position2D & p_point, int p_proje
 
 void TomoProjectionsSet::UpdatePositions()
 {
-    m_xPositions.clear();
-    m_xPositions.resize( m_nProjections );
-    m_yPositions.clear();
-    m_yPositions.resize( m_nProjections );
-    auto projectionPixelIndex{ 0 };
-    for( auto projectionIndex{ 0 }; projectionIndex < m_nProjections; projectionIndex++ )
-    {
-        m_xPositions[projectionIndex].clear();
-        m_xPositions[projectionIndex].resize( m_size.x );
-        m_xPositions[projectionIndex][0] = m_bottomLeftPositions[projectionIndex].x;
-        for( auto xIndex{ 1 }; xIndex < m_size.x; xIndex++ )
-        {
-            m_xPositions[projectionIndex][xIndex] = m_xPositions[projectionIndex][xIndex - 1] + m_pixelSpacing.x;
-        }
-        m_yPositions[projectionIndex].clear();
-        m_yPositions[projectionIndex].resize( m_size.y );
-        m_yPositions[projectionIndex][0] = m_bottomLeftPositions[projectionIndex].y;
-        for( auto yIndex{ 1 }; yIndex < m_size.y; yIndex++ )
-        {
-            m_yPositions[projectionIndex][yIndex] = m_yPositions[projectionIndex][yIndex - 1] + m_pixelSpacing.y;
-        }
-    }
-
-    m_projectionPositions.clear();
-    m_projectionPixelsIndices.clear();
-    // m_projectionIndiceAndPixels.clear();
-    for( auto projectionIndex{ 0 }; projectionIndex < m_nProjections; projectionIndex++ )
-    {
-        for( auto yIndex{ 0 }; yIndex < m_size.y; yIndex++ )
-        {
-            for( auto xIndex{ 0 }; xIndex < m_size.x; xIndex++ )
-            {
-                m_projectionPixelsIndices.push_back( projectionPixelIndex );
-                m_projectionPositions.push_back( Position2D( m_xPositions[projectionIndex][xIndex], m_yPositions[projectionIndex][yIndex] ) );
-                // m_projectionIndiceAndPixels.push_back( PixelOnProjection( Pixel( xIndex, yIndex ), projectionIndex ) );
-                projectionPixelIndex++;
-            }
-        }
-    }
+    m_pixelsGrid = ProjectionPixelsGrid( m_bottomLeftPositions, m_pixelSpacing, m_size );
 }
 
 void TomoProjectionsSet::RemoveProjection( std::vector<int> const & p_dataIndicesToRemove )
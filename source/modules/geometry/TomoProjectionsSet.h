@@ -4,6 +4,7 @@
 #include "modules/geometry/PixelOnProjection.h"
 #include "modules/geometry/PixelSpacing.h"
 #include "modules/geometry/Position2D.h"
+#include "modules/geometry/ProjectionPixelsGrid.h"
 #include "modules/geometry/Size2D.h"
 #include "modules/geometry/WSize2D.h"
 
@@ -35,8 +36,7 @@ public:
     PixelSpacing GetPixelSpacing() const;
     std::vector<std::vector<float>> GetXPositions() const;
     std::vector<std::vector<float>> GetYPositions() const;
-    std::vector<Position2D> GetProjectionPositions() const;
-    std::vector<int> GetProjectionPixelsIndices() const;
+    const ProjectionPixelsGrid & GetPixelsGrid() const { return m_pixelsGrid; }
     // std::vector<PixelOnProjection> GetProjectionIndiceAndPixels() const;
     int GetNProjections() const;
 
@@ -58,11 +58,8 @@ private:
     Size2D m_size{ 0, 0 };
     WSize2D m_wSize{ 0.F, 0.F };
     PixelSpacing m_pixelSpacing{ 0.F, 0.F };
-    std::vector<std::vector<float>> m_xPositions;
-    std::vector<std::vector<float>> m_yPositions;
-    std::vector<Position2D> m_projectionPositions;
+    ProjectionPixelsGrid m_pixelsGrid;
     // std::vector<PixelOnProjection> m_projectionIndiceAndPixels;
-    std::vector<int> m_projectionPixelsIndices;
     int m_nProjections;
 };
 
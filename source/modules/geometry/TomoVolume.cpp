@@ -110,11 +110,7 @@ TomoVolume & TomoVolume::operator=( const TomoVolume & p_originalTomoVolume )
         m_pave = p_originalTomoVolume.m_pave;
         m_size = p_originalTomoVolume.m_size;
         m_voxelSpacing = p_originalTomoVolume.m_voxelSpacing;
-        m_xPositions = p_originalTomoVolume.m_xPositions;
-        m_yPositions = p_originalTomoVolume.m_yPositions;
-        m_zPositions = p_originalTomoVolume.m_zPositions;
-        m_gridPositions = p_originalTomoVolume.m_gridPositions;
-        m_voxelsIndices = p_originalTomoVolume.m_voxelsIndices;
+        m_voxelGrid = p_originalTomoVolume.m_voxelGrid;
     }
     return *this;
 }
@@ -167,67 +163,26 @@ VoxelSpacing TomoVolume::GetVoxelSpacing() const
 }
 
 // for computation optimizations
-std::vector<float>  TomoVolume::GetXPositions() const
+std::vector<float> TomoVolume::GetXPositions() const
 {
-    return m_xPositions;
+    const auto & xPositions = m_voxelGrid.GetXPositions();
+    return std::vector<float>( xPositions.begin(), xPositions.end() );
 }
-std::vector<float>  TomoVolume::GetYPositions() const
+std::vector<float> TomoVolume::GetYPositions() const
 {
-    return m_yPositions;
+    const auto & yPositions = m_voxelGrid.GetYPositions();
+    return std::vector<float>( yPositions.begin(), yPositions.end() );
 }
 std::vector<float> TomoVolume::GetZPositions() const
 {
-    return m_zPositions;
-}
-
-std::vector<Position3D>  TomoVolume::GetGridPositions() const
-{
-    return m_gridPositions;
-}
-std::vector<int>  TomoVolume::GetVoxelsIndices() const
-{
-    return m_voxelsIndices;
+    const auto & zPositions = m_voxelGrid.GetZPositions();
+    return std::vector<float>( zPositions.begin(), zPositions.end() );
 }
 
 
 void TomoVolume::UpdatePositions()
 {
-    m_xPositions.clear();
-    m_xPositions.resize( m_size.x );
-    m_xPositions[0] = m_pave.bottomLeftFront.x;
-    for( auto i{ 1 }; i < m_size.x; i++ )
-    {
-        m_xPositions[i] = m_xPositions[i - 1] + m_voxelSpacing.x;
-    }
-    m_yPositions.clear();
-    m_yPositions.resize( m_size.y );
-    m_yPositions[0] = m_pave.bottomLeftFront.y;
-    for( auto i{ 1 }; i < m_size.y; i++ )
-    {
-        m_yPositions[i] = m_yPositions[i - 1] + m_voxelSpacing.y;
-    }
-    m_zPositions.clear();
-    m_zPositions.resize( m_size.z );
-    m_zPositions[0] = m_pave.bottomLeftFront.z;
-    for( auto i{ 1 }; i < m_size.z; i++ )
-    {
-        m_zPositions[i] = m_zPositions[i - 1] + m_voxelSpacing.z;
-    }
-    m_voxelsIndices.clear();
-    m_gridPositions.clear();
-    auto voxelIndex{ 0 };
-    for( auto zIndex{ 0 }; zIndex < m_size.z; zIndex++ )
-    {
-        for( auto yIndex{ 0 }; yIndex < m_size.y; yIndex++ )
-        {
-            for( auto xIndex{ 0 }; xIndex < m_size.x; xIndex++ )
-            {
-                m_voxelsIndices.push_back( voxelIndex );
-                m_gridPositions.push_back( Position3D( m_xPositions[xIndex], m_yPositions[yIndex], m_zPositions[zIndex] ) );
-                voxelIndex++;
-            }
-        }
-    }
+    m_voxelGrid = VoxelGrid( m_pave.bottomLeftFront, m_voxelSpacing, m_size );
 }
 
 void TomoVolume::UpdateWSize()
@@ -5,6 +5,7 @@
 #include "modules/geometry/Size3D.h"
 #include "modules/geometry/VoxelSpacing.h"
 #include "modules/geometry/Pave.h"
+#include "modules/geometry/VoxelGrid.h"
 
 #include <optional>
 #include <vector>
@@ -60,8 +61,8 @@ public:
     std::vector<float> GetYPositions() const;
     std::vector<float> GetZPositions() const;
 
-    std::vector<Position3D> GetGridPositions() const;
-    std::vector<int> GetVoxelsIndices() const;
+    // voxels positions and indices, computed on demand
+    VoxelGrid GetVoxelGrid() const { return m_voxelGrid; }
 
     Voxel FindVoxelContainingPosition( const Position3D & p_position ) const;
 
@@ -76,13 +77,7 @@ private:
     Size3D m_size{0,0,0};
     VoxelSpacing m_voxelSpacing{0.F,0.F,0.F};
 
-    // for computation optimizations
-    std::vector<float> m_xPositions; 
-    std::vector<float> m_yPositions;
-    std::vector<float> m_zPositions;
-
-    std::vector<Position3D> m_gridPositions;
-    std::vector<int> m_voxelsIndices;
+    VoxelGrid m_voxelGrid;
 };
 
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/geometry/Position3D.h"
+#include "modules/geometry/Size3D.h"
+#include "modules/geometry/Voxel.h"
+#include "modules/geometry/VoxelSpacing.h"
+
+// Regular sampling origin + index * spacing along one axis, computed on demand
+struct AxisPositions
+{
+    float origin{ 0.F };
+    float spacing{ 0.F };
+    int count{ 0 };
+
+    float operator()( std::ptrdiff_t p_index ) const { return origin + static_cast<float>( p_index ) * spacing; }
+    float operator[]( int p_index ) const { return ( *this )( p_index ); }
+    int size() const { return count; }
+    IndexedIterator<AxisPositions> begin() const { return { *this, 0 }; }
+    IndexedIterator<AxisPositions> end() const { return { *this, count }; }
+};
+
+// Positions of the voxels of a volume, computed from the voxel index instead of being stored: voxel ( x, y, z ), of
+// index ( z * size.y + y ) * size.x + x, is at bottomLeftFront + ( x, y, z ) * voxelSpacing.
+// A few floats whatever the volume size, cheap to copy
+class VoxelGrid
+{
+public:
+    VoxelGrid() = default;
+    VoxelGrid( const Position3D & p_bottomLeftFront, const VoxelSpacing & p_voxelSpacing, const Size3D & p_size )
+      : m_x{ p_bottomLeftFront.x, p_voxelSpacing.x, p_size.x }
+      , m_y{ p_bottomLeftFront.y, p_voxelSpacing.y, p_size.y }
+      , m_z{ p_bottomLeftFront.z, p_voxelSpacing.z, p_size.z }
+    {
+    }
+
+    int size() const { return m_x.count * m_y.count * m_z.count; }
+    const AxisPositions & GetXPositions() const { return m_x; }
+    const AxisPositions & GetYPositions() const { return m_y; }
+    const AxisPositions & GetZPositions() const { return m_z; }
+    IndexRange GetIndices() const { return { this->size() }; }
+
+    int GetIndex( int p_x, int p_y, int p_z ) const { return ( p_z * m_y.count + p_y ) * m_x.count + p_x; }
+    Voxel GetVoxel( int p_index ) const { return Voxel( p_index % m_x.count, ( p_index / m_x.count ) % m_y.count, p_index / ( m_x.count * m_y.count ) ); }
+    Position3D GetPosition( int p_x, int p_y, int p_z ) const { return Position3D( m_x[p_x], m_y[p_y], m_z[p_z] ); }
+
+    Position3D operator()( std::ptrdiff_t p_index ) const
+    {
+        const auto index = static_cast<int>( p_index );
+        return Position3D( m_x[index % m_x.count], m_y[( index / m_x.count ) % m_y.count], m_z[index / ( m_x.count * m_y.count )] );
+    }
+    Position3D operator[]( int p_index ) const { return ( *this )( p_index ); }
+    IndexedIterator<VoxelGrid> begin() const { return { *this, 0 }; }
+    IndexedIterator<VoxelGrid> end() const { return { *this, this->size() }; }
+
+private:
+    AxisPositions m_x;
+    AxisPositions m_y;
+    AxisPositions m_z;
+};
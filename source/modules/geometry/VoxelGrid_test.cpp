@@ -0,0 +1,65 @@
+#include "modules/geometry/VoxelGrid.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( VoxelGridTest, PositionsMatchNestedLoops )
+{
+    const Position3D bottomLeftFront( -10.F, 5.F, 2.5F );
+    const VoxelSpacing voxelSpacing( 0.5F, 0.25F, 2.F );
+    const Size3D size( 7, 5, 3 );
+    const VoxelGrid voxelGrid( bottomLeftFront, voxelSpacing, size );
+    ASSERT_EQ( voxelGrid.size(), 7 * 5 * 3 );
+
+    auto index{ 0 };
+    auto iterator = voxelGrid.begin();
+    for( auto z{ 0 }; z < size.z; z++ )
+    {
+        for( auto y{ 0 }; y < size.y; y++ )
+        {
+            for( auto x{ 0 }; x < size.x; x++ )
+            {
+                const Position3D expected( bottomLeftFront.x + x * voxelSpacing.x, bottomLeftFront.y + y * voxelSpacing.y, bottomLeftFront.z + z * voxelSpacing.z );
+                EXPECT_EQ( voxelGrid[index], expected );
+                EXPECT_EQ( *iterator, expected );
+                EXPECT_EQ( voxelGrid.GetPosition( x, y, z ), expected );
+                EXPECT_EQ( voxelGrid.GetIndex( x, y, z ), index );
+                EXPECT_EQ( voxelGrid.GetVoxel( index ), Voxel( x, y, z ) );
+                index++;
+                iterator++;
+            }
+        }
+    }
+    EXPECT_EQ( iterator, voxelGrid.end() );
+    EXPECT_EQ( voxelGrid.end() - voxelGrid.begin(), voxelGrid.size() );
+    EXPECT_EQ( voxelGrid.begin()[17], voxelGrid[17] );
+    EXPECT_EQ( *( voxelGrid.end() - 1 ), voxelGrid[voxelGrid.size() - 1] );
+
+    const auto zPositions = voxelGrid.GetZPositions();
+    EXPECT_EQ( std::vector<float>( zPositions.begin(), zPositions.end() ), std::vector<float>( { 2.5F, 4.5F, 6.5F } ) );
+}
+
+TEST( VoxelGridTest, RangesWorkWithParallelAlgorithms )
+{
+    const VoxelGrid voxelGrid( Position3D( 0.F, 0.F, 0.F ), VoxelSpacing( 1.F, 1.F, 1.F ), Size3D( 40, 30, 20 ) );
+    const auto indices = voxelGrid.GetIndices();
+    std::vector<float> sums( indices.size() );
+    std::for_each( std::execution::par_unseq, indices.begin(), indices.end(), [&]( int p_index ) {
+        const auto position = voxelGrid[p_index];
+        sums[p_index] = position.x + position.y + position.z;
+    } );
+    std::vector<float> transformedSums( voxelGrid.size() );
+    std::transform( std::execution::par, voxelGrid.begin(), voxelGrid.end(), transformedSums.begin(), []( const Position3D & p_position ) {
+        return p_position.x + p_position.y + p_position.z;
+    } );
+    EXPECT_EQ( sums, transformedSums );
+    const auto voxel = voxelGrid.GetVoxel( 12345 );
+    EXPECT_EQ( sums[12345], static_cast<float>( voxel.x + voxel.y + voxel.z ) );
+}
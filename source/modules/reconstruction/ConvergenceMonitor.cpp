@@ -0,0 +1,62 @@
+#include "modules/reconstruction/ConvergenceMonitor.h"
+
+#include <algorithm>
+
+ConvergenceMonitor::ConvergenceMonitor( const StoppingCriteria & p_criteria, double p_measuredNorm )
+  : m_criteria{ p_criteria }
+  , m_measuredNorm{ p_measuredNorm }
+  , m_start{ std::chrono::steady_clock::now() }
+{
+}
+
+bool ConvergenceMonitor::Update( int p_iteration, double p_residualNorm, double p_relativeVolumeChange )
+{
+    IterationMetrics metrics;
+    metrics.iteration = p_iteration;
+    metrics.residualNorm = p_residualNorm;
+    metrics.relativeResidualNorm = m_measuredNorm > 0. ? p_residualNorm / m_measuredNorm : 0.;
+    metrics.relativeVolumeChange = p_relativeVolumeChange;
+    metrics.elapsedSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - m_start ).count();
+
+    if( !m_history.empty() )
+    {
+        const auto previousResidualNorm = m_history.back().residualNorm;
+        const auto relativeDecrease = previousResidualNorm > 0. ? ( previousResidualNorm - p_residualNorm ) / previousResidualNorm : 0.;
+        m_stagnationCount = relativeDecrease < m_criteria.stagnationThreshold ? m_stagnationCount + 1 : 0;
+    }
+    m_history.push_back( metrics );
+    if( m_criteria.metricsCallback )
+    {
+        m_criteria.metricsCallback( metrics );
+    }
+
+    if( m_criteria.relativeTolerance > 0. && metrics.relativeResidualNorm <= m_criteria.relativeTolerance )
+    {
+        m_stoppingReason = StoppingReason::Tolerance;
+    }
+    else if( m_criteria.stagnationThreshold > 0. && m_stagnationCount >= std::max( 1, m_criteria.stagnationIterations ) )
+    {
+        m_stoppingReason = StoppingReason::Stagnation;
+    }
+    else if( m_criteria.timeBudgetSeconds > 0. && metrics.elapsedSeconds >= m_criteria.timeBudgetSeconds )
+    {
+        m_stoppingReason = StoppingReason::TimeBudget;
+    }
+    return m_stoppingReason != StoppingReason::IterationNumber;
+}
+
+const char * ToString( StoppingReason p_stoppingReason )
+{
+    switch( p_stoppingReason )
+    {
+        case StoppingReason::IterationNumber:
+            return "iteration number reached";
+        case StoppingReason::Tolerance:
+            return "tolerance reached";
+        case StoppingReason::Stagnation:
+            return "residual stagnation";
+        case StoppingReason::TimeBudget:
+            return "time budget exceeded";
+    }
+    return "unknown";
+}
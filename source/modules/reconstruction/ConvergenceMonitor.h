@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+// Metrics of one iteration of an iterative reconstruction
+struct IterationMetrics
+{
+    int iteration{ 0 };
+    double residualNorm{ 0. };            // || b - A x ||, x being the volume at the start of the iteration
+    double relativeResidualNorm{ 0. };    // divided by || b ||
+    double relativeVolumeChange{ 0. };    // || x_new - x || / || x_new ||, 0 if not monitored
+    double elapsedSeconds{ 0. };          // since the start of the iterations
+};
+
+// Early stopping of the iterations, each criterion being disabled by a 0 value. The iteration number given to the
+// reconstructor stays the maximum
+struct StoppingCriteria
+{
+    double relativeTolerance{ 0. };       // stop when relativeResidualNorm <= relativeTolerance
+    double stagnationThreshold{ 0. };     // stop when the residual relative decrease stays below it for stagnationIterations
+    int stagnationIterations{ 3 };
+    double timeBudgetSeconds{ 0. };       // stop when the elapsed time exceeds it
+    bool monitorVolumeChange{ false };    // compute relativeVolumeChange (one more accumulation in the update pass)
+    std::function<void( const IterationMetrics & )> metricsCallback;    // called at every iteration
+};
+
+enum class StoppingReason
+{
+    IterationNumber = 0,
+    Tolerance,
+    Stagnation,
+    TimeBudget
+};
+
+// Applies the stopping criteria to the norms computed by a reconstructor in its iteration passes, and keeps the history
+class ConvergenceMonitor
+{
+public:
+    ConvergenceMonitor( const StoppingCriteria & p_criteria, double p_measuredNorm );
+    ~ConvergenceMonitor() = default;
+
+    // record the metrics of p_iteration, call the callback, return true if the iterations must stop
+    bool Update( int p_iteration, double p_residualNorm, double p_relativeVolumeChange );
+
+    StoppingReason GetStoppingReason() const { return m_stoppingReason; }
+    const std::vector<IterationMetrics> & GetHistory() const { return m_history; }
+    bool IsVolumeChangeMonitored() const { return m_criteria.monitorVolumeChange; }
+
+private:
+    StoppingCriteria m_criteria;
+    double m_measuredNorm;
+    std::chrono::steady_clock::time_point m_start;
+    int m_stagnationCount{ 0 };
+    StoppingReason m_stoppingReason{ StoppingReason::IterationNumber };
+    std::vector<IterationMetrics> m_history;
+};
+
+// name of a stopping reason, for the logs
+const char * ToString( StoppingReason p_stoppingReason );
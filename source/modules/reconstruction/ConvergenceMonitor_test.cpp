@@ -0,0 +1,51 @@
+#include "modules/reconstruction/ConvergenceMonitor.h"
+#include "test_utils/TestInitializer.h"
+
+#include <chrono>
+#include <thread>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( ConvergenceMonitorTest, ConvergenceMonitorAppliesStoppingCriteria )
+{
+    // no criterion: only the iteration number stops, every iteration is reported
+    auto nbCallbacks{ 0 };
+    StoppingCriteria criteria;
+    criteria.metricsCallback = [&nbCallbacks]( const IterationMetrics & ) { nbCallbacks++; };
+    ConvergenceMonitor monitor( criteria, 10. );
+    for( auto iteration{ 0 }; iteration < 5; iteration++ )
+    {
+        EXPECT_FALSE( monitor.Update( iteration, 1., 0. ) );
+    }
+    EXPECT_EQ( nbCallbacks, 5 );
+    EXPECT_EQ( monitor.GetStoppingReason(), StoppingReason::IterationNumber );
+    EXPECT_DOUBLE_EQ( monitor.GetHistory().back().relativeResidualNorm, 0.1 );
+
+    StoppingCriteria toleranceCriteria;
+    toleranceCriteria.relativeTolerance = 0.05;
+    ConvergenceMonitor toleranceMonitor( toleranceCriteria, 10. );
+    EXPECT_FALSE( toleranceMonitor.Update( 0, 1., 0. ) );
+    EXPECT_TRUE( toleranceMonitor.Update( 1, 0.4, 0. ) );
+    EXPECT_EQ( toleranceMonitor.GetStoppingReason(), StoppingReason::Tolerance );
+
+    // decreases of 50 %, then of 1 % twice
+    StoppingCriteria stagnationCriteria;
+    stagnationCriteria.stagnationThreshold = 0.02;
+    stagnationCriteria.stagnationIterations = 2;
+    ConvergenceMonitor stagnationMonitor( stagnationCriteria, 10. );
+    EXPECT_FALSE( stagnationMonitor.Update( 0, 4., 0. ) );
+    EXPECT_FALSE( stagnationMonitor.Update( 1, 2., 0. ) );
+    EXPECT_FALSE( stagnationMonitor.Update( 2, 1.98, 0. ) );
+    EXPECT_TRUE( stagnationMonitor.Update( 3, 1.96, 0. ) );
+    EXPECT_EQ( stagnationMonitor.GetStoppingReason(), StoppingReason::Stagnation );
+
+    StoppingCriteria timeCriteria;
+    timeCriteria.timeBudgetSeconds = 1e-9;
+    ConvergenceMonitor timeMonitor( timeCriteria, 10. );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    EXPECT_TRUE( timeMonitor.Update( 0, 1., 0. ) );
+    EXPECT_EQ( timeMonitor.GetStoppingReason(), StoppingReason::TimeBudget );
+}
@@ -0,0 +1,394 @@
+#include "modules/reconstruction/ElementWise.h"
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+#include "modules/reconstruction/SimdTargets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace    // anonymous namespace
+{
+using namespace elementwise;
+
+constexpr size_t chunkSize = 65536;
+
+bool UseAvx2()
+{
+    static const auto useAvx2 = cpuprojector::DetectSimdLevel() >= cpuprojector::SimdLevel::Avx2;
+    return useAvx2;
+}
+
+// number of chunks of [0, p_size[
+int NbChunks( size_t p_size )
+{
+    return static_cast<int>( ( p_size + chunkSize - 1 ) / chunkSize );
+}
+
+// p_chunkFunction( begin, size ) on the chunks of [0, p_size[, in parallel
+template <typename ChunkFunction>
+void ForEachChunk( size_t p_size, ChunkFunction p_chunkFunction )
+{
+    const auto chunks = IndexRange{ NbChunks( p_size ) };
+    std::for_each( std::execution::par, chunks.begin(), chunks.end(), [&]( int p_chunk ) {
+        const auto begin = static_cast<size_t>( p_chunk ) * chunkSize;
+        p_chunkFunction( begin, std::min( p_size, begin + chunkSize ) - begin );
+    } );
+}
+
+// sum of p_chunkFunction( begin, size ) over the chunks of [0, p_size[, computed in parallel and added in chunk order
+template <typename Sum, typename ChunkFunction>
+Sum ChunkedSum( size_t p_size, ChunkFunction p_chunkFunction )
+{
+    const auto chunks = IndexRange{ NbChunks( p_size ) };
+    // a local buffer, not a thread_local one: the caller may itself be a task of an outer parallel loop, and its thread
+    // runs other tasks of that loop, calling this function again, while it waits for the loop below
+    std::vector<Sum> chunksSums( chunks.size() );
+    std::for_each( std::execution::par, chunks.begin(), chunks.end(), [&]( int p_chunk ) {
+        const auto begin = static_cast<size_t>( p_chunk ) * chunkSize;
+        chunksSums[p_chunk] = p_chunkFunction( begin, std::min( p_size, begin + chunkSize ) - begin );
+    } );
+    return std::accumulate( chunksSums.cbegin(), chunksSums.cend(), Sum{}, []( const Sum & p_sum, const Sum & p_chunkSum ) {
+        if constexpr( std::is_same_v<Sum, UpdateNorms> )
+        {
+            return UpdateNorms{ p_sum.squaredChangeNorm + p_chunkSum.squaredChangeNorm, p_sum.squaredNorm + p_chunkSum.squaredNorm };
+        }
+        else
+        {
+            return p_sum + p_chunkSum;
+        }
+    } );
+}
+
+// scalar chunks, also used for the tails of the AVX2 ones
+
+double SquaredNormChunk( const float * p_x, size_t p_size )
+{
+    auto sum{ 0. };
+    for( size_t index{ 0 }; index < p_size; index++ )
+    {
+        sum += static_cast<double>( p_x[index] ) * p_x[index];
+    }
+    return sum;
+}
+
+double ResidualChunk( const float * p_measured, const float * p_weights, float p_relaxation, float * p_current, size_t p_size )
+{
+    auto sum{ 0. };
+    for( size_t index{ 0 }; index < p_size; index++ )
+    {
+        const auto difference = p_measured[index] - p_current[index];
+        sum += static_cast<double>( difference ) * difference;
+        p_current[index] = p_relaxation * ( p_weights != nullptr ? p_weights[index] : 1.F ) * difference;
+    }
+    return sum;
+}
+
+double RatioChunk( const float * p_measured, float p_relaxation, float p_epsilon, float * p_current, size_t p_size )
+{
+    auto sum{ 0. };
+    for( size_t index{ 0 }; index < p_size; index++ )
+    {
+        const auto difference = p_measured[index] - p_current[index];
+        sum += static_cast<double>( difference ) * difference;
+        p_current[index] = std::fabs( p_current[index] ) > p_epsilon ? p_relaxation * p_measured[index] / p_current[index] : 0.F;
+    }
+    return sum;
+}
+
+UpdateNorms AxpyChunk( float p_a, const float * p_x, const float * p_weights, float * p_y, size_t p_size, bool p_computeNorms )
+{
+    UpdateNorms norms;
+    for( size_t index{ 0 }; index < p_size; index++ )
+    {
+        const auto change = p_a * ( p_weights != nullptr ? p_weights[index] : 1.F ) * p_x[index];
+        p_y[index] += change;
+        if( p_computeNorms )
+        {
+            norms.squaredChangeNorm += static_cast<double>( change ) * change;
+            norms.squaredNorm += static_cast<double>( p_y[index] ) * p_y[index];
+        }
+    }
+    return norms;
+}
+
+UpdateNorms MultiplyChunk( const float * p_x, const float * p_weights, float p_exponent, float * p_y, size_t p_size, bool p_computeNorms )
+{
+    UpdateNorms norms;
+    for( size_t index{ 0 }; index < p_size; index++ )
+    {
+        const auto weight = p_weights != nullptr ? p_weights[index] : 1.F;
+        if( weight != 0.F )
+        {
+            const auto factor = p_exponent == 1.F ? weight * p_x[index] : std::pow( weight * p_x[index], p_exponent );
+            const auto newValue = p_y[index] * factor;
+            if( p_computeNorms )
+            {
+                norms.squaredChangeNorm += static_cast<double>( newValue - p_y[index] ) * ( newValue - p_y[index] );
+            }
+            p_y[index] = newValue;
+        }
+        if( p_computeNorms )
+        {
+            norms.squaredNorm += static_cast<double>( p_y[index] ) * p_y[index];
+        }
+    }
+    return norms;
+}
+
+double XpbyChunk( const float * p_x, float p_b, float * p_y, size_t p_size )
+{
+    auto sum{ 0. };
+    for( size_t index{ 0 }; index < p_size; index++ )
+    {
+        p_y[index] = p_x[index] + p_b * p_y[index];
+        sum += static_cast<double>( p_y[index] ) * p_y[index];
+    }
+    return sum;
+}
+
+#ifdef TOMO_WITH_X86_SIMD
+// p_sum + p_value^2, the 8 floats being widened to double
+TOMO_TARGET_AVX2 inline __m256d AddSquares( __m256 p_value, __m256d p_sum )
+{
+    const auto low = _mm256_cvtps_pd( _mm256_castps256_ps128( p_value ) );
+    const auto high = _mm256_cvtps_pd( _mm256_extractf128_ps( p_value, 1 ) );
+    return _mm256_fmadd_pd( high, high, _mm256_fmadd_pd( low, low, p_sum ) );
+}
+
+TOMO_TARGET_AVX2 inline double HorizontalSum( __m256d p_sum )
+{
+    const auto pairs = _mm_add_pd( _mm256_castpd256_pd128( p_sum ), _mm256_extractf128_pd( p_sum, 1 ) );
+    return _mm_cvtsd_f64( _mm_add_sd( pairs, _mm_unpackhi_pd( pairs, pairs ) ) );
+}
+
+TOMO_TARGET_AVX2 double SquaredNormChunkAvx2( const float * p_x, size_t p_size )
+{
+    auto sum = _mm256_setzero_pd();
+    size_t index{ 0 };
+    for( ; index + 8 <= p_size; index += 8 )
+    {
+        sum = AddSquares( _mm256_loadu_ps( p_x + index ), sum );
+    }
+    return HorizontalSum( sum ) + SquaredNormChunk( p_x + index, p_size - index );
+}
+
+TOMO_TARGET_AVX2 double ResidualChunkAvx2( const float * p_measured, const float * p_weights, float p_relaxation, float * p_current, size_t p_size )
+{
+    const auto relaxation = _mm256_set1_ps( p_relaxation );
+    auto sum = _mm256_setzero_pd();
+    size_t index{ 0 };
+    for( ; index + 8 <= p_size; index += 8 )
+    {
+        const auto difference = _mm256_sub_ps( _mm256_loadu_ps( p_measured + index ), _mm256_loadu_ps( p_current + index ) );
+        sum = AddSquares( difference, sum );
+        const auto factor = p_weights != nullptr ? _mm256_mul_ps( relaxation, _mm256_loadu_ps( p_weights + index ) ) : relaxation;
+        _mm256_storeu_ps( p_current + index, _mm256_mul_ps( factor, difference ) );
+    }
+    const auto tailWeights = p_weights != nullptr ? p_weights + index : nullptr;
+    return HorizontalSum( sum ) + ResidualChunk( p_measured + index, tailWeights, p_relaxation, p_current + index, p_size - index );
+}
+
+TOMO_TARGET_AVX2 double RatioChunkAvx2( const float * p_measured, float p_relaxation, float p_epsilon, float * p_current, size_t p_size )
+{
+    const auto relaxation = _mm256_set1_ps( p_relaxation );
+    const auto epsilon = _mm256_set1_ps( p_epsilon );
+    const auto absoluteMask = _mm256_castsi256_ps( _mm256_set1_epi32( 0x7FFFFFFF ) );
+    auto sum = _mm256_setzero_pd();
+    size_t index{ 0 };
+    for( ; index + 8 <= p_size; index += 8 )
+    {
+        const auto measured = _mm256_loadu_ps( p_measured + index );
+        const auto current = _mm256_loadu_ps( p_current + index );
+        sum = AddSquares( _mm256_sub_ps( measured, current ), sum );
+        // the lanes below epsilon (possibly inf or NaN after the division) are zeroed by the mask
+        const auto isValid = _mm256_cmp_ps( _mm256_and_ps( current, absoluteMask ), epsilon, _CMP_GT_OQ );
+        _mm256_storeu_ps( p_current + index, _mm256_and_ps( isValid, _mm256_div_ps( _mm256_mul_ps( relaxation, measured ), current ) ) );
+    }
+    return HorizontalSum( sum ) + RatioChunk( p_measured + index, p_relaxation, p_epsilon, p_current + index, p_size - index );
+}
+
+TOMO_TARGET_AVX2 UpdateNorms AxpyChunkAvx2( float p_a, const float * p_x, const float * p_weights, float * p_y, size_t p_size, bool p_computeNorms )
+{
+    const auto a = _mm256_set1_ps( p_a );
+    auto changeSum = _mm256_setzero_pd();
+    auto sum = _mm256_setzero_pd();
+    size_t index{ 0 };
+    for( ; index + 8 <= p_size; index += 8 )
+    {
+        const auto factor = p_weights != nullptr ? _mm256_mul_ps( a, _mm256_loadu_ps( p_weights + index ) ) : a;
+        const auto change = _mm256_mul_ps( factor, _mm256_loadu_ps( p_x + index ) );
+        const auto newValue = _mm256_add_ps( _mm256_loadu_ps( p_y + index ), change );
+        _mm256_storeu_ps( p_y + index, newValue );
+        if( p_computeNorms )
+        {
+            changeSum = AddSquares( change, changeSum );
+            sum = AddSquares( newValue, sum );
+        }
+    }
+    const auto tailWeights = p_weights != nullptr ? p_weights + index : nullptr;
+    const auto tail = AxpyChunk( p_a, p_x + index, tailWeights, p_y + index, p_size - index, p_computeNorms );
+    return { HorizontalSum( changeSum ) + tail.squaredChangeNorm, HorizontalSum( sum ) + tail.squaredNorm };
+}
+
+// exponent 1 only: the accelerated EM updates use the scalar chunks (no vector pow)
+TOMO_TARGET_AVX2 UpdateNorms MultiplyChunkAvx2( const float * p_x, const float * p_weights, float * p_y, size_t p_size, bool p_computeNorms )
+{
+    const auto zero = _mm256_setzero_ps();
+    const auto one = _mm256_set1_ps( 1.F );
+    auto changeSum = _mm256_setzero_pd();
+    auto sum = _mm256_setzero_pd();
+    size_t index{ 0 };
+    for( ; index + 8 <= p_size; index += 8 )
+    {
+        const auto value = _mm256_loadu_ps( p_y + index );
+        auto factor = _mm256_loadu_ps( p_x + index );
+        if( p_weights != nullptr )
+        {
+            // null weights: factor 1
+            const auto weights = _mm256_loadu_ps( p_weights + index );
+            factor = _mm256_blendv_ps( _mm256_mul_ps( weights, factor ), one, _mm256_cmp_ps( weights, zero, _CMP_EQ_OQ ) );
+        }
+        const auto newValue = _mm256_mul_ps( value, factor );
+        _mm256_storeu_ps( p_y + index, newValue );
+        if( p_computeNorms )
+        {
+            changeSum = AddSquares( _mm256_sub_ps( newValue, value ), changeSum );
+            sum = AddSquares( newValue, sum );
+        }
+    }
+    const auto tailWeights = p_weights != nullptr ? p_weights + index : nullptr;
+    const auto tail = MultiplyChunk( p_x + index, tailWeights, 1.F, p_y + index, p_size - index, p_computeNorms );
+    return { HorizontalSum( changeSum ) + tail.squaredChangeNorm, HorizontalSum( sum ) + tail.squaredNorm };
+}
+
+TOMO_TARGET_AVX2 double XpbyChunkAvx2( const float * p_x, float p_b, float * p_y, size_t p_size )
+{
+    const auto b = _mm256_set1_ps( p_b );
+    auto sum = _mm256_setzero_pd();
+    size_t index{ 0 };
+    for( ; index + 8 <= p_size; index += 8 )
+    {
+        const auto newValue = _mm256_fmadd_ps( b, _mm256_loadu_ps( p_y + index ), _mm256_loadu_ps( p_x + index ) );
+        _mm256_storeu_ps( p_y + index, newValue );
+        sum = AddSquares( newValue, sum );
+    }
+    return HorizontalSum( sum ) + XpbyChunk( p_x + index, p_b, p_y + index, p_size - index );
+}
+#endif
+}    // end of anonymous namespace
+
+namespace elementwise
+{
+double SquaredNorm( const float * p_x, size_t p_size )
+{
+    return ChunkedSum<double>( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+#ifdef TOMO_WITH_X86_SIMD
+        if( UseAvx2() )
+        {
+            return SquaredNormChunkAvx2( p_x + p_begin, p_chunkSize );
+        }
+#endif
+        return SquaredNormChunk( p_x + p_begin, p_chunkSize );
+    } );
+}
+
+double Residual( const float * p_measured, const float * p_weights, float p_relaxation, float * p_current, size_t p_size )
+{
+    return ChunkedSum<double>( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+        const auto weights = p_weights != nullptr ? p_weights + p_begin : nullptr;
+#ifdef TOMO_WITH_X86_SIMD
+        if( UseAvx2() )
+        {
+            return ResidualChunkAvx2( p_measured + p_begin, weights, p_relaxation, p_current + p_begin, p_chunkSize );
+        }
+#endif
+        return ResidualChunk( p_measured + p_begin, weights, p_relaxation, p_current + p_begin, p_chunkSize );
+    } );
+}
+
+double Ratio( const float * p_measured, float p_relaxation, float p_epsilon, float * p_current, size_t p_size )
+{
+    return ChunkedSum<double>( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+#ifdef TOMO_WITH_X86_SIMD
+        if( UseAvx2() )
+        {
+            return RatioChunkAvx2( p_measured + p_begin, p_relaxation, p_epsilon, p_current + p_begin, p_chunkSize );
+        }
+#endif
+        return RatioChunk( p_measured + p_begin, p_relaxation, p_epsilon, p_current + p_begin, p_chunkSize );
+    } );
+}
+
+UpdateNorms Axpy( float p_a, const float * p_x, const float * p_weights, float * p_y, size_t p_size, bool p_computeNorms )
+{
+    return ChunkedSum<UpdateNorms>( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+        const auto weights = p_weights != nullptr ? p_weights + p_begin : nullptr;
+#ifdef TOMO_WITH_X86_SIMD
+        if( UseAvx2() )
+        {
+            return AxpyChunkAvx2( p_a, p_x + p_begin, weights, p_y + p_begin, p_chunkSize, p_computeNorms );
+        }
+#endif
+        return AxpyChunk( p_a, p_x + p_begin, weights, p_y + p_begin, p_chunkSize, p_computeNorms );
+    } );
+}
+
+UpdateNorms Multiply( const float * p_x, const float * p_weights, float p_exponent, float * p_y, size_t p_size, bool p_computeNorms )
+{
+    return ChunkedSum<UpdateNorms>( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+        const auto weights = p_weights != nullptr ? p_weights + p_begin : nullptr;
+#ifdef TOMO_WITH_X86_SIMD
+        if( UseAvx2() && p_exponent == 1.F )
+        {
+            return MultiplyChunkAvx2( p_x + p_begin, weights, p_y + p_begin, p_chunkSize, p_computeNorms );
+        }
+#endif
+        return MultiplyChunk( p_x + p_begin, weights, p_exponent, p_y + p_begin, p_chunkSize, p_computeNorms );
+    } );
+}
+
+double Xpby( const float * p_x, float p_b, float * p_y, size_t p_size )
+{
+    return ChunkedSum<double>( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+#ifdef TOMO_WITH_X86_SIMD
+        if( UseAvx2() )
+        {
+            return XpbyChunkAvx2( p_x + p_begin, p_b, p_y + p_begin, p_chunkSize );
+        }
+#endif
+        return XpbyChunk( p_x + p_begin, p_b, p_y + p_begin, p_chunkSize );
+    } );
+}
+
+// no reduction: the loops below are vectorized by the compiler
+
+void AxpyThenXpby( float p_a, const float * p_z, float p_b, float * p_x, float * p_y, size_t p_size )
+{
+    ForEachChunk( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+        for( auto index = p_begin; index < p_begin + p_chunkSize; index++ )
+        {
+            p_y[index] += p_a * p_x[index];
+            p_x[index] = p_z[index] + p_b * p_x[index];
+        }
+    } );
+}
+
+void Scale( float p_a, float * p_x, size_t p_size )
+{
+    ForEachChunk( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+        std::transform( p_x + p_begin, p_x + p_begin + p_chunkSize, p_x + p_begin, [p_a]( float p_value ) { return p_a * p_value; } );
+    } );
+}
+
+void ClampToNonNegative( float * p_x, size_t p_size )
+{
+    ForEachChunk( p_size, [&]( size_t p_begin, size_t p_chunkSize ) {
+        std::transform( p_x + p_begin, p_x + p_begin + p_chunkSize, p_x + p_begin, []( float p_value ) { return std::max( p_value, 0.F ); } );
+    } );
+}
+}    // namespace elementwise
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+// Fused element-wise passes of the iterative reconstructors, on buffers of p_size floats.
+// The buffers are processed by chunks in parallel, with AVX2 chunks when available. The norms are accumulated in double
+// per chunk, then added in the chunk order: the results do not depend on the scheduling.
+// Optional weights (nullptr: all 1) are the ray or voxel normalizations of the SART and EM algorithms
+namespace elementwise
+{
+// squared norms of an update y_new = f( y ), when requested
+struct UpdateNorms
+{
+    double squaredChangeNorm{ 0. };    // || y_new - y ||^2
+    double squaredNorm{ 0. };          // || y_new ||^2
+};
+
+double SquaredNorm( const float * p_x, size_t p_size );
+
+// y = relaxation w ( b - y ), return || b - y ||^2 (y being the current projections)
+double Residual( const float * p_measured, const float * p_weights, float p_relaxation, float * p_current, size_t p_size );
+
+// y = relaxation b / y where | y | > epsilon, 0 elsewhere, return || b - y ||^2
+double Ratio( const float * p_measured, float p_relaxation, float p_epsilon, float * p_current, size_t p_size );
+
+// y += a w x
+UpdateNorms Axpy( float p_a, const float * p_x, const float * p_weights, float * p_y, size_t p_size, bool p_computeNorms );
+
+// y *= ( w x )^exponent, the elements of null weight being left unchanged
+UpdateNorms Multiply( const float * p_x, const float * p_weights, float p_exponent, float * p_y, size_t p_size, bool p_computeNorms );
+
+// y = x + b y, return || y ||^2
+double Xpby( const float * p_x, float p_b, float * p_y, size_t p_size );
+
+// y += a x and x = z + b x, in one pass (update of a solution y along a search direction x, then of the direction)
+void AxpyThenXpby( float p_a, const float * p_z, float p_b, float * p_x, float * p_y, size_t p_size );
+
+void Scale( float p_a, float * p_x, size_t p_size );
+
+void ClampToNonNegative( float * p_x, size_t p_size );
+}    // namespace elementwise
@@ -0,0 +1,112 @@
+#include "modules/reconstruction/ElementWise.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( ElementWiseTest, ElementWiseKernelsMatchScalarLoops )
+{
+    // several chunks and a tail shorter than a vector
+    const auto size = 3 * 65536 + 13;
+    const auto measured = RandomBuffer( size, 40U );
+    auto current = RandomBuffer( size, 41U );
+    auto weights = RandomBuffer( size, 42U );
+    for( auto index{ 0 }; index < size; index += 97 )
+    {
+        current[index] = 0.F;
+        weights[index] = 0.F;
+    }
+    const auto expectNear = []( double p_value, double p_reference ) { EXPECT_NEAR( p_value, p_reference, 1e-9 * p_reference + 1e-12 ); };
+
+    auto squaredNorm{ 0. };
+    auto squaredResidualNorm{ 0. };
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        squaredNorm += static_cast<double>( measured[index] ) * measured[index];
+        squaredResidualNorm += static_cast<double>( measured[index] - current[index] ) * ( measured[index] - current[index] );
+    }
+    expectNear( elementwise::SquaredNorm( measured.data(), size ), squaredNorm );
+
+    // y = relaxation w ( b - y )
+    auto residual = current;
+    expectNear( elementwise::Residual( measured.data(), weights.data(), 0.5F, residual.data(), size ), squaredResidualNorm );
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        EXPECT_FLOAT_EQ( residual[index], 0.5F * weights[index] * ( measured[index] - current[index] ) );
+    }
+
+    // y = relaxation b / y, null projections giving null ratios
+    auto ratio = current;
+    expectNear( elementwise::Ratio( measured.data(), 0.5F, 0.F, ratio.data(), size ), squaredResidualNorm );
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        EXPECT_FLOAT_EQ( ratio[index], current[index] != 0.F ? 0.5F * measured[index] / current[index] : 0.F );
+    }
+
+    // y += a w x
+    auto axpy = current;
+    const auto axpyNorms = elementwise::Axpy( -2.F, measured.data(), weights.data(), axpy.data(), size, true );
+    auto squaredChangeNorm{ 0. };
+    auto squaredUpdateNorm{ 0. };
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        const auto change = -2.F * weights[index] * measured[index];
+        EXPECT_FLOAT_EQ( axpy[index], current[index] + change );
+        squaredChangeNorm += static_cast<double>( change ) * change;
+        squaredUpdateNorm += static_cast<double>( axpy[index] ) * axpy[index];
+    }
+    expectNear( axpyNorms.squaredChangeNorm, squaredChangeNorm );
+    expectNear( axpyNorms.squaredNorm, squaredUpdateNorm );
+
+    // y *= ( w x )^h, null weights leaving y unchanged
+    for( const auto exponent : { 1.F, 1.5F } )
+    {
+        auto product = current;
+        const auto productNorms = elementwise::Multiply( measured.data(), weights.data(), exponent, product.data(), size, true );
+        squaredChangeNorm = 0.;
+        squaredUpdateNorm = 0.;
+        for( auto index{ 0 }; index < size; index++ )
+        {
+            const auto factor = weights[index] != 0.F ? std::pow( weights[index] * measured[index], exponent ) : 1.F;
+            EXPECT_NEAR( product[index], current[index] * factor, 1e-6F );
+            squaredChangeNorm += static_cast<double>( product[index] - current[index] ) * ( product[index] - current[index] );
+            squaredUpdateNorm += static_cast<double>( product[index] ) * product[index];
+        }
+        EXPECT_NEAR( productNorms.squaredChangeNorm, squaredChangeNorm, 1e-6 * squaredChangeNorm );
+        EXPECT_NEAR( productNorms.squaredNorm, squaredUpdateNorm, 1e-6 * squaredUpdateNorm );
+    }
+
+    // y = x + b y, then y += a x and x = z + b x
+    auto xpby = current;
+    squaredUpdateNorm = 0.;
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        const auto value = measured[index] - 0.25F * current[index];
+        squaredUpdateNorm += static_cast<double>( value ) * value;
+    }
+    expectNear( elementwise::Xpby( measured.data(), -0.25F, xpby.data(), size ), squaredUpdateNorm );
+    auto direction = current;
+    auto solution = weights;
+    elementwise::AxpyThenXpby( 2.F, measured.data(), 3.F, direction.data(), solution.data(), size );
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        EXPECT_FLOAT_EQ( xpby[index], measured[index] - 0.25F * current[index] );
+        EXPECT_FLOAT_EQ( solution[index], weights[index] + 2.F * current[index] );
+        EXPECT_FLOAT_EQ( direction[index], measured[index] + 3.F * current[index] );
+    }
+
+    auto clamped = residual;
+    elementwise::Scale( -1.F, clamped.data(), size );
+    elementwise::ClampToNonNegative( clamped.data(), size );
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        EXPECT_EQ( clamped[index], std::max( -residual[index], 0.F ) );
+    }
+}
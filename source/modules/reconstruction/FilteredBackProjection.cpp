@@ -0,0 +1,289 @@
+#include "modules/reconstruction/FilteredBackProjection.h"
+
+#include "commons/Maths.h"
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+#include "modules/reconstruction/SimdTargets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace    // anonymous namespace
+{
+int PaddedLength( int p_nbPixels )
+{
+    auto length{ 2 };
+    while( length < 2 * p_nbPixels )
+    {
+        length *= 2;
+    }
+    return length;
+}
+
+// Hann window equal to 1 at 0 and reaching 0 at p_cutOff
+double HannWindow( double p_frequency, double p_cutOff )
+{
+    return p_frequency < p_cutOff ? 0.5 * ( 1. + std::cos( pi() * p_frequency / p_cutOff ) ) : 0.;
+}
+
+// Frequency (cycles/mm, along the sweep) above which the structures are resolved in slices thinner than p_sliceThickness:
+// a frequency f seen under the half angular range a is blurred over 1 / ( 2 f tan( a ) ) in depth. 0 if not relevant
+float SliceThicknessCutOff( const ProjectorGeometry & p_geometry, float p_sliceThickness )
+{
+    auto maxTangent{ 0.F };
+    for( const auto & sourcePosition : p_geometry.sourcesPositions )
+    {
+        // the volume is centered on the origin
+        if( sourcePosition.z > 0.F )
+        {
+            maxTangent = std::max( maxTangent, std::fabs( sourcePosition.y ) / sourcePosition.z );
+        }
+    }
+    if( p_sliceThickness <= 0.F || maxTangent <= 0.F )
+    {
+        return 0.F;
+    }
+    return 1.F / ( 2.F * p_sliceThickness * maxTangent );
+}
+// butterflies of one block of 2 p_halfSize samples of the batch
+void Butterflies( const float * p_twiddlesReal, const float * p_twiddlesImaginary, int p_twiddleStep, int p_halfSize, float * p_real, float * p_imaginary )
+{
+    constexpr auto batchSize = FftPlan::batchSize;
+    for( auto index{ 0 }; index < p_halfSize; index++ )
+    {
+        const auto twiddleReal = p_twiddlesReal[index * p_twiddleStep];
+        const auto twiddleImaginary = p_twiddlesImaginary[index * p_twiddleStep];
+        auto evenReal = p_real + index * batchSize;
+        auto evenImaginary = p_imaginary + index * batchSize;
+        auto oddReal = p_real + ( index + p_halfSize ) * batchSize;
+        auto oddImaginary = p_imaginary + ( index + p_halfSize ) * batchSize;
+        for( auto signal{ 0 }; signal < batchSize; signal++ )
+        {
+            const auto productReal = twiddleReal * oddReal[signal] - twiddleImaginary * oddImaginary[signal];
+            const auto productImaginary = twiddleReal * oddImaginary[signal] + twiddleImaginary * oddReal[signal];
+            oddReal[signal] = evenReal[signal] - productReal;
+            oddImaginary[signal] = evenImaginary[signal] - productImaginary;
+            evenReal[signal] += productReal;
+            evenImaginary[signal] += productImaginary;
+        }
+    }
+}
+
+#ifdef TOMO_WITH_X86_SIMD
+// Butterflies with the 8 signals of the batch in one register
+TOMO_TARGET_AVX2 void ButterfliesAvx2( const float * p_twiddlesReal, const float * p_twiddlesImaginary, int p_twiddleStep, int p_halfSize, float * p_real, float * p_imaginary )
+{
+    static_assert( FftPlan::batchSize == 8, "one AVX2 register per sample" );
+    for( auto index{ 0 }; index < p_halfSize; index++ )
+    {
+        const auto twiddleReal = _mm256_set1_ps( p_twiddlesReal[index * p_twiddleStep] );
+        const auto twiddleImaginary = _mm256_set1_ps( p_twiddlesImaginary[index * p_twiddleStep] );
+        auto evenReal = p_real + index * 8;
+        auto evenImaginary = p_imaginary + index * 8;
+        auto oddReal = p_real + ( index + p_halfSize ) * 8;
+        auto oddImaginary = p_imaginary + ( index + p_halfSize ) * 8;
+        const auto oddRealValue = _mm256_loadu_ps( oddReal );
+        const auto oddImaginaryValue = _mm256_loadu_ps( oddImaginary );
+        const auto productReal = _mm256_fmsub_ps( twiddleReal, oddRealValue, _mm256_mul_ps( twiddleImaginary, oddImaginaryValue ) );
+        const auto productImaginary = _mm256_fmadd_ps( twiddleReal, oddImaginaryValue, _mm256_mul_ps( twiddleImaginary, oddRealValue ) );
+        const auto evenRealValue = _mm256_loadu_ps( evenReal );
+        const auto evenImaginaryValue = _mm256_loadu_ps( evenImaginary );
+        _mm256_storeu_ps( oddReal, _mm256_sub_ps( evenRealValue, productReal ) );
+        _mm256_storeu_ps( oddImaginary, _mm256_sub_ps( evenImaginaryValue, productImaginary ) );
+        _mm256_storeu_ps( evenReal, _mm256_add_ps( evenRealValue, productReal ) );
+        _mm256_storeu_ps( evenImaginary, _mm256_add_ps( evenImaginaryValue, productImaginary ) );
+    }
+}
+#endif
+}    // end of anonymous namespace
+
+FftPlan::FftPlan( int p_length )
+  : m_length{ p_length }
+  , m_bitReversal( p_length )
+  , m_twiddlesReal( p_length / 2 )
+  , m_twiddlesImaginary( p_length / 2 )
+{
+    auto nbBits{ 0 };
+    while( ( 1 << nbBits ) < m_length )
+    {
+        nbBits++;
+    }
+    for( auto index{ 0 }; index < m_length; index++ )
+    {
+        auto reversed{ 0 };
+        for( auto bit{ 0 }; bit < nbBits; bit++ )
+        {
+            reversed |= ( ( index >> bit ) & 1 ) << ( nbBits - 1 - bit );
+        }
+        m_bitReversal[index] = reversed;
+    }
+    for( auto index{ 0 }; index < m_length / 2; index++ )
+    {
+        const auto angle = -2. * pi() * index / m_length;
+        m_twiddlesReal[index] = static_cast<float>( std::cos( angle ) );
+        m_twiddlesImaginary[index] = static_cast<float>( std::sin( angle ) );
+    }
+}
+
+std::shared_ptr<const FftPlan> FftPlan::Shared( int p_length )
+{
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const FftPlan>> plans;
+    std::lock_guard<std::mutex> lock( mutex );
+    auto & plan = plans[p_length];
+    if( plan == nullptr )
+    {
+        plan = std::make_shared<const FftPlan>( p_length );
+    }
+    return plan;
+}
+
+void FftPlan::ForwardBatch( float * p_realBuffer, float * p_imaginaryBuffer ) const
+{
+    static const auto useAvx2 = cpuprojector::DetectSimdLevel() >= cpuprojector::SimdLevel::Avx2;
+    for( auto index{ 0 }; index < m_length; index++ )
+    {
+        if( index < m_bitReversal[index] )
+        {
+            std::swap_ranges( p_realBuffer + index * batchSize, p_realBuffer + ( index + 1 ) * batchSize, p_realBuffer + m_bitReversal[index] * batchSize );
+            std::swap_ranges( p_imaginaryBuffer + index * batchSize, p_imaginaryBuffer + ( index + 1 ) * batchSize, p_imaginaryBuffer + m_bitReversal[index] * batchSize );
+        }
+    }
+    for( auto halfSize{ 1 }; halfSize < m_length; halfSize *= 2 )
+    {
+        const auto twiddleStep = m_length / ( 2 * halfSize );
+        for( auto start{ 0 }; start < m_length; start += 2 * halfSize )
+        {
+#ifdef TOMO_WITH_X86_SIMD
+            if( useAvx2 )
+            {
+                ButterfliesAvx2( m_twiddlesReal.data(), m_twiddlesImaginary.data(), twiddleStep, halfSize, p_realBuffer + start * batchSize, p_imaginaryBuffer + start * batchSize );
+                continue;
+            }
+#endif
+            Butterflies( m_twiddlesReal.data(), m_twiddlesImaginary.data(), twiddleStep, halfSize, p_realBuffer + start * batchSize, p_imaginaryBuffer + start * batchSize );
+        }
+    }
+}
+
+ProjectionsFilter::ProjectionsFilter( int p_nbPixels, float p_pixelSpacing, float p_sliceThicknessCutOff, const FilterParameters & p_parameters )
+  : m_nbPixels{ std::max( 0, p_nbPixels ) }
+  , m_fftPlan{ FftPlan::Shared( PaddedLength( p_nbPixels ) ) }
+  , m_frequencyResponse( m_fftPlan->GetLength() )
+  , m_scaledFrequencyResponse( m_fftPlan->GetLength() )
+{
+    const auto length = m_fftPlan->GetLength();
+
+    // Ram-Lak kernel sampled on the pixels: 1 / ( 4 d^2 ) at 0, -1 / ( pi k d )^2 at odd k, 0 at even k (first signal of the batch)
+    std::vector<float> kernelReal( static_cast<size_t>( length ) * FftPlan::batchSize, 0.F );
+    std::vector<float> kernelImaginary( kernelReal.size(), 0.F );
+    const auto spacing = static_cast<double>( p_pixelSpacing );
+    kernelReal[0] = static_cast<float>( 1. / ( 4. * spacing * spacing ) );
+    for( auto shift{ 1 }; shift < m_nbPixels; shift += 2 )
+    {
+        const auto value = static_cast<float>( -1. / std::pow( pi() * shift * spacing, 2 ) );
+        kernelReal[shift * FftPlan::batchSize] = value;
+        kernelReal[( length - shift ) * FftPlan::batchSize] = value;
+    }
+    m_fftPlan->ForwardBatch( kernelReal.data(), kernelImaginary.data() );
+
+    const auto nyquistFrequency = 0.5 / spacing;
+    const auto apodizationCutOff = std::clamp( static_cast<double>( p_parameters.apodizationCutOff ), 0.01, 1. ) * nyquistFrequency;
+    for( auto index{ 0 }; index < length; index++ )
+    {
+        const auto frequency = std::min( index, length - index ) / ( length * spacing );
+        auto response = spacing * kernelReal[index * FftPlan::batchSize] * HannWindow( frequency, apodizationCutOff );
+        if( p_sliceThicknessCutOff > 0.F )
+        {
+            response *= HannWindow( frequency, p_sliceThicknessCutOff );
+        }
+        m_frequencyResponse[index] = static_cast<float>( response );
+        m_scaledFrequencyResponse[index] = static_cast<float>( response / length );
+    }
+}
+
+bool ProjectionsFilter::FilterColumns( float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, int p_nbProjections ) const
+{
+    if( p_nbRows != m_nbPixels )
+    {
+        std::cout << "ProjectionsFilter: " << std::to_string( p_nbRows ) << " rows, the filter is built for " << std::to_string( m_nbPixels ) << std::endl;
+        return false;
+    }
+    // a task filters a block of neighbouring columns, so that the rows are read and written by contiguous pieces.
+    // Column 2 s + 1 of the block is the imaginary part of signal s
+    constexpr auto batchSize = FftPlan::batchSize;
+    constexpr auto columnsBlockSize = 2 * batchSize;
+    const auto nbBlocks = ( p_nbColumns + columnsBlockSize - 1 ) / columnsBlockSize;
+    const auto tasks = IndexRange{ p_nbProjections * nbBlocks };
+    const auto length = m_fftPlan->GetLength();
+    std::for_each( std::execution::par, tasks.begin(), tasks.end(), [&]( int p_task ) {
+        // work signals reused by the tasks of the thread
+        thread_local std::vector<float> real;
+        thread_local std::vector<float> imaginary;
+        real.assign( static_cast<size_t>( length ) * batchSize, 0.F );
+        imaginary.assign( static_cast<size_t>( length ) * batchSize, 0.F );
+
+        const auto projectionIndex = p_task / nbBlocks;
+        const auto firstColumn = ( p_task % nbBlocks ) * columnsBlockSize;
+        const auto nbBlockColumns = std::min( columnsBlockSize, p_nbColumns - firstColumn );
+        auto projection = p_projectionsBuffer + static_cast<size_t>( projectionIndex ) * p_nbColumns * p_nbRows + firstColumn;
+        for( auto row{ 0 }; row < p_nbRows; row++ )
+        {
+            const auto projectionRow = projection + static_cast<size_t>( row ) * p_nbColumns;
+            for( auto column{ 0 }; column < nbBlockColumns; column++ )
+            {
+                ( column % 2 == 0 ? real : imaginary )[row * batchSize + column / 2] = projectionRow[column];
+            }
+        }
+
+        // inverse FFT( H FFT( x ) ) = conj( FFT( conj( H FFT( x ) ) ) ) / N: the conjugations and 1 / N are merged into the product
+        m_fftPlan->ForwardBatch( real.data(), imaginary.data() );
+        for( auto index{ 0 }; index < length; index++ )
+        {
+            const auto response = m_scaledFrequencyResponse[index];
+            for( auto signal{ 0 }; signal < batchSize; signal++ )
+            {
+                real[index * batchSize + signal] *= response;
+                imaginary[index * batchSize + signal] *= -response;
+            }
+        }
+        m_fftPlan->ForwardBatch( real.data(), imaginary.data() );
+
+        for( auto row{ 0 }; row < p_nbRows; row++ )
+        {
+            auto projectionRow = projection + static_cast<size_t>( row ) * p_nbColumns;
+            for( auto column{ 0 }; column < nbBlockColumns; column++ )
+            {
+                projectionRow[column] = column % 2 == 0 ? real[row * batchSize + column / 2] : -imaginary[row * batchSize + column / 2];
+            }
+        }
+    } );
+    return true;
+}
+
+FilteredBackProjector::FilteredBackProjector( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, const FilterParameters & p_parameters )
+  : m_plan{ p_tomoGeometry, p_backend }
+  , m_filter{ m_plan.GetGeometry().projectionsDimension.y,
+              m_plan.GetGeometry().projectionsPixelsSpacing.y,
+              SliceThicknessCutOff( m_plan.GetGeometry(), p_parameters.sliceThickness ),
+              p_parameters }
+  , m_filteredProjections( m_plan.GetGeometry().GetProjectionsPixelsNumber() )
+{
+}
+
+bool FilteredBackProjector::Reconstruct( const float * p_projectionsBuffer, float * p_volumeBuffer )
+{
+    const auto & geometry = m_plan.GetGeometry();
+    std::copy( p_projectionsBuffer, p_projectionsBuffer + m_filteredProjections.size(), m_filteredProjections.begin() );
+    if( !m_filter.FilterColumns( m_filteredProjections.data(), geometry.projectionsDimension.x, geometry.projectionsDimension.y, geometry.projectionsDimension.z ) )
+    {
+        return false;
+    }
+    m_plan.BackProject( m_filteredProjections.data(), p_volumeBuffer );
+    return true;
+}
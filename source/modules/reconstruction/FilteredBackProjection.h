@@ -0,0 +1,87 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+
+#include <memory>
+#include <vector>
+
+// Tomosynthesis filter bank, applied along the detector lines parallel to the sources sweep (y axis)
+struct FilterParameters
+{
+    float apodizationCutOff{ 1.F };    // Hann window reaching 0 at this fraction of the Nyquist frequency, in ]0, 1]
+    float sliceThickness{ 0.F };       // mm, Hann low pass removing the frequencies resolved in thinner slices (0: none)
+};
+
+// Radix-2 complex FFT of a fixed length, with its bit reversal and twiddle tables computed once.
+// It transforms batchSize signals at once, stored planar and interleaved by sample (real[sample * batchSize + signal]),
+// so that every butterfly is a SIMD operation on the batch (AVX2 when available)
+class FftPlan
+{
+public:
+    static constexpr int batchSize{ 8 };
+
+    FftPlan( int p_length );    // p_length must be a power of 2
+    // plan of p_length shared by all the filters of this length: built at the first request, then kept
+    static std::shared_ptr<const FftPlan> Shared( int p_length );
+
+    int GetLength() const { return m_length; }
+    // in place, unnormalized, exp( -2 i pi k n / N ) kernel
+    void ForwardBatch( float * p_realBuffer, float * p_imaginaryBuffer ) const;
+
+private:
+    int m_length;
+    std::vector<int> m_bitReversal;
+    std::vector<float> m_twiddlesReal;
+    std::vector<float> m_twiddlesImaginary;
+};
+
+// Filter of the projections lines of p_nbPixels pixels: ramp (sampled Ram-Lak kernel, no DC bias) times the spectral
+// apodization and the slice thickness filter. The lines are zero padded to a power of 2 at least twice as long, so that
+// the filtering is a linear convolution. Two lines are the real and imaginary parts of one complex signal (the response
+// being real and even, both are filtered independently), and FftPlan::batchSize such pairs are transformed at once.
+class ProjectionsFilter
+{
+public:
+    ProjectionsFilter( int p_nbPixels, float p_pixelSpacing, float p_sliceThicknessCutOff, const FilterParameters & p_parameters );
+
+    int GetNbPixels() const { return m_nbPixels; }
+    const std::vector<float> & GetFrequencyResponse() const { return m_frequencyResponse; }
+
+    // in place filtering of the columns (lines along y) of p_nbProjections projections of p_nbColumns x p_nbRows pixels,
+    // in parallel over the blocks of 2 FftPlan::batchSize columns. Returns false (the reason is printed) if p_nbRows is not
+    // the filter number of pixels
+    bool FilterColumns( float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, int p_nbProjections ) const;
+
+private:
+    int m_nbPixels;
+    std::shared_ptr<const FftPlan> m_fftPlan;    // shared plan of the padded length
+    std::vector<float> m_frequencyResponse;
+    std::vector<float> m_scaledFrequencyResponse;    // divided by the length: normalization of the inverse FFT
+};
+
+// Filtered back projection: filtering of the projections followed by the back projection of a ProjectorPlan.
+// The filter and the plan are built once, Reconstruct can then be called on any projections of the geometry (by one
+// thread at a time: the filtered projections buffer is reused).
+// Scale: the plan back projection is the normalized one, the mean over the views seen by each voxel, and the ray-driven
+// projections are ray means. The volume is then proportional to the attenuation for a given geometry, but is not in
+// attenuation units.
+class FilteredBackProjector
+{
+public:
+    FilteredBackProjector( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, const FilterParameters & p_parameters );
+
+    bool IsValid() const { return m_plan.IsValid(); }
+    ProjectorPlan & GetPlan() { return m_plan; }
+    const ProjectionsFilter & GetFilter() const { return m_filter; }
+    // filtered copy of the last reconstructed projections
+    const std::vector<float> & GetFilteredProjections() const { return m_filteredProjections; }
+
+    // false (the reason is printed) if the projections cannot be filtered
+    bool Reconstruct( const float * p_projectionsBuffer, float * p_volumeBuffer );
+
+private:
+    ProjectorPlan m_plan;
+    ProjectionsFilter m_filter;
+    std::vector<float> m_filteredProjections;
+};
@@ -0,0 +1,85 @@
+#include "commons/Maths.h"
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/FilteredBackProjection.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "test_utils/TestInitializer.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( FilteredBackProjectionTest, ProjectionsFilterMatchesDirectFiltering )
+{
+    constexpr auto nbColumns{ 5 };    // odd: the last column is filtered alone
+    constexpr auto nbRows{ 37 };
+    constexpr auto nbProjections{ 2 };
+    constexpr auto pixelSpacing{ 0.2F };
+    ProjectionsFilter filter( nbRows, pixelSpacing, 0.F, FilterParameters{ 0.8F, 0.F } );
+    const auto & response = filter.GetFrequencyResponse();
+    const auto length = static_cast<int>( response.size() );
+    ASSERT_GE( length, 2 * nbRows );
+
+    // ramp: almost no DC, growing with the frequency below the apodization
+    EXPECT_LT( std::fabs( response[0] ), 0.05F * response[length / 8] );
+    EXPECT_LT( response[length / 16], response[length / 8] );
+
+    const auto projections = RandomBuffer( nbColumns * nbRows * nbProjections, 12U );
+    auto filteredProjections = projections;
+    // the columns must have the length of the filter
+    EXPECT_FALSE( filter.FilterColumns( filteredProjections.data(), nbColumns, nbRows + 1, nbProjections ) );
+    ASSERT_TRUE( filter.FilterColumns( filteredProjections.data(), nbColumns, nbRows, nbProjections ) );
+
+    // reference: naive DFT of each zero padded column
+    for( auto projectionIndex{ 0 }; projectionIndex < nbProjections; projectionIndex++ )
+    {
+        for( auto column{ 0 }; column < nbColumns; column++ )
+        {
+            std::vector<std::complex<double>> spectrum( length );
+            for( auto frequency{ 0 }; frequency < length; frequency++ )
+            {
+                for( auto row{ 0 }; row < nbRows; row++ )
+                {
+                    spectrum[frequency] += static_cast<double>( projections[( projectionIndex * nbRows + row ) * nbColumns + column] )
+                                           * std::polar( 1., -2. * pi() * frequency * row / length );
+                }
+                spectrum[frequency] *= response[frequency];
+            }
+            for( auto row{ 0 }; row < nbRows; row++ )
+            {
+                std::complex<double> value;
+                for( auto frequency{ 0 }; frequency < length; frequency++ )
+                {
+                    value += spectrum[frequency] * std::polar( 1., 2. * pi() * frequency * row / length );
+                }
+                ASSERT_NEAR( filteredProjections[( projectionIndex * nbRows + row ) * nbColumns + column], value.real() / length, 0.001 * response[length / 8] );
+            }
+        }
+    }
+}
+
+TEST( FilteredBackProjectionTest, FilteredBackProjectorIsReusable )
+{
+    // filters of the same padded length share their FFT plan
+    EXPECT_EQ( FftPlan::Shared( 64 ), FftPlan::Shared( 64 ) );
+    EXPECT_NE( FftPlan::Shared( 64 ), FftPlan::Shared( 128 ) );
+
+    // a second reconstruction with the same filtered back projector gives the same volume
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        FilteredBackProjector filteredBackProjector( &tomoGeometry, ProjectorBackend::CpuIncremental, FilterParameters{ 0.8F, 1.F } );
+        ASSERT_TRUE( filteredBackProjector.IsValid() ) << path;
+        const auto & geometry = filteredBackProjector.GetPlan().GetGeometry();
+        const auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 5U );
+        std::vector<float> firstVolume( geometry.GetVolumeVoxelsNumber() );
+        std::vector<float> secondVolume( firstVolume.size() );
+        ASSERT_TRUE( filteredBackProjector.Reconstruct( projections.data(), firstVolume.data() ) ) << path;
+        ASSERT_TRUE( filteredBackProjector.Reconstruct( projections.data(), secondVolume.data() ) ) << path;
+        EXPECT_EQ( firstVolume, secondVolume ) << path;
+    }
+}
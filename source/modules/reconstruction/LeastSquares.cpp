@@ -0,0 +1,139 @@
+#include "modules/reconstruction/LeastSquares.h"
+
+#include "modules/reconstruction/ElementWise.h"
+
+#include <cmath>
+
+LeastSquaresSolver::LeastSquaresSolver( TomoGeometry const * p_tomoGeometry )
+  : LeastSquaresSolver( p_tomoGeometry, ProjectorBackend::CpuMatched )
+{
+}
+
+LeastSquaresSolver::LeastSquaresSolver( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend )
+  : m_plan{ p_tomoGeometry, p_backend }
+{
+    if( !m_plan.IsValid() )
+    {
+        return;
+    }
+    const auto & geometry = m_plan.GetGeometry();
+    m_firstProjections.resize( geometry.GetProjectionsPixelsNumber() );
+    m_secondProjections.resize( geometry.GetProjectionsPixelsNumber() );
+    m_firstVolume.resize( geometry.GetVolumeVoxelsNumber() );
+    m_secondVolume.resize( geometry.GetVolumeVoxelsNumber() );
+    m_thirdVolume.resize( geometry.GetVolumeVoxelsNumber() );
+}
+
+std::vector<double> LeastSquaresSolver::Solve( LeastSquaresMethod p_method, const float * p_projectionsBuffer, int p_iterationNumber, float * p_volumeBuffer )
+{
+    if( !this->IsValid() )
+    {
+        return {};
+    }
+    return p_method == LeastSquaresMethod::LSQR ? this->SolveLSQR( p_projectionsBuffer, p_iterationNumber, p_volumeBuffer )
+                                                : this->SolveCGLS( p_projectionsBuffer, p_iterationNumber, p_volumeBuffer );
+}
+
+std::vector<double> LeastSquaresSolver::SolveCGLS( const float * p_projectionsBuffer, int p_iterationNumber, float * p_volumeBuffer )
+{
+    auto & residual = m_firstProjections;
+    auto & projectedDirection = m_secondProjections;
+    auto & gradient = m_firstVolume;
+    auto & direction = m_secondVolume;
+
+    // r = b - A x, s = A^T r, p = s
+    m_plan.Project( p_volumeBuffer, residual.data() );
+    auto residualSquaredNorm = elementwise::Xpby( p_projectionsBuffer, -1.F, residual.data(), residual.size() );
+    m_plan.BackProject( residual.data(), gradient.data() );
+    std::copy( gradient.cbegin(), gradient.cend(), direction.begin() );
+    auto gradientSquaredNorm = elementwise::SquaredNorm( gradient.data(), gradient.size() );
+
+    std::vector<double> residualNorms{ std::sqrt( residualSquaredNorm ) };
+    for( auto iteration{ 0 }; iteration < p_iterationNumber && gradientSquaredNorm > 0.; iteration++ )
+    {
+        // q = A p, alpha = || s ||^2 / || q ||^2
+        m_plan.Project( direction.data(), projectedDirection.data() );
+        const auto projectedDirectionSquaredNorm = elementwise::SquaredNorm( projectedDirection.data(), projectedDirection.size() );
+        if( projectedDirectionSquaredNorm <= 0. )
+        {
+            break;
+        }
+        const auto alpha = static_cast<float>( gradientSquaredNorm / projectedDirectionSquaredNorm );
+
+        // r -= alpha q, s = A^T r, beta = || s_new ||^2 / || s ||^2
+        residualSquaredNorm = elementwise::Axpy( -alpha, projectedDirection.data(), nullptr, residual.data(), residual.size(), true ).squaredNorm;
+        m_plan.BackProject( residual.data(), gradient.data() );
+        const auto newGradientSquaredNorm = elementwise::SquaredNorm( gradient.data(), gradient.size() );
+        const auto beta = static_cast<float>( newGradientSquaredNorm / gradientSquaredNorm );
+        gradientSquaredNorm = newGradientSquaredNorm;
+
+        // x += alpha p, p = s + beta p
+        elementwise::AxpyThenXpby( alpha, gradient.data(), beta, direction.data(), p_volumeBuffer, direction.size() );
+        residualNorms.push_back( std::sqrt( residualSquaredNorm ) );
+    }
+    return residualNorms;
+}
+
+std::vector<double> LeastSquaresSolver::SolveLSQR( const float * p_projectionsBuffer, int p_iterationNumber, float * p_volumeBuffer )
+{
+    auto & u = m_firstProjections;
+    auto & projectedV = m_secondProjections;
+    auto & v = m_firstVolume;
+    auto & w = m_secondVolume;
+    auto & backProjectedU = m_thirdVolume;
+
+    // beta u = b - A x, alpha v = A^T u, w = v
+    m_plan.Project( p_volumeBuffer, u.data() );
+    auto beta = std::sqrt( elementwise::Xpby( p_projectionsBuffer, -1.F, u.data(), u.size() ) );
+    std::vector<double> residualNorms{ beta };
+    if( beta <= 0. )
+    {
+        return residualNorms;
+    }
+    elementwise::Scale( static_cast<float>( 1. / beta ), u.data(), u.size() );
+    m_plan.BackProject( u.data(), v.data() );
+    auto alpha = std::sqrt( elementwise::SquaredNorm( v.data(), v.size() ) );
+    if( alpha <= 0. )
+    {
+        return residualNorms;
+    }
+    elementwise::Scale( static_cast<float>( 1. / alpha ), v.data(), v.size() );
+    std::copy( v.cbegin(), v.cend(), w.begin() );
+    auto phiBar = beta;
+    auto rhoBar = alpha;
+
+    for( auto iteration{ 0 }; iteration < p_iterationNumber; iteration++ )
+    {
+        // bidiagonalization: beta u = A v - alpha u, alpha v = A^T u - beta v
+        m_plan.Project( v.data(), projectedV.data() );
+        beta = std::sqrt( elementwise::Xpby( projectedV.data(), static_cast<float>( -alpha ), u.data(), u.size() ) );
+        if( beta > 0. )
+        {
+            elementwise::Scale( static_cast<float>( 1. / beta ), u.data(), u.size() );
+            m_plan.BackProject( u.data(), backProjectedU.data() );
+            alpha = std::sqrt( elementwise::Xpby( backProjectedU.data(), static_cast<float>( -beta ), v.data(), v.size() ) );
+            if( alpha > 0. )
+            {
+                elementwise::Scale( static_cast<float>( 1. / alpha ), v.data(), v.size() );
+            }
+        }
+
+        // plane rotation eliminating the subdiagonal
+        const auto rho = std::hypot( rhoBar, beta );
+        const auto c = rhoBar / rho;
+        const auto s = beta / rho;
+        const auto theta = s * alpha;
+        rhoBar = -c * alpha;
+        const auto phi = c * phiBar;
+        phiBar = s * phiBar;
+
+        // x += ( phi / rho ) w, w = v - ( theta / rho ) w
+        elementwise::AxpyThenXpby( static_cast<float>( phi / rho ), v.data(), static_cast<float>( -theta / rho ), w.data(), p_volumeBuffer, w.size() );
+        residualNorms.push_back( std::fabs( phiBar ) );
+        if( beta <= 0. || alpha <= 0. )
+        {
+            break;
+        }
+    }
+    return residualNorms;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+
+#include <vector>
+
+enum class LeastSquaresMethod
+{
+    CGLS = 0,    // conjugate gradients on the normal equations
+    LSQR         // Paige and Saunders bidiagonalization, same iterates in exact arithmetic but better conditioned
+};
+
+// Matrix-free Krylov solver of min || b - A x ||, A being the projection of a ProjectorPlan and A^T its back projection.
+// The back projection must then be the adjoint of the projection: the default CpuMatched backend,
+// CpuDistanceDrivenMatched and CpuSeparableFootprintMatched are the exact pairs (the other backends normalize their
+// back projection).
+// The work vectors (two projections stacks, three volumes) are allocated once in the constructor.
+class LeastSquaresSolver
+{
+public:
+    LeastSquaresSolver( TomoGeometry const * p_tomoGeometry );
+    LeastSquaresSolver( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend );
+    ~LeastSquaresSolver() = default;
+
+    bool IsValid() const { return m_plan.IsValid(); }
+    ProjectorPlan & GetPlan() { return m_plan; }
+
+    // p_volumeBuffer is the initial guess and receives the solution.
+    // Return the residual norms || b - A x ||, the first one being the one of the initial guess
+    // (LSQR ones are the recurrence estimates, exact up to rounding)
+    std::vector<double> Solve( LeastSquaresMethod p_method, const float * p_projectionsBuffer, int p_iterationNumber, float * p_volumeBuffer );
+
+private:
+    std::vector<double> SolveCGLS( const float * p_projectionsBuffer, int p_iterationNumber, float * p_volumeBuffer );
+    std::vector<double> SolveLSQR( const float * p_projectionsBuffer, int p_iterationNumber, float * p_volumeBuffer );
+
+    ProjectorPlan m_plan;
+    std::vector<float> m_firstProjections;
+    std::vector<float> m_secondProjections;
+    std::vector<float> m_firstVolume;
+    std::vector<float> m_secondVolume;
+    std::vector<float> m_thirdVolume;
+};
@@ -0,0 +1,50 @@
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/LeastSquares.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "test_utils/TestInitializer.h"
+
+#include <cmath>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( LeastSquaresTest, LeastSquaresSolversDecreaseResidual )
+{
+    constexpr auto nbIterations = 6;
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        LeastSquaresSolver solver( &tomoGeometry );
+        ASSERT_TRUE( solver.IsValid() ) << path;
+        const auto & geometry = solver.GetPlan().GetGeometry();
+        const auto volume = SmoothVolume( geometry );
+        std::vector<float> projections( geometry.GetProjectionsPixelsNumber() );
+        solver.GetPlan().Project( volume.data(), projections.data() );
+
+        for( auto method : { LeastSquaresMethod::CGLS, LeastSquaresMethod::LSQR } )
+        {
+            std::vector<float> solution( volume.size(), 0.F );
+            const auto residualNorms = solver.Solve( method, projections.data(), nbIterations, solution.data() );
+            ASSERT_EQ( residualNorms.size(), static_cast<size_t>( nbIterations + 1 ) ) << path;
+            // both methods minimize the residual over growing Krylov subspaces
+            for( auto iteration{ 1 }; iteration <= nbIterations; iteration++ )
+            {
+                EXPECT_LE( residualNorms[iteration], residualNorms[iteration - 1] * ( 1. + 0.0001 ) ) << path;
+            }
+            EXPECT_LT( residualNorms.back(), 0.5 * residualNorms.front() ) << path;
+
+            // reported residual is the one of the returned solution
+            std::vector<float> solutionProjections( projections.size() );
+            solver.GetPlan().Project( solution.data(), solutionProjections.data() );
+            auto residualSquaredNorm{ 0. };
+            for( auto index{ 0U }; index < projections.size(); index++ )
+            {
+                residualSquaredNorm += std::pow( static_cast<double>( projections[index] ) - solutionProjections[index], 2 );
+            }
+            EXPECT_NEAR( std::sqrt( residualSquaredNorm ), residualNorms.back(), 0.01 * residualNorms.front() ) << path;
+        }
+    }
+}
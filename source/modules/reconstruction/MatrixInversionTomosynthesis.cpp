@@ -0,0 +1,418 @@
+#include "modules/reconstruction/MatrixInversionTomosynthesis.h"
+
+#include "commons/Maths.h"
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+#include "modules/reconstruction/SimdTargets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <execution>
+#include <iostream>
+
+namespace    // anonymous namespace
+{
+// power of 2 holding the rows and the largest relative translation between two slices, so that the circular
+// convolutions of the FFT do not wrap the blur around
+int PaddedLength( const ShiftAndAddEngine & p_shiftAndAddEngine, int p_nbRows )
+{
+    auto maxSpan{ 0.F };
+    for( auto projectionIndex{ 0 }; projectionIndex < p_shiftAndAddEngine.GetNbProjections(); projectionIndex++ )
+    {
+        auto minShift{ 0.F };
+        auto maxShift{ 0.F };
+        for( auto sliceIndex{ 0 }; sliceIndex < p_shiftAndAddEngine.GetNbSlices(); sliceIndex++ )
+        {
+            const auto shift = p_shiftAndAddEngine.GetShift( sliceIndex, projectionIndex );
+            minShift = sliceIndex == 0 ? shift : std::min( minShift, shift );
+            maxShift = sliceIndex == 0 ? shift : std::max( maxShift, shift );
+        }
+        maxSpan = std::max( maxSpan, maxShift - minShift );
+    }
+    auto length{ 2 };
+    while( length < p_nbRows + static_cast<int>( std::ceil( maxSpan ) ) + 1 )
+    {
+        length *= 2;
+    }
+    return length;
+}
+
+// p_rightHandSides = p_matrix^-1 p_rightHandSides, p_matrix being Hermitian positive definite (Cholesky factorization,
+// in place). Both are p_size x p_size, row major
+void SolveHermitian( std::vector<std::complex<double>> & p_matrix, std::vector<std::complex<double>> & p_rightHandSides, int p_size )
+{
+    // p_matrix = L L^H, L stored in the lower triangle
+    for( auto column{ 0 }; column < p_size; column++ )
+    {
+        auto diagonal = p_matrix[column * p_size + column].real();
+        for( auto k{ 0 }; k < column; k++ )
+        {
+            diagonal -= std::norm( p_matrix[column * p_size + k] );
+        }
+        diagonal = std::sqrt( std::max( diagonal, 1e-300 ) );
+        p_matrix[column * p_size + column] = diagonal;
+        for( auto row{ column + 1 }; row < p_size; row++ )
+        {
+            auto value = p_matrix[row * p_size + column];
+            for( auto k{ 0 }; k < column; k++ )
+            {
+                value -= p_matrix[row * p_size + k] * std::conj( p_matrix[column * p_size + k] );
+            }
+            p_matrix[row * p_size + column] = value / diagonal;
+        }
+    }
+    for( auto rightHandSide{ 0 }; rightHandSide < p_size; rightHandSide++ )
+    {
+        // L y = b, then L^H x = y
+        for( auto row{ 0 }; row < p_size; row++ )
+        {
+            auto value = p_rightHandSides[row * p_size + rightHandSide];
+            for( auto k{ 0 }; k < row; k++ )
+            {
+                value -= p_matrix[row * p_size + k] * p_rightHandSides[k * p_size + rightHandSide];
+            }
+            p_rightHandSides[row * p_size + rightHandSide] = value / p_matrix[row * p_size + row].real();
+        }
+        for( auto row{ p_size - 1 }; row >= 0; row-- )
+        {
+            auto value = p_rightHandSides[row * p_size + rightHandSide];
+            for( auto k{ row + 1 }; k < p_size; k++ )
+            {
+                value -= std::conj( p_matrix[k * p_size + row] ) * p_rightHandSides[k * p_size + rightHandSide];
+            }
+            p_rightHandSides[row * p_size + rightHandSide] = value / p_matrix[row * p_size + row].real();
+        }
+    }
+}
+
+// p_output( s ) = sum over z of p_operator( s, z ) p_spectra( z ), for the batch of signals of one frequency, then
+// conjugated for the inverse FFT. p_spectra( z ) is at p_spectraReal + z * p_sliceStride
+void ApplyOperator( const float * p_operatorReal,
+                    const float * p_operatorImaginary,
+                    int p_nbSlices,
+                    const float * p_spectraReal,
+                    const float * p_spectraImaginary,
+                    size_t p_sliceStride,
+                    float * p_outputReal,
+                    float * p_outputImaginary )
+{
+    constexpr auto batchSize = FftPlan::batchSize;
+    for( auto slice{ 0 }; slice < p_nbSlices; slice++ )
+    {
+        float real[batchSize]{};
+        float imaginary[batchSize]{};
+        for( auto otherSlice{ 0 }; otherSlice < p_nbSlices; otherSlice++ )
+        {
+            const auto operatorReal = p_operatorReal[slice * p_nbSlices + otherSlice];
+            const auto operatorImaginary = p_operatorImaginary[slice * p_nbSlices + otherSlice];
+            const auto spectrumReal = p_spectraReal + otherSlice * p_sliceStride;
+            const auto spectrumImaginary = p_spectraImaginary + otherSlice * p_sliceStride;
+            for( auto signal{ 0 }; signal < batchSize; signal++ )
+            {
+                real[signal] += operatorReal * spectrumReal[signal] - operatorImaginary * spectrumImaginary[signal];
+                imaginary[signal] += operatorReal * spectrumImaginary[signal] + operatorImaginary * spectrumReal[signal];
+            }
+        }
+        for( auto signal{ 0 }; signal < batchSize; signal++ )
+        {
+            p_outputReal[slice * batchSize + signal] = real[signal];
+            p_outputImaginary[slice * batchSize + signal] = -imaginary[signal];
+        }
+    }
+}
+
+#ifdef TOMO_WITH_X86_SIMD
+// ApplyOperator with the 8 signals of the batch in one register
+TOMO_TARGET_AVX2 void ApplyOperatorAvx2( const float * p_operatorReal,
+                                         const float * p_operatorImaginary,
+                                         int p_nbSlices,
+                                         const float * p_spectraReal,
+                                         const float * p_spectraImaginary,
+                                         size_t p_sliceStride,
+                                         float * p_outputReal,
+                                         float * p_outputImaginary )
+{
+    static_assert( FftPlan::batchSize == 8, "one AVX2 register per frequency" );
+    for( auto slice{ 0 }; slice < p_nbSlices; slice++ )
+    {
+        auto real = _mm256_setzero_ps();
+        auto imaginary = _mm256_setzero_ps();
+        for( auto otherSlice{ 0 }; otherSlice < p_nbSlices; otherSlice++ )
+        {
+            const auto operatorReal = _mm256_set1_ps( p_operatorReal[slice * p_nbSlices + otherSlice] );
+            const auto operatorImaginary = _mm256_set1_ps( p_operatorImaginary[slice * p_nbSlices + otherSlice] );
+            const auto spectrumReal = _mm256_loadu_ps( p_spectraReal + otherSlice * p_sliceStride );
+            const auto spectrumImaginary = _mm256_loadu_ps( p_spectraImaginary + otherSlice * p_sliceStride );
+            real = _mm256_fmadd_ps( operatorReal, spectrumReal, _mm256_fnmadd_ps( operatorImaginary, spectrumImaginary, real ) );
+            imaginary = _mm256_fmadd_ps( operatorReal, spectrumImaginary, _mm256_fmadd_ps( operatorImaginary, spectrumReal, imaginary ) );
+        }
+        _mm256_storeu_ps( p_outputReal + slice * 8, real );
+        _mm256_storeu_ps( p_outputImaginary + slice * 8, _mm256_sub_ps( _mm256_setzero_ps(), imaginary ) );
+    }
+}
+#endif
+}    // end of anonymous namespace
+
+MitsEngine::MitsEngine( TomoGeometry const * p_tomoGeometry, int p_nbRows, float p_regularization )
+  : m_shiftAndAddEngine{ p_tomoGeometry }
+  , m_nbRows{ std::max( 1, p_nbRows ) }
+  , m_regularization{ std::max( 0.F, p_regularization ) }
+  , m_fftPlan{ PaddedLength( m_shiftAndAddEngine, m_nbRows ) }
+{
+    if( !m_shiftAndAddEngine.IsValid() )
+    {
+        return;
+    }
+    if( m_regularization <= 0.F )
+    {
+        std::cout << "MITS: the regularization must be > 0, the zero frequency being singular" << std::endl;
+        return;
+    }
+    const auto nbSlices = this->GetNbSlices();
+    const auto nbProjections = m_shiftAndAddEngine.GetNbProjections();
+    const auto length = m_fftPlan.GetLength();
+    const auto matrixSize = static_cast<size_t>( nbSlices ) * nbSlices;
+    m_operatorReal.resize( matrixSize * length );
+    m_operatorImaginary.resize( matrixSize * length );
+
+    // the operator of frequency length - k is the conjugate of the one of k: only k <= length / 2 are solved
+    const auto frequencies = IndexRange{ length / 2 + 1 };
+    std::for_each( std::execution::par, frequencies.begin(), frequencies.end(), [&]( int p_frequency ) {
+        // M( s, z ) = mean over p of exp( 2 i pi k ( shift( s, p ) - shift( z, p ) ) / length ): translation of x( r + d )
+        std::vector<std::complex<double>> phases( static_cast<size_t>( nbSlices ) * nbProjections );
+        for( auto slice{ 0 }; slice < nbSlices; slice++ )
+        {
+            for( auto projection{ 0 }; projection < nbProjections; projection++ )
+            {
+                phases[slice * nbProjections + projection] = std::polar( 1., 2. * pi() * p_frequency * m_shiftAndAddEngine.GetShift( slice, projection ) / length );
+            }
+        }
+        std::vector<std::complex<double>> blur( matrixSize, 0. );
+        for( auto slice{ 0 }; slice < nbSlices; slice++ )
+        {
+            for( auto otherSlice{ 0 }; otherSlice < nbSlices; otherSlice++ )
+            {
+                std::complex<double> sum{ 0. };
+                for( auto projection{ 0 }; projection < nbProjections; projection++ )
+                {
+                    sum += phases[slice * nbProjections + projection] * std::conj( phases[otherSlice * nbProjections + projection] );
+                }
+                blur[slice * nbSlices + otherSlice] = sum / static_cast<double>( nbProjections );
+            }
+        }
+
+        // ( M^H M + regularization I ) W = M^H
+        std::vector<std::complex<double>> normalMatrix( matrixSize, 0. );
+        std::vector<std::complex<double>> inverse( matrixSize, 0. );
+        for( auto row{ 0 }; row < nbSlices; row++ )
+        {
+            for( auto column{ 0 }; column < nbSlices; column++ )
+            {
+                std::complex<double> sum{ row == column ? static_cast<double>( m_regularization ) : 0. };
+                for( auto k{ 0 }; k < nbSlices; k++ )
+                {
+                    sum += std::conj( blur[k * nbSlices + row] ) * blur[k * nbSlices + column];
+                }
+                normalMatrix[row * nbSlices + column] = sum;
+                inverse[row * nbSlices + column] = std::conj( blur[column * nbSlices + row] );
+            }
+        }
+        SolveHermitian( normalMatrix, inverse, nbSlices );
+
+        // 1 / length of the inverse FFT merged in. At the Nyquist frequency, its own mirror, only the real part is kept
+        // so that real slices stay real
+        const auto isNyquist = 2 * p_frequency == length;
+        for( size_t index{ 0 }; index < matrixSize; index++ )
+        {
+            const auto value = inverse[index] / static_cast<double>( length );
+            m_operatorReal[p_frequency * matrixSize + index] = static_cast<float>( value.real() );
+            m_operatorImaginary[p_frequency * matrixSize + index] = isNyquist ? 0.F : static_cast<float>( value.imag() );
+            if( p_frequency > 0 && !isNyquist )
+            {
+                m_operatorReal[( length - p_frequency ) * matrixSize + index] = static_cast<float>( value.real() );
+                m_operatorImaginary[( length - p_frequency ) * matrixSize + index] = static_cast<float>( -value.imag() );
+            }
+        }
+    } );
+}
+
+void MitsEngine::Perform( const float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, float * p_volumeBuffer ) const
+{
+    if( !this->IsValid() || p_nbRows != m_nbRows )
+    {
+        return;
+    }
+    m_shiftAndAddEngine.Perform( p_projectionsBuffer, p_nbColumns, p_nbRows, p_volumeBuffer );
+    this->Deblur( p_volumeBuffer, p_nbColumns );
+}
+
+void MitsEngine::Deblur( float * p_slicesBuffer, int p_nbColumns ) const
+{
+    static const auto useAvx2 = cpuprojector::DetectSimdLevel() >= cpuprojector::SimdLevel::Avx2;
+    if( !this->IsValid() )
+    {
+        return;
+    }
+    // as in ProjectionsFilter::FilterColumns, column 2 s + 1 of a block is the imaginary part of signal s: W being
+    // Hermitian in k, both columns are processed independently
+    constexpr auto batchSize = FftPlan::batchSize;
+    constexpr auto columnsBlockSize = 2 * batchSize;
+    const auto nbSlices = this->GetNbSlices();
+    const auto length = m_fftPlan.GetLength();
+    const auto matrixSize = static_cast<size_t>( nbSlices ) * nbSlices;
+    const auto sliceStride = static_cast<size_t>( length ) * batchSize;
+    const auto sliceSize = static_cast<size_t>( p_nbColumns ) * m_nbRows;
+    const auto nbBlocks = ( p_nbColumns + columnsBlockSize - 1 ) / columnsBlockSize;
+    const auto blocks = IndexRange{ nbBlocks };
+    std::for_each( std::execution::par, blocks.begin(), blocks.end(), [&]( int p_block ) {
+        // spectra of the block in all the slices, and products of one frequency, reused by the tasks of the thread
+        thread_local std::vector<float> real;
+        thread_local std::vector<float> imaginary;
+        thread_local std::vector<float> productReal;
+        thread_local std::vector<float> productImaginary;
+        real.assign( sliceStride * nbSlices, 0.F );
+        imaginary.assign( sliceStride * nbSlices, 0.F );
+        productReal.resize( static_cast<size_t>( nbSlices ) * batchSize );
+        productImaginary.resize( static_cast<size_t>( nbSlices ) * batchSize );
+
+        const auto firstColumn = p_block * columnsBlockSize;
+        const auto nbBlockColumns = std::min( columnsBlockSize, p_nbColumns - firstColumn );
+        for( auto slice{ 0 }; slice < nbSlices; slice++ )
+        {
+            const auto sliceBuffer = p_slicesBuffer + slice * sliceSize + firstColumn;
+            for( auto row{ 0 }; row < m_nbRows; row++ )
+            {
+                const auto sliceRow = sliceBuffer + static_cast<size_t>( row ) * p_nbColumns;
+                for( auto column{ 0 }; column < nbBlockColumns; column++ )
+                {
+                    ( column % 2 == 0 ? real : imaginary )[slice * sliceStride + row * batchSize + column / 2] = sliceRow[column];
+                }
+            }
+            m_fftPlan.ForwardBatch( real.data() + slice * sliceStride, imaginary.data() + slice * sliceStride );
+        }
+
+        for( auto frequency{ 0 }; frequency < length; frequency++ )
+        {
+            const auto spectraOffset = static_cast<size_t>( frequency ) * batchSize;
+#ifdef TOMO_WITH_X86_SIMD
+            if( useAvx2 )
+            {
+                ApplyOperatorAvx2( m_operatorReal.data() + frequency * matrixSize,
+                                   m_operatorImaginary.data() + frequency * matrixSize,
+                                   nbSlices,
+                                   real.data() + spectraOffset,
+                                   imaginary.data() + spectraOffset,
+                                   sliceStride,
+                                   productReal.data(),
+                                   productImaginary.data() );
+            }
+            else
+#endif
+            {
+                ApplyOperator( m_operatorReal.data() + frequency * matrixSize,
+                               m_operatorImaginary.data() + frequency * matrixSize,
+                               nbSlices,
+                               real.data() + spectraOffset,
+                               imaginary.data() + spectraOffset,
+                               sliceStride,
+                               productReal.data(),
+                               productImaginary.data() );
+            }
+            for( auto slice{ 0 }; slice < nbSlices; slice++ )
+            {
+                std::copy_n( productReal.data() + slice * batchSize, batchSize, real.data() + slice * sliceStride + spectraOffset );
+                std::copy_n( productImaginary.data() + slice * batchSize, batchSize, imaginary.data() + slice * sliceStride + spectraOffset );
+            }
+        }
+
+        // inverse FFT = conj( FFT( conj( . ) ) ) / length, the first conjugation and 1 / length being in ApplyOperator
+        for( auto slice{ 0 }; slice < nbSlices; slice++ )
+        {
+            m_fftPlan.ForwardBatch( real.data() + slice * sliceStride, imaginary.data() + slice * sliceStride );
+            auto sliceBuffer = p_slicesBuffer + slice * sliceSize + firstColumn;
+            for( auto row{ 0 }; row < m_nbRows; row++ )
+            {
+                auto sliceRow = sliceBuffer + static_cast<size_t>( row ) * p_nbColumns;
+                for( auto column{ 0 }; column < nbBlockColumns; column++ )
+                {
+                    const auto index = slice * sliceStride + row * batchSize + column / 2;
+                    sliceRow[column] = column % 2 == 0 ? real[index] : -imaginary[index];
+                }
+            }
+        }
+    } );
+}
+
+MitsEngineCache & MitsEngineCache::Instance()
+{
+    static MitsEngineCache instance;
+    return instance;
+}
+
+std::shared_ptr<MitsEngine> MitsEngineCache::Get( TomoGeometry const * p_tomoGeometry, int p_nbRows, float p_regularization )
+{
+    if( p_tomoGeometry == nullptr )
+    {
+        std::cout << "MitsEngineCache: geometry is nullptr" << std::endl;
+        return nullptr;
+    }
+    // the engine only depends on the Shift-and-Add shifts, cheap to compute
+    const ShiftAndAddEngine shiftAndAddEngine( p_tomoGeometry );
+    if( !shiftAndAddEngine.IsValid() )
+    {
+        return nullptr;
+    }
+
+    const auto isSameEngine = [&]( const std::shared_ptr<MitsEngine> & p_engine ) {
+        return p_engine->GetNbRows() == p_nbRows && p_engine->GetRegularization() == p_regularization
+               && p_engine->GetNbSlices() == shiftAndAddEngine.GetNbSlices()
+               && p_engine->GetShiftAndAddEngine().GetShifts() == shiftAndAddEngine.GetShifts();
+    };
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto engineIterator = std::find_if( m_engines.begin(), m_engines.end(), isSameEngine );
+        if( engineIterator != m_engines.end() )
+        {
+            m_engines.splice( m_engines.begin(), m_engines, engineIterator );
+            return m_engines.front();
+        }
+    }
+
+    // the per frequency inversions are computed without holding the lock
+    auto engine = std::make_shared<MitsEngine>( p_tomoGeometry, p_nbRows, p_regularization );
+    if( !engine->IsValid() )
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock( m_mutex );
+    // the engines are shared: the one inserted by a concurrent call is kept
+    auto engineIterator = std::find_if( m_engines.begin(), m_engines.end(), isSameEngine );
+    if( engineIterator != m_engines.end() )
+    {
+        m_engines.splice( m_engines.begin(), m_engines, engineIterator );
+        return m_engines.front();
+    }
+    m_engines.push_front( engine );
+    while( static_cast<int>( m_engines.size() ) > m_capacity )
+    {
+        m_engines.pop_back();
+    }
+    return engine;
+}
+
+void MitsEngineCache::SetCapacity( int p_capacity )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_capacity = std::max( 0, p_capacity );
+    while( static_cast<int>( m_engines.size() ) > m_capacity )
+    {
+        m_engines.pop_back();
+    }
+}
+
+void MitsEngineCache::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_engines.clear();
+}
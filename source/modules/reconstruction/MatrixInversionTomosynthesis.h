@@ -0,0 +1,67 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/FilteredBackProjection.h"
+#include "modules/reconstruction/ShiftAndAdd.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Matrix Inversion Tomosynthesis (MITS), see Godfrey, Dobbins, "Optimization of the matrix inversion tomosynthesis
+// (MITS) impulse response and modulation transfer function characteristics for chest imaging", Med. Phys. 2006.
+// Shift-and-Add slice s is the sum over the slices z of slice z blurred along y by the mean of the translations
+// shift( s, p ) - shift( z, p ) over the projections p. For each frequency k along y this is a small linear system
+// SAA( k ) = M( k ) X( k ) across the slices, inverted once per geometry with a Tikhonov regularization:
+// W( k ) = ( M^H M + regularization I )^-1 M^H. The slices are then the inverse FFT of W( k ) SAA( k ).
+// Along a frequency the in-focus slice has a weight of 1, so the regularization is relative to 1; the low frequencies,
+// for which all the slices look alike, are shared equally between the slices.
+class MitsEngine
+{
+public:
+    // p_nbRows: number of projections rows (y)
+    MitsEngine( TomoGeometry const * p_tomoGeometry, int p_nbRows, float p_regularization );
+    ~MitsEngine() = default;
+
+    // false if the geometry does not allow a Shift-and-Add reconstruction (the reason is printed)
+    bool IsValid() const { return m_shiftAndAddEngine.IsValid() && !m_operatorReal.empty(); }
+    const ShiftAndAddEngine & GetShiftAndAddEngine() const { return m_shiftAndAddEngine; }
+    int GetNbSlices() const { return m_shiftAndAddEngine.GetNbSlices(); }
+    int GetNbRows() const { return m_nbRows; }
+    float GetRegularization() const { return m_regularization; }
+
+    // Shift-and-Add followed by the inversion, same buffers as ShiftAndAddEngine::Perform
+    void Perform( const float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, float * p_volumeBuffer ) const;
+    // in place inversion of GetNbSlices() Shift-and-Add slices of p_nbColumns x GetNbRows() pixels,
+    // in parallel over the blocks of 2 FftPlan::batchSize columns
+    void Deblur( float * p_slicesBuffer, int p_nbColumns ) const;
+
+private:
+    ShiftAndAddEngine m_shiftAndAddEngine;
+    int m_nbRows;
+    float m_regularization;
+    FftPlan m_fftPlan;
+    // W( k ) / length, row major ( slice, slice ) matrices of the frequencies k of the FFT
+    std::vector<float> m_operatorReal;
+    std::vector<float> m_operatorImaginary;
+};
+
+// Process wide cache of the MITS engines, reused while the sources, slices, rows and regularization are the same
+class MitsEngineCache
+{
+public:
+    static MitsEngineCache & Instance();
+
+    // nullptr (the reason is printed) if the engine cannot be built
+    std::shared_ptr<MitsEngine> Get( TomoGeometry const * p_tomoGeometry, int p_nbRows, float p_regularization );
+    void SetCapacity( int p_capacity );
+    void Clear();
+
+private:
+    MitsEngineCache() = default;
+
+    std::mutex m_mutex;
+    int m_capacity{ 2 };
+    std::list<std::shared_ptr<MitsEngine>> m_engines;    // most recently used first
+};
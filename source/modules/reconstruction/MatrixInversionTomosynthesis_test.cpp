@@ -0,0 +1,186 @@
+#include "commons/Maths.h"
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/MatrixInversionTomosynthesis.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <vector>
+
+constexpr auto nbColumns{ 6 };
+constexpr auto regularization{ 0.001F };
+constexpr double minPlaneCorrelation = 0.99;    // between a recovered plane and the phantom one
+constexpr double maxErrorRatio = 0.6;           // MITS error over the Shift-and-Add one
+constexpr double maxLeakageRatio = 0.5;         // MITS energy in the empty slices over the Shift-and-Add one
+constexpr double crosstalkTolerance = 0.0001;   // relative to the largest deblurred value
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+namespace    // anonymous namespace
+{
+// Phantom made of the first and last slices only: Gabor patterns along y (no zero frequency, which MITS cannot separate
+// between the slices), modulated along x. Rows are fractional so that the Shift-and-Add blur can be sampled exactly
+double PhantomPlane( int p_sliceIndex, int p_nbSlices, int p_column, double p_row, int p_nbRows )
+{
+    if( p_sliceIndex != 0 && p_sliceIndex != p_nbSlices - 1 )
+    {
+        return 0.;
+    }
+    const auto center = p_nbRows / 2. + ( p_sliceIndex == 0 ? -3. : 3. );
+    const auto period = p_sliceIndex == 0 ? 3. : 3.3;
+    const auto offset = p_row - center;
+    return ( 1. + 0.5 * std::sin( 0.3 * p_column + p_sliceIndex ) ) * std::cos( 2. * pi() * offset / period ) * std::exp( -offset * offset / 24.5 );
+}
+
+// sum( x * y ) / sqrt( sum( x^2 ) sum( y^2 ) ) over [p_begin, p_end[
+double Correlation( const std::vector<float> & p_x, const std::vector<float> & p_y, size_t p_begin, size_t p_end )
+{
+    auto xy{ 0. };
+    auto xx{ 0. };
+    auto yy{ 0. };
+    for( auto index{ p_begin }; index < p_end; index++ )
+    {
+        xy += static_cast<double>( p_x[index] ) * p_y[index];
+        xx += static_cast<double>( p_x[index] ) * p_x[index];
+        yy += static_cast<double>( p_y[index] ) * p_y[index];
+    }
+    return xy / std::sqrt( xx * yy );
+}
+
+double SquaredNorm( const std::vector<float> & p_x, size_t p_begin, size_t p_end )
+{
+    auto sum{ 0. };
+    for( auto index{ p_begin }; index < p_end; index++ )
+    {
+        sum += static_cast<double>( p_x[index] ) * p_x[index];
+    }
+    return sum;
+}
+
+double RelativeError( const std::vector<float> & p_x, const std::vector<float> & p_reference )
+{
+    auto error{ 0. };
+    for( auto index{ 0U }; index < p_x.size(); index++ )
+    {
+        error += std::pow( static_cast<double>( p_x[index] ) - p_reference[index], 2 );
+    }
+    return std::sqrt( error / SquaredNorm( p_reference, 0, p_reference.size() ) );
+}
+}    // end of anonymous namespace
+
+TEST( MatrixInversionTomosynthesisTest, TikhonovSolveRecoversPhantomPlanes )
+{
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto nbRows = ProjectorGeometry::FromTomoGeometry( &tomoGeometry ).projectionsDimension.y;
+        MitsEngine engine( &tomoGeometry, nbRows, regularization );
+        ASSERT_TRUE( engine.IsValid() ) << path;
+        const auto & shiftAndAddEngine = engine.GetShiftAndAddEngine();
+        const auto nbSlices = engine.GetNbSlices();
+        const auto sliceSize = static_cast<size_t>( nbColumns ) * nbRows;
+
+        // Shift-and-Add slices of the phantom, as modeled by MITS: slice s is the sum over the slices z of slice z
+        // translated by the mean of shift( s, p ) - shift( z, p )
+        std::vector<float> phantom( sliceSize * nbSlices );
+        std::vector<float> slices( phantom.size() );
+        for( auto sliceIndex{ 0 }; sliceIndex < nbSlices; sliceIndex++ )
+        {
+            for( auto row{ 0 }; row < nbRows; row++ )
+            {
+                for( auto column{ 0 }; column < nbColumns; column++ )
+                {
+                    auto blurred{ 0. };
+                    for( auto projectionIndex{ 0 }; projectionIndex < shiftAndAddEngine.GetNbProjections(); projectionIndex++ )
+                    {
+                        for( auto otherSliceIndex{ 0 }; otherSliceIndex < nbSlices; otherSliceIndex++ )
+                        {
+                            const auto translation = shiftAndAddEngine.GetShift( sliceIndex, projectionIndex ) - shiftAndAddEngine.GetShift( otherSliceIndex, projectionIndex );
+                            blurred += PhantomPlane( otherSliceIndex, nbSlices, column, row + translation, nbRows );
+                        }
+                    }
+                    const auto index = sliceIndex * sliceSize + row * nbColumns + column;
+                    phantom[index] = static_cast<float>( PhantomPlane( sliceIndex, nbSlices, column, row, nbRows ) );
+                    slices[index] = static_cast<float>( blurred / shiftAndAddEngine.GetNbProjections() );
+                }
+            }
+        }
+        const auto shiftAndAddSlices = slices;
+        engine.Deblur( slices.data(), nbColumns );
+
+        // the planes are recovered in their slices, the blur they leave in the other slices is reduced
+        for( auto sliceIndex : { 0, nbSlices - 1 } )
+        {
+            EXPECT_GT( Correlation( slices, phantom, sliceIndex * sliceSize, ( sliceIndex + 1 ) * sliceSize ), minPlaneCorrelation ) << path << " slice " << sliceIndex;
+        }
+        EXPECT_LT( RelativeError( slices, phantom ), maxErrorRatio * RelativeError( shiftAndAddSlices, phantom ) ) << path;
+        EXPECT_LT( SquaredNorm( slices, sliceSize, ( nbSlices - 1 ) * sliceSize ), maxLeakageRatio * SquaredNorm( shiftAndAddSlices, sliceSize, ( nbSlices - 1 ) * sliceSize ) ) << path;
+    }
+}
+
+TEST( MatrixInversionTomosynthesisTest, DeblurredSlicesAreReal )
+{
+    // two columns are the real and imaginary parts of one complex signal: with an operator mirrored as W( -k ) = conj( W( k ) ),
+    // the result of a column does not leak into its neighbour and does not depend on its position in the pair
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        // the sources sweeps of the resources are symmetric, which makes W( k ) real: the last projection is removed so that
+        // the imaginary parts of the operator, and their mirroring, are exercised
+        TomoGeometry tomoGeometry( path.string() );
+        const std::vector<int> lastProjection{ tomoGeometry.nbProjections() - 1 };
+        tomoGeometry.GetTable()->RemoveSource( lastProjection );
+        tomoGeometry.GetProjections()->RemoveProjection( lastProjection );
+        tomoGeometry.GetProjectionsRois()->RemoveProjection( lastProjection );
+        const auto nbRows = ProjectorGeometry::FromTomoGeometry( &tomoGeometry ).projectionsDimension.y;
+        MitsEngine engine( &tomoGeometry, nbRows, regularization );
+        ASSERT_TRUE( engine.IsValid() ) << path;
+        const auto nbSlices = engine.GetNbSlices();
+        const auto sliceSize = static_cast<size_t>( nbColumns ) * nbRows;
+
+        const auto column = RandomBuffer( nbRows * nbSlices, 3U );
+        std::vector<float> evenSlices( sliceSize * nbSlices, 0.F );
+        std::vector<float> oddSlices( evenSlices.size(), 0.F );
+        for( auto index{ 0 }; index < nbRows * nbSlices; index++ )
+        {
+            evenSlices[index * nbColumns] = column[index];
+            oddSlices[index * nbColumns + 1] = column[index];
+        }
+        engine.Deblur( evenSlices.data(), nbColumns );
+        engine.Deblur( oddSlices.data(), nbColumns );
+
+        const auto maxValue = std::fabs( *std::max_element( evenSlices.cbegin(), evenSlices.cend(), []( float p_left, float p_right ) { return std::fabs( p_left ) < std::fabs( p_right ); } ) );
+        ASSERT_GT( maxValue, 0.F ) << path;
+        for( auto index{ 0 }; index < nbRows * nbSlices; index++ )
+        {
+            ASSERT_NEAR( evenSlices[index * nbColumns + 1], 0.F, crosstalkTolerance * maxValue ) << path;
+            ASSERT_NEAR( oddSlices[index * nbColumns], 0.F, crosstalkTolerance * maxValue ) << path;
+            ASSERT_NEAR( oddSlices[index * nbColumns + 1], evenSlices[index * nbColumns], crosstalkTolerance * maxValue ) << path;
+        }
+    }
+}
+
+TEST( MatrixInversionTomosynthesisTest, ConcurrentCacheRequestsShareTheEngine )
+{
+    const auto path = GeometriesFilesPaths().front();
+    TomoGeometry tomoGeometry( path.string() );
+    const auto nbRows = ProjectorGeometry::FromTomoGeometry( &tomoGeometry ).projectionsDimension.y;
+    auto & cache = MitsEngineCache::Instance();
+    cache.Clear();
+
+    // both requests may build an engine, the first one inserted is returned to both
+    auto request = [&]() { return cache.Get( &tomoGeometry, nbRows, regularization ); };
+    auto firstEngine = std::async( std::launch::async, request );
+    auto secondEngine = std::async( std::launch::async, request );
+    const auto engine = firstEngine.get();
+    ASSERT_NE( engine, nullptr ) << path;
+    EXPECT_EQ( secondEngine.get(), engine ) << path;
+    EXPECT_EQ( cache.Get( &tomoGeometry, nbRows, regularization ), engine ) << path;
+    EXPECT_NE( cache.Get( &tomoGeometry, nbRows, 2.F * regularization ), engine ) << path;
+    cache.Clear();
+}
@@ -0,0 +1,89 @@
+#include "modules/reconstruction/Multiresolution.h"
+
+#include "modules/geometry/IndexedIterator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+
+namespace    // anonymous namespace
+{
+// source voxel below the center of destination voxel p_index along an axis, and the weight of the next one
+struct AxisSample
+{
+    int index;
+    int nextIndex;
+    float nextWeight;
+};
+
+std::vector<AxisSample> AxisSamples( int p_sourceSize, int p_destinationSize )
+{
+    std::vector<AxisSample> samples( p_destinationSize );
+    const auto ratio = static_cast<double>( p_sourceSize ) / p_destinationSize;
+    for( auto index{ 0 }; index < p_destinationSize; index++ )
+    {
+        // voxels centers of both grids: ( i + 0.5 ) spacing from the same corner
+        const auto position = std::clamp( ( index + 0.5 ) * ratio - 0.5, 0., static_cast<double>( p_sourceSize - 1 ) );
+        const auto sourceIndex = static_cast<int>( std::floor( position ) );
+        samples[index] = { sourceIndex, std::min( sourceIndex + 1, p_sourceSize - 1 ), static_cast<float>( position - sourceIndex ) };
+    }
+    return samples;
+}
+}    // end of anonymous namespace
+
+namespace multiresolution
+{
+Int3 CoarseDimension( const Int3 & p_dimension, int p_factor )
+{
+    const auto factor = std::max( 1, p_factor );
+    return { std::max( 1, ( p_dimension.x + factor - 1 ) / factor ), std::max( 1, ( p_dimension.y + factor - 1 ) / factor ), std::max( 1, ( p_dimension.z + factor - 1 ) / factor ) };
+}
+
+void ResampleVolume( const float * p_sourceBuffer, const Int3 & p_sourceDimension, float * p_destinationBuffer, const Int3 & p_destinationDimension )
+{
+    const auto xSamples = AxisSamples( p_sourceDimension.x, p_destinationDimension.x );
+    const auto ySamples = AxisSamples( p_sourceDimension.y, p_destinationDimension.y );
+    const auto zSamples = AxisSamples( p_sourceDimension.z, p_destinationDimension.z );
+    const auto sourceSliceSize = static_cast<size_t>( p_sourceDimension.x ) * p_sourceDimension.y;
+    const auto destinationSliceSize = static_cast<size_t>( p_destinationDimension.x ) * p_destinationDimension.y;
+
+    const auto slices = IndexRange{ p_destinationDimension.z };
+    std::for_each( std::execution::par, slices.begin(), slices.end(), [&]( int p_slice ) {
+        // source slices blended once, then bilinear interpolation in the blended slice
+        thread_local std::vector<float> blendedSlice;
+        blendedSlice.resize( sourceSliceSize );
+        const auto & zSample = zSamples[p_slice];
+        const auto firstSlice = p_sourceBuffer + zSample.index * sourceSliceSize;
+        const auto secondSlice = p_sourceBuffer + zSample.nextIndex * sourceSliceSize;
+        for( size_t index{ 0 }; index < sourceSliceSize; index++ )
+        {
+            blendedSlice[index] = firstSlice[index] + zSample.nextWeight * ( secondSlice[index] - firstSlice[index] );
+        }
+
+        auto destinationSlice = p_destinationBuffer + p_slice * destinationSliceSize;
+        for( auto row{ 0 }; row < p_destinationDimension.y; row++ )
+        {
+            const auto & ySample = ySamples[row];
+            const auto firstRow = blendedSlice.data() + static_cast<size_t>( ySample.index ) * p_sourceDimension.x;
+            const auto secondRow = blendedSlice.data() + static_cast<size_t>( ySample.nextIndex ) * p_sourceDimension.x;
+            auto destinationRow = destinationSlice + static_cast<size_t>( row ) * p_destinationDimension.x;
+            for( auto column{ 0 }; column < p_destinationDimension.x; column++ )
+            {
+                const auto & xSample = xSamples[column];
+                const auto first = firstRow[xSample.index] + xSample.nextWeight * ( firstRow[xSample.nextIndex] - firstRow[xSample.index] );
+                const auto second = secondRow[xSample.index] + xSample.nextWeight * ( secondRow[xSample.nextIndex] - secondRow[xSample.index] );
+                destinationRow[column] = first + ySample.nextWeight * ( second - first );
+            }
+        }
+    } );
+}
+
+TomoGeometry CoarseGeometry( const TomoGeometry & p_tomoGeometry, int p_factor )
+{
+    TomoGeometry coarseGeometry( p_tomoGeometry );
+    const auto size = coarseGeometry.volumeSize3D();
+    const auto coarseDimension = CoarseDimension( { size.x, size.y, size.z }, p_factor );
+    coarseGeometry.GetVolume()->SetSizeAndUpdateVoxelSpacing( Size3D( coarseDimension.x, coarseDimension.y, coarseDimension.z ) );
+    return coarseGeometry;
+}
+}    // namespace multiresolution
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+// Level of a coarse-to-fine reconstruction: iterations run on the volume grid downsampled by downsamplingFactor along
+// each axis (same box), the result being upsampled as the initial volume of the next level
+struct MultiresolutionLevel
+{
+    int downsamplingFactor{ 1 };
+    int iterationNumber{ 1 };
+};
+
+namespace multiresolution
+{
+// dimension of a grid downsampled by p_factor, with at least one voxel along each axis
+Int3 CoarseDimension( const Int3 & p_dimension, int p_factor );
+
+// Trilinear interpolation of p_sourceBuffer at the voxels centers of a grid covering the same box, the values out of
+// the source centers being the ones of the border voxels. Slices are computed in parallel
+void ResampleVolume( const float * p_sourceBuffer, const Int3 & p_sourceDimension, float * p_destinationBuffer, const Int3 & p_destinationDimension );
+
+// Copy of p_tomoGeometry whose volume grid is downsampled by p_factor over the same box: the reconstructors given the
+// copy work on the coarse grid, p_tomoGeometry being left unchanged
+TomoGeometry CoarseGeometry( const TomoGeometry & p_tomoGeometry, int p_factor );
+}    // namespace multiresolution
@@ -0,0 +1,65 @@
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/Multiresolution.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "test_utils/TestInitializer.h"
+
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( MultiresolutionTest, MultiresolutionResamplesLinearVolumesAndCopiesCoarseGeometry )
+{
+    // a linear function of the voxels centers is reproduced by the trilinear upsampling, away from the borders
+    const Int3 coarseDimension{ 6, 5, 4 };
+    const Int3 fineDimension{ 12, 10, 8 };
+    const auto linear = []( double p_x, double p_y, double p_z ) { return static_cast<float>( 1. + 0.5 * p_x - 0.25 * p_y + 2. * p_z ); };
+    std::vector<float> coarseVolume( coarseDimension.x * coarseDimension.y * coarseDimension.z );
+    for( auto z{ 0 }; z < coarseDimension.z; z++ )
+    {
+        for( auto y{ 0 }; y < coarseDimension.y; y++ )
+        {
+            for( auto x{ 0 }; x < coarseDimension.x; x++ )
+            {
+                // centers in units of the box size
+                coarseVolume[( z * coarseDimension.y + y ) * coarseDimension.x + x] = linear( ( x + 0.5 ) / coarseDimension.x, ( y + 0.5 ) / coarseDimension.y, ( z + 0.5 ) / coarseDimension.z );
+            }
+        }
+    }
+    std::vector<float> fineVolume( fineDimension.x * fineDimension.y * fineDimension.z );
+    multiresolution::ResampleVolume( coarseVolume.data(), coarseDimension, fineVolume.data(), fineDimension );
+    for( auto z{ 1 }; z < fineDimension.z - 1; z++ )
+    {
+        for( auto y{ 1 }; y < fineDimension.y - 1; y++ )
+        {
+            for( auto x{ 1 }; x < fineDimension.x - 1; x++ )
+            {
+                ASSERT_NEAR( fineVolume[( z * fineDimension.y + y ) * fineDimension.x + x], linear( ( x + 0.5 ) / fineDimension.x, ( y + 0.5 ) / fineDimension.y, ( z + 0.5 ) / fineDimension.z ), 1e-5 );
+            }
+        }
+    }
+
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto size = tomoGeometry.volumeSize3D();
+        const auto spacing = tomoGeometry.volumeVoxelSpacing();
+        const auto coarseGeometry = multiresolution::CoarseGeometry( tomoGeometry, 2 );
+        const auto coarseSize = coarseGeometry.volumeSize3D();
+        const auto expectedSize = multiresolution::CoarseDimension( { size.x, size.y, size.z }, 2 );
+        EXPECT_EQ( coarseSize.x, expectedSize.x ) << path;
+        EXPECT_EQ( coarseSize.y, expectedSize.y ) << path;
+        EXPECT_EQ( coarseSize.z, expectedSize.z ) << path;
+        EXPECT_NEAR( coarseGeometry.volumeWSize3D().x, spacing.x * size.x, 1e-4 ) << path;
+        EXPECT_EQ( coarseGeometry.nbProjections(), tomoGeometry.nbProjections() ) << path;
+        EXPECT_TRUE( ProjectorPlan( &coarseGeometry, ProjectorBackend::CpuMatched ).IsValid() ) << path;
+
+        // the original geometry, possibly shared with other reconstructions, keeps its grid
+        EXPECT_EQ( tomoGeometry.volumeSize3D().x, size.x ) << path;
+        EXPECT_EQ( tomoGeometry.volumeSize3D().z, size.z ) << path;
+        EXPECT_FLOAT_EQ( tomoGeometry.volumeVoxelSpacing().z, spacing.z ) << path;
+    }
+}
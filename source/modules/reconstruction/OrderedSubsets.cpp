@@ -0,0 +1,178 @@
+#include "modules/reconstruction/OrderedSubsets.h"
+
+#include <algorithm>
+#include <execution>
+#include <iostream>
+
+namespace    // anonymous namespace
+{
+constexpr auto normalizationFloatTolerance = 0.000001F;
+
+// p_value with its p_nbBits lowest bits reversed
+int ReverseBits( int p_value, int p_nbBits )
+{
+    auto reversed{ 0 };
+    for( auto bit{ 0 }; bit < p_nbBits; bit++ )
+    {
+        reversed = ( reversed << 1 ) | ( ( p_value >> bit ) & 1 );
+    }
+    return reversed;
+}
+
+void InvertSums( std::vector<float> & p_sums )
+{
+    std::transform( std::execution::par_unseq, p_sums.cbegin(), p_sums.cend(), p_sums.begin(), []( float p_sum ) {
+        return p_sum > normalizationFloatTolerance ? 1.F / p_sum : 0.F;
+    } );
+}
+}    // end of anonymous namespace
+
+std::vector<ProjectionsSubset> MakeOrderedSubsets( int p_nbProjections, int p_nbSubsets, SubsetsOrdering p_ordering )
+{
+    const auto nbSubsets = std::clamp( p_nbSubsets, 1, std::max( 1, p_nbProjections ) );
+    switch( p_ordering )
+    {
+        case SubsetsOrdering::Contiguous:
+        {
+            std::vector<ProjectionsSubset> subsets;
+            for( auto subsetIndex{ 0 }; subsetIndex < nbSubsets; subsetIndex++ )
+            {
+                const auto first = subsetIndex * p_nbProjections / nbSubsets;
+                const auto end = ( subsetIndex + 1 ) * p_nbProjections / nbSubsets;
+                subsets.push_back( projectionssubset::Contiguous( first, end - first ) );
+            }
+            return subsets;
+        }
+        case SubsetsOrdering::InterleavedBitReversed:
+        {
+            auto interleavedSubsets = projectionssubset::Interleaved( p_nbProjections, nbSubsets );
+            auto nbBits{ 0 };
+            while( ( 1 << nbBits ) < nbSubsets )
+            {
+                nbBits++;
+            }
+            std::vector<ProjectionsSubset> subsets;
+            for( auto code{ 0 }; code < ( 1 << nbBits ); code++ )
+            {
+                const auto subsetIndex = ReverseBits( code, nbBits );
+                if( subsetIndex < nbSubsets )
+                {
+                    subsets.push_back( std::move( interleavedSubsets[subsetIndex] ) );
+                }
+            }
+            return subsets;
+        }
+        case SubsetsOrdering::Interleaved:
+        default:
+            return projectionssubset::Interleaved( p_nbProjections, nbSubsets );
+    }
+}
+
+OrderedSubsetsProjector::OrderedSubsetsProjector( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, int p_nbSubsets, SubsetsOrdering p_ordering )
+  : m_backend{ p_backend }
+  , m_ordering{ p_ordering }
+{
+    if( p_tomoGeometry == nullptr )
+    {
+        std::cout << "OrderedSubsetsProjector: geometry is nullptr" << std::endl;
+        return;
+    }
+    m_geometry = ProjectorGeometry::FromTomoGeometry( p_tomoGeometry );
+    for( const auto & subset : MakeOrderedSubsets( m_geometry.projectionsDimension.z, p_nbSubsets, p_ordering ) )
+    {
+        m_plans.push_back( std::make_unique<ProjectorPlan>( p_tomoGeometry, p_backend, subset ) );
+        if( !m_plans.back()->IsValid() )
+        {
+            std::cout << "OrderedSubsetsProjector: invalid subset plan" << std::endl;
+            return;
+        }
+    }
+
+    // rays sums: the subsets cover the whole projections stack
+    const std::vector<float> volumeOfOnes( m_geometry.GetVolumeVoxelsNumber(), 1.F );
+    m_raysInverseSums.resize( m_geometry.GetProjectionsPixelsNumber() );
+    for( auto & plan : m_plans )
+    {
+        plan->Project( volumeOfOnes.data(), m_raysInverseSums.data() );
+    }
+    InvertSums( m_raysInverseSums );
+
+    const std::vector<float> projectionsOfOnes( m_geometry.GetProjectionsPixelsNumber(), 1.F );
+    m_voxelsInverseSums.resize( m_plans.size() );
+    for( auto subsetIndex{ 0U }; subsetIndex < m_plans.size(); subsetIndex++ )
+    {
+        m_voxelsInverseSums[subsetIndex].resize( m_geometry.GetVolumeVoxelsNumber() );
+        m_plans[subsetIndex]->BackProject( projectionsOfOnes.data(), m_voxelsInverseSums[subsetIndex].data() );
+        InvertSums( m_voxelsInverseSums[subsetIndex] );
+    }
+    m_isValid = true;
+}
+
+vtkSmartPointer<vtkImageData> OrderedSubsetsProjector::CreateProjectionsImage() const
+{
+    return m_plans.front()->CreateProjectionsImage();
+}
+
+vtkSmartPointer<vtkImageData> OrderedSubsetsProjector::CreateVolumeImage() const
+{
+    return m_plans.front()->CreateVolumeImage();
+}
+
+OrderedSubsetsProjectorCache & OrderedSubsetsProjectorCache::Instance()
+{
+    static OrderedSubsetsProjectorCache instance;
+    return instance;
+}
+
+std::shared_ptr<OrderedSubsetsProjector> OrderedSubsetsProjectorCache::Get( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, int p_nbSubsets, SubsetsOrdering p_ordering )
+{
+    if( p_tomoGeometry == nullptr )
+    {
+        std::cout << "OrderedSubsetsProjectorCache: geometry is nullptr" << std::endl;
+        return nullptr;
+    }
+    const auto geometry = ProjectorGeometry::FromTomoGeometry( p_tomoGeometry );
+    {
+        // entries whose projector is held outside of the cache are lent to a running reconstruction
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto entryIterator = std::find_if( m_entries.begin(), m_entries.end(), [&]( const Entry & p_entry ) {
+            return p_entry.projector.use_count() == 1 && p_entry.nbSubsets == p_nbSubsets && p_entry.ordering == p_ordering
+                   && p_entry.projector->GetBackend() == p_backend && p_entry.projector->GetGeometry().IsSameAs( geometry );
+        } );
+        if( entryIterator != m_entries.end() )
+        {
+            m_entries.splice( m_entries.begin(), m_entries, entryIterator );
+            return m_entries.front().projector;
+        }
+    }
+
+    // the nbSubsets + 1 normalizations are computed without holding the lock
+    auto projector = std::make_shared<OrderedSubsetsProjector>( p_tomoGeometry, p_backend, p_nbSubsets, p_ordering );
+    if( !projector->IsValid() )
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_entries.push_front( { p_nbSubsets, p_ordering, projector } );
+    while( static_cast<int>( m_entries.size() ) > m_capacity )
+    {
+        m_entries.pop_back();
+    }
+    return projector;
+}
+
+void OrderedSubsetsProjectorCache::SetCapacity( int p_capacity )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_capacity = std::max( 0, p_capacity );
+    while( static_cast<int>( m_entries.size() ) > m_capacity )
+    {
+        m_entries.pop_back();
+    }
+}
+
+void OrderedSubsetsProjectorCache::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_entries.clear();
+}
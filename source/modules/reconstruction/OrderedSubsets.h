@@ -0,0 +1,88 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectionsSubset.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+enum class SubsetsOrdering
+{
+    Interleaved = 0,           // subset s = { s, s + n, s + 2n, ... }, visited in index order
+    InterleavedBitReversed,    // same subsets, visited in bit-reversed index order: consecutive subsets are far apart in angle
+    Contiguous                 // subset s = s-th block of consecutive projections, visited in index order
+};
+
+// p_nbSubsets subsets covering all the projections once, in visiting order
+std::vector<ProjectionsSubset> MakeOrderedSubsets( int p_nbProjections, int p_nbSubsets, SubsetsOrdering p_ordering );
+
+// Projector plans of the ordered subsets of a geometry, with the normalizations of the ordered-subsets algorithms.
+// Everything is computed once in the constructor, so that one instance can serve several successive reconstructions of
+// the same geometry (the plans work buffers forbid concurrent ones):
+//  - rays sums: projection of a volume of ones (A 1), for the whole projections stack
+//  - voxels sums of each subset: back projection of the subset projections of ones (A_s^T 1, the subset sensitivity image)
+// Both are stored inverted (0 where the sum vanishes), ready for the fused updates.
+class OrderedSubsetsProjector
+{
+public:
+    OrderedSubsetsProjector( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, int p_nbSubsets, SubsetsOrdering p_ordering );
+    ~OrderedSubsetsProjector() = default;
+
+    bool IsValid() const { return m_isValid; }
+    int GetNbSubsets() const { return static_cast<int>( m_plans.size() ); }
+    const ProjectionsSubset & GetSubset( int p_subsetIndex ) const { return m_plans[p_subsetIndex]->GetProjectionsSubset(); }
+    ProjectorPlan & GetPlan( int p_subsetIndex ) { return *m_plans[p_subsetIndex]; }
+    const ProjectorGeometry & GetGeometry() const { return m_geometry; }
+    ProjectorBackend GetBackend() const { return m_backend; }
+    SubsetsOrdering GetOrdering() const { return m_ordering; }
+
+    // full projections stack and volume images, to be used with the plans
+    vtkSmartPointer<vtkImageData> CreateProjectionsImage() const;
+    vtkSmartPointer<vtkImageData> CreateVolumeImage() const;
+
+    const std::vector<float> & GetRaysInverseSums() const { return m_raysInverseSums; }
+    const std::vector<float> & GetVoxelsInverseSums( int p_subsetIndex ) const { return m_voxelsInverseSums[p_subsetIndex]; }
+
+private:
+    bool m_isValid{ false };
+    ProjectorBackend m_backend;
+    SubsetsOrdering m_ordering;
+    ProjectorGeometry m_geometry;    // full geometry
+    std::vector<std::unique_ptr<ProjectorPlan>> m_plans;
+    std::vector<float> m_raysInverseSums;
+    std::vector<std::vector<float>> m_voxelsInverseSums;
+};
+
+// Process-wide cache of the ordered subsets projectors, keyed by geometry (compared by value), backend, number of
+// subsets and ordering: the normalizations (sensitivity images) of a geometry are computed once for all its
+// reconstructions. Each entry holds nbSubsets + 1 volumes, so the least recently used ones are dropped beyond the capacity.
+// The plans work buffers are not shareable, so a cached projector is lent to one reconstruction at a time: it is lent
+// until the returned pointer (and all its copies) are released, and a concurrent reconstruction of the same geometry
+// gets a projector of its own. Projectors are built outside of the cache lock.
+class OrderedSubsetsProjectorCache
+{
+public:
+    static OrderedSubsetsProjectorCache & Instance();
+
+    // projector for the exclusive use of the caller; nullptr (the reason is printed) if it cannot be built
+    std::shared_ptr<OrderedSubsetsProjector> Get( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, int p_nbSubsets, SubsetsOrdering p_ordering );
+    void SetCapacity( int p_capacity );
+    void Clear();
+
+private:
+    OrderedSubsetsProjectorCache() = default;
+
+    struct Entry
+    {
+        int nbSubsets;    // as requested
+        SubsetsOrdering ordering;
+        std::shared_ptr<OrderedSubsetsProjector> projector;
+    };
+
+    std::mutex m_mutex;
+    int m_capacity{ 2 };
+    std::list<Entry> m_entries;    // most recently used first
+};
@@ -0,0 +1,309 @@
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/OrderedSubsets.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "modules/reconstruction/Reconstructors.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+constexpr auto convergenceNbSubsets{ 4 };
+constexpr double maxRelativeResidual = 0.0075;    // relative projections residual after 16 iterations
+constexpr double minResidualDecrease = 1.5;      // residual after 1 iteration over residual after 16 iterations
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+namespace    // anonymous namespace
+{
+// Projections of the smooth phantom of the geometry, by the plan used to reconstruct it
+ImageDataPtr PhantomProjections( ProjectorPlan & p_plan )
+{
+    const auto phantom = SmoothVolume( p_plan.GetGeometry() );
+    auto projections = p_plan.CreateProjectionsImage();
+    p_plan.Project( phantom.data(), static_cast<float *>( projections->GetScalarPointer() ) );
+    return projections;
+}
+
+// || b - A x || / || b ||
+double RelativeResidual( ProjectorPlan & p_plan, ImageDataPtr p_projections, ImageDataPtr p_volume )
+{
+    const auto & geometry = p_plan.GetGeometry();
+    std::vector<float> volumeProjections( geometry.GetProjectionsPixelsNumber() );
+    p_plan.Project( static_cast<const float *>( p_volume->GetScalarPointer() ), volumeProjections.data() );
+    const auto * projectionsBuffer = static_cast<const float *>( p_projections->GetScalarPointer() );
+    auto residual{ 0. };
+    auto norm{ 0. };
+    for( auto index{ 0U }; index < volumeProjections.size(); index++ )
+    {
+        residual += std::pow( static_cast<double>( projectionsBuffer[index] ) - volumeProjections[index], 2 );
+        norm += std::pow( static_cast<double>( projectionsBuffer[index] ), 2 );
+    }
+    return std::sqrt( residual / norm );
+}
+
+// Relative residuals of a reconstruction of the phantom projections after 1, 2, 4, ... p_maxIterationNumber iterations
+template <typename Reconstructor>
+std::vector<double> ResidualsByIterationNumber( ProjectorPlan & p_plan, int p_maxIterationNumber, Reconstructor p_reconstructor )
+{
+    const auto projections = PhantomProjections( p_plan );
+    std::vector<double> residuals;
+    for( auto iterationNumber{ 1 }; iterationNumber <= p_maxIterationNumber; iterationNumber *= 2 )
+    {
+        auto volume = p_reconstructor( projections, iterationNumber );
+        if( volume.has_error() )
+        {
+            return {};
+        }
+        residuals.push_back( RelativeResidual( p_plan, projections, volume.value() ) );
+    }
+    return residuals;
+}
+}    // end of anonymous namespace
+
+TEST( OrderedSubsetsTest, OrderedSubsetsCoverProjectionsWithCachedSums )
+{
+    // bit-reversed visiting order of 4 interleaved subsets
+    const auto bitReversedSubsets = MakeOrderedSubsets( 8, 4, SubsetsOrdering::InterleavedBitReversed );
+    ASSERT_EQ( bitReversedSubsets.size(), 4U );
+    EXPECT_EQ( bitReversedSubsets[1], projectionssubset::Strided( 2, 4, 8 ) );
+    EXPECT_EQ( bitReversedSubsets[2], projectionssubset::Strided( 1, 4, 8 ) );
+
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        for( auto ordering : { SubsetsOrdering::Interleaved, SubsetsOrdering::InterleavedBitReversed, SubsetsOrdering::Contiguous } )
+        {
+            OrderedSubsetsProjector orderedSubsetsProjector( &tomoGeometry, ProjectorBackend::CpuMatched, 3, ordering );
+            ASSERT_TRUE( orderedSubsetsProjector.IsValid() ) << path;
+            const auto & geometry = orderedSubsetsProjector.GetGeometry();
+            std::vector<int> coverage( geometry.projectionsDimension.z, 0 );
+            for( auto subsetIndex{ 0 }; subsetIndex < orderedSubsetsProjector.GetNbSubsets(); subsetIndex++ )
+            {
+                for( auto projectionIndex : orderedSubsetsProjector.GetSubset( subsetIndex ) )
+                {
+                    coverage[projectionIndex]++;
+                }
+            }
+            EXPECT_TRUE( std::all_of( coverage.cbegin(), coverage.cend(), []( int p_count ) { return p_count == 1; } ) ) << path;
+
+            // cached sums are the inverses of the full projection and of the subsets back projections of ones
+            ProjectorPlan fullPlan( &tomoGeometry, ProjectorBackend::CpuMatched );
+            const std::vector<float> volumeOfOnes( geometry.GetVolumeVoxelsNumber(), 1.F );
+            std::vector<float> raysSums( geometry.GetProjectionsPixelsNumber() );
+            fullPlan.Project( volumeOfOnes.data(), raysSums.data() );
+            const auto & raysInverseSums = orderedSubsetsProjector.GetRaysInverseSums();
+            for( auto index{ 0U }; index < raysSums.size(); index++ )
+            {
+                ASSERT_NEAR( raysInverseSums[index] * raysSums[index], raysInverseSums[index] == 0.F ? 0.F : 1.F, 0.0001 ) << path;
+            }
+            const std::vector<float> projectionsOfOnes( geometry.GetProjectionsPixelsNumber(), 1.F );
+            std::vector<float> voxelsSums( geometry.GetVolumeVoxelsNumber() );
+            orderedSubsetsProjector.GetPlan( 0 ).BackProject( projectionsOfOnes.data(), voxelsSums.data() );
+            const auto & voxelsInverseSums = orderedSubsetsProjector.GetVoxelsInverseSums( 0 );
+            for( auto index{ 0U }; index < voxelsSums.size(); index++ )
+            {
+                ASSERT_NEAR( voxelsInverseSums[index] * voxelsSums[index], voxelsInverseSums[index] == 0.F ? 0.F : 1.F, 0.0001 ) << path;
+            }
+        }
+    }
+}
+
+TEST( OrderedSubsetsTest, OrderedSubsetsCacheReusesEqualGeometries )
+{
+    const auto paths = GeometriesFilesPaths();
+    ASSERT_FALSE( paths.empty() );
+    auto & cache = OrderedSubsetsProjectorCache::Instance();
+    cache.Clear();
+    cache.SetCapacity( 2 );
+
+    // two geometries read from the same file are equal: once released, a projector is reused
+    TomoGeometry tomoGeometry( paths.front().string() );
+    TomoGeometry sameTomoGeometry( paths.front().string() );
+    auto projector = cache.Get( &tomoGeometry, ProjectorBackend::CpuMatched, 2, SubsetsOrdering::Interleaved );
+    ASSERT_NE( projector, nullptr );
+    std::weak_ptr<OrderedSubsetsProjector> cachedProjector = projector;
+    projector.reset();
+    projector = cache.Get( &sameTomoGeometry, ProjectorBackend::CpuMatched, 2, SubsetsOrdering::Interleaved );
+    EXPECT_EQ( projector, cachedProjector.lock() );
+
+    // a projector in use is not lent to a second reconstruction
+    auto concurrentProjector = cache.Get( &tomoGeometry, ProjectorBackend::CpuMatched, 2, SubsetsOrdering::Interleaved );
+    ASSERT_NE( concurrentProjector, nullptr );
+    EXPECT_NE( concurrentProjector, projector );
+    concurrentProjector.reset();
+    projector.reset();
+
+    // least recently used entry is dropped beyond the capacity
+    EXPECT_NE( cache.Get( &tomoGeometry, ProjectorBackend::CpuMatched, 3, SubsetsOrdering::Interleaved ), nullptr );
+    EXPECT_TRUE( cachedProjector.expired() );
+    cache.Clear();
+}
+
+TEST( OrderedSubsetsTest, OSSARTConvergesOnPhantom )
+{
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        ProjectorPlan plan( &tomoGeometry, ProjectorBackend::CpuMatched );
+        OrderedSubsetsProjector orderedSubsetsProjector( &tomoGeometry, ProjectorBackend::CpuMatched, convergenceNbSubsets, SubsetsOrdering::InterleavedBitReversed );
+        ASSERT_TRUE( orderedSubsetsProjector.IsValid() ) << path;
+
+        const auto residuals = ResidualsByIterationNumber( plan, 16, [&]( ImageDataPtr p_projections, int p_iterationNumber ) {
+            return recons::OSSART( orderedSubsetsProjector, p_projections, p_iterationNumber, 1.F, std::nullopt, std::nullopt );
+        } );
+        ASSERT_FALSE( residuals.empty() ) << path;
+        EXPECT_TRUE( std::is_sorted( residuals.crbegin(), residuals.crend() ) ) << path;
+        EXPECT_LT( residuals.back(), maxRelativeResidual ) << path;
+        EXPECT_GT( residuals.front(), minResidualDecrease * residuals.back() ) << path;
+    }
+}
+
+TEST( OrderedSubsetsTest, OSEMConvergesOnPhantom )
+{
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        ProjectorPlan plan( &tomoGeometry, ProjectorBackend::CpuMatched );
+        OrderedSubsetsProjector orderedSubsetsProjector( &tomoGeometry, ProjectorBackend::CpuMatched, convergenceNbSubsets, SubsetsOrdering::InterleavedBitReversed );
+        ASSERT_TRUE( orderedSubsetsProjector.IsValid() ) << path;
+
+        const auto residuals = ResidualsByIterationNumber( plan, 16, [&]( ImageDataPtr p_projections, int p_iterationNumber ) {
+            return recons::OSEM( orderedSubsetsProjector, p_projections, p_iterationNumber, 1.F, std::nullopt, std::nullopt );
+        } );
+        ASSERT_FALSE( residuals.empty() ) << path;
+        EXPECT_TRUE( std::is_sorted( residuals.crbegin(), residuals.crend() ) ) << path;
+        EXPECT_LT( residuals.back(), maxRelativeResidual ) << path;
+        EXPECT_GT( residuals.front(), minResidualDecrease * residuals.back() ) << path;
+    }
+}
+
+TEST( OrderedSubsetsTest, OrderedSubsetsReconstructionsStopAtTolerance )
+{
+    // a first run records the metrics of all its iterations; a second run with the relative residual of its fourth
+    // iteration as tolerance stops after that iteration
+    const auto paths = GeometriesFilesPaths();
+    ASSERT_FALSE( paths.empty() );
+    TomoGeometry tomoGeometry( paths.front().string() );
+    ProjectorPlan plan( &tomoGeometry, ProjectorBackend::CpuMatched );
+    OrderedSubsetsProjector orderedSubsetsProjector( &tomoGeometry, ProjectorBackend::CpuMatched, convergenceNbSubsets, SubsetsOrdering::InterleavedBitReversed );
+    ASSERT_TRUE( orderedSubsetsProjector.IsValid() );
+    const auto projections = PhantomProjections( plan );
+    constexpr auto iterationNumber{ 8 };
+    constexpr auto stoppingIteration{ 3 };
+
+    using MonitoredReconstructor = std::function<Result<ImageDataPtr>( const StoppingCriteria & )>;
+    const std::vector<std::pair<std::string, MonitoredReconstructor>> reconstructors{
+        { "OS-SART", [&]( const StoppingCriteria & p_criteria ) { return recons::OSSART( orderedSubsetsProjector, projections, iterationNumber, 1.F, std::nullopt, std::nullopt, p_criteria ); } },
+        { "OSEM", [&]( const StoppingCriteria & p_criteria ) { return recons::OSEM( orderedSubsetsProjector, projections, iterationNumber, 1.F, std::nullopt, std::nullopt, p_criteria ); } } };
+    for( const auto & [algorithm, reconstructor] : reconstructors )
+    {
+        std::vector<IterationMetrics> history;
+        StoppingCriteria criteria;
+        criteria.monitorVolumeChange = true;
+        criteria.metricsCallback = [&]( const IterationMetrics & p_metrics ) { history.push_back( p_metrics ); };
+        ASSERT_FALSE( reconstructor( criteria ).has_error() ) << algorithm;
+        ASSERT_EQ( history.size(), static_cast<size_t>( iterationNumber ) ) << algorithm;
+        for( auto iteration{ 1 }; iteration < iterationNumber; iteration++ )
+        {
+            EXPECT_LT( history[iteration].relativeResidualNorm, history[iteration - 1].relativeResidualNorm ) << algorithm << " " << iteration;
+            EXPECT_GT( history[iteration].relativeVolumeChange, 0. ) << algorithm << " " << iteration;
+        }
+
+        criteria.relativeTolerance = history[stoppingIteration].relativeResidualNorm;
+        history.clear();
+        ASSERT_FALSE( reconstructor( criteria ).has_error() ) << algorithm;
+        EXPECT_EQ( history.size(), static_cast<size_t>( stoppingIteration + 1 ) ) << algorithm;
+    }
+}
+
+TEST( OrderedSubsetsTest, ConcurrentOSEMReconstructionsMatchSequentialOne )
+{
+    // concurrent reconstructions of the same geometry get projectors of their own from the cache
+    const auto paths = GeometriesFilesPaths();
+    ASSERT_FALSE( paths.empty() );
+    TomoGeometry tomoGeometry( paths.front().string() );
+    ProjectorPlan plan( &tomoGeometry, DefaultProjectorBackend() );
+    const auto projections = PhantomProjections( plan );
+    auto & cache = OrderedSubsetsProjectorCache::Instance();
+    cache.Clear();
+
+    const auto sequentialVolume = recons::OSEM( &tomoGeometry, projections, 2, convergenceNbSubsets, 1.F, std::nullopt, std::nullopt );
+    ASSERT_FALSE( sequentialVolume.has_error() );
+    const auto * sequentialBuffer = static_cast<const float *>( sequentialVolume.value()->GetScalarPointer() );
+    const auto nbVoxels = plan.GetGeometry().GetVolumeVoxelsNumber();
+
+    std::vector<Result<ImageDataPtr>> concurrentVolumes( 4 );
+    std::vector<std::thread> threads;
+    for( auto & volume : concurrentVolumes )
+    {
+        threads.emplace_back( [&]() { volume = recons::OSEM( &tomoGeometry, projections, 2, convergenceNbSubsets, 1.F, std::nullopt, std::nullopt ); } );
+    }
+    for( auto & thread : threads )
+    {
+        thread.join();
+    }
+    for( const auto & volume : concurrentVolumes )
+    {
+        ASSERT_TRUE( !volume.has_error() && volume.value() != nullptr );
+        const auto * buffer = static_cast<const float *>( volume.value()->GetScalarPointer() );
+        EXPECT_TRUE( std::equal( buffer, buffer + nbVoxels, sequentialBuffer ) );
+    }
+    cache.Clear();
+}
+
+TEST( OrderedSubsetsTest, OrderedSubsetsReconstructionsResumeAtSubsetCursor )
+{
+    // the last checkpoint of a run is taken after the third subset of its last iteration: a run resumed from it replaces
+    // its initial volume by the checkpoint one, performs the last subset only, and ends on the volume of the first run
+    const auto paths = GeometriesFilesPaths();
+    ASSERT_FALSE( paths.empty() );
+    TomoGeometry tomoGeometry( paths.front().string() );
+    ProjectorPlan plan( &tomoGeometry, DefaultProjectorBackend() );
+    const auto & geometry = plan.GetGeometry();
+    const auto projections = PhantomProjections( plan );
+    const auto * projectionsBuffer = static_cast<const float *>( projections->GetScalarPointer() );
+    constexpr auto iterationNumber{ 2 };
+
+    CheckpointOptions options;
+    options.filePath = ( std::filesystem::temp_directory_path() / "kevernals_ordered_subsets_test.ckpt" ).string();
+    options.iterationStep = iterationNumber + 1;
+    options.subsetStep = convergenceNbSubsets - 1;
+    const CheckpointState subsetsState{ 0, 0, convergenceNbSubsets, static_cast<int>( SubsetsOrdering::InterleavedBitReversed ), DefaultProjectorBackend() };
+    using CheckpointedReconstructor = std::function<Result<ImageDataPtr>( std::optional<ImageDataPtr> )>;
+    const std::vector<std::pair<std::string, CheckpointedReconstructor>> reconstructors{
+        { "OS-SART", [&]( std::optional<ImageDataPtr> p_initialVolume ) { return recons::OSSART( &tomoGeometry, projections, iterationNumber, convergenceNbSubsets, 1.F, p_initialVolume, std::nullopt, StoppingCriteria{}, VerboseOutputOptions{}, options ); } },
+        { "OSEM", [&]( std::optional<ImageDataPtr> p_initialVolume ) { return recons::OSEM( &tomoGeometry, projections, iterationNumber, convergenceNbSubsets, 1.F, p_initialVolume, std::nullopt, StoppingCriteria{}, VerboseOutputOptions{}, options ); } } };
+    for( const auto & [algorithm, reconstructor] : reconstructors )
+    {
+        std::filesystem::remove( options.filePath );
+        const auto volume = reconstructor( std::nullopt );
+        ASSERT_FALSE( volume.has_error() ) << algorithm;
+        const auto * buffer = static_cast<const float *>( volume.value()->GetScalarPointer() );
+
+        std::vector<float> checkpointVolume( geometry.GetVolumeVoxelsNumber() );
+        const auto state = ReconstructionCheckpoint( options, algorithm, geometry, projectionsBuffer, geometry.GetProjectionsPixelsNumber() ).Resume( subsetsState, checkpointVolume.data() );
+        ASSERT_TRUE( state.has_value() ) << algorithm;
+        EXPECT_EQ( state->nextIteration, iterationNumber - 1 ) << algorithm;
+        EXPECT_EQ( state->subsetCursor, convergenceNbSubsets - 1 ) << algorithm;
+
+        auto wrongInitialVolume = plan.CreateVolumeImage();
+        auto * wrongInitialBuffer = static_cast<float *>( wrongInitialVolume->GetScalarPointer() );
+        std::fill( wrongInitialBuffer, wrongInitialBuffer + geometry.GetVolumeVoxelsNumber(), 5.F );
+        const auto resumedVolume = reconstructor( wrongInitialVolume );
+        ASSERT_FALSE( resumedVolume.has_error() ) << algorithm;
+        const auto * resumedBuffer = static_cast<const float *>( resumedVolume.value()->GetScalarPointer() );
+        EXPECT_TRUE( std::equal( buffer, buffer + geometry.GetVolumeVoxelsNumber(), resumedBuffer ) ) << algorithm;
+    }
+    std::filesystem::remove( options.filePath );
+}
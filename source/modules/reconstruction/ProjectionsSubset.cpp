@@ -0,0 +1,74 @@
+#include "modules/reconstruction/ProjectionsSubset.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace projectionssubset
+{
+ProjectionsSubset All( int p_nbProjections )
+{
+    return Contiguous( 0, p_nbProjections );
+}
+
+ProjectionsSubset Contiguous( int p_first, int p_count )
+{
+    ProjectionsSubset subset( std::max( 0, p_count ) );
+    std::iota( subset.begin(), subset.end(), p_first );
+    return subset;
+}
+
+ProjectionsSubset Strided( int p_first, int p_stride, int p_nbProjections )
+{
+    ProjectionsSubset subset;
+    if( p_stride <= 0 )
+    {
+        return subset;
+    }
+    for( auto projectionIndex{ std::max( 0, p_first ) }; projectionIndex < p_nbProjections; projectionIndex += p_stride )
+    {
+        subset.push_back( projectionIndex );
+    }
+    return subset;
+}
+
+std::vector<ProjectionsSubset> Interleaved( int p_nbProjections, int p_nbSubsets )
+{
+    std::vector<ProjectionsSubset> subsets;
+    const auto nbSubsets = std::clamp( p_nbSubsets, 1, std::max( 1, p_nbProjections ) );
+    for( auto subsetIndex{ 0 }; subsetIndex < nbSubsets; subsetIndex++ )
+    {
+        subsets.push_back( Strided( subsetIndex, nbSubsets, p_nbProjections ) );
+    }
+    return subsets;
+}
+
+bool IsValid( const ProjectionsSubset & p_subset, int p_nbProjections )
+{
+    if( p_subset.empty() )
+    {
+        return false;
+    }
+    std::vector<char> seen( std::max( 0, p_nbProjections ), 0 );
+    for( auto projectionIndex : p_subset )
+    {
+        if( projectionIndex < 0 || projectionIndex >= p_nbProjections || seen[projectionIndex] != 0 )
+        {
+            return false;
+        }
+        seen[projectionIndex] = 1;
+    }
+    return true;
+}
+
+bool IsContiguous( const ProjectionsSubset & p_subset )
+{
+    for( auto index{ 1U }; index < p_subset.size(); index++ )
+    {
+        if( p_subset[index] != p_subset[index - 1] + 1 )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}    // namespace projectionssubset
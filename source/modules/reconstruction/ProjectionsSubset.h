@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+// Ordered list of projection indices, used to project or back project a part of the projections only
+// (ordered-subsets algorithms). Any order is allowed, duplicates are not.
+using ProjectionsSubset = std::vector<int>;
+
+namespace projectionssubset
+{
+// 0, 1, ..., p_nbProjections - 1
+ProjectionsSubset All( int p_nbProjections );
+// p_first, p_first + 1, ..., p_first + p_count - 1
+ProjectionsSubset Contiguous( int p_first, int p_count );
+// p_first, p_first + p_stride, ... while lower than p_nbProjections
+ProjectionsSubset Strided( int p_first, int p_stride, int p_nbProjections );
+
+// p_nbSubsets interleaved subsets covering all the projections once: subset s is Strided( s, p_nbSubsets, p_nbProjections ).
+// Consecutive subsets are then spread over the whole angular range, which is the usual ordered-subsets choice
+std::vector<ProjectionsSubset> Interleaved( int p_nbProjections, int p_nbSubsets );
+
+// true if the indices are in [0, p_nbProjections[ without duplicate, and the subset is not empty
+bool IsValid( const ProjectionsSubset & p_subset, int p_nbProjections );
+// true if the subset is p_subset[0], p_subset[0] + 1, ... (its projections are stored contiguously)
+bool IsContiguous( const ProjectionsSubset & p_subset );
+}    // namespace projectionssubset
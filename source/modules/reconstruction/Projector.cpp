@@ -0,0 +1,195 @@
+#include "modules/reconstruction/Projector.h"
+
+#include "modules/reconstruction/ProjectorCpu.h"
+#include "modules/reconstruction/ProjectorDistanceDriven.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+#include "modules/reconstruction/ProjectorHomography.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+#include "modules/reconstruction/ProjectorSeparableFootprint.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+
+#include <iostream>
+
+ProjectorBackend DefaultProjectorBackend()
+{
+#ifdef TOMO_WITH_CUDA
+    if( Projector::IsCudaDeviceAvailable() )
+    {
+        return ProjectorBackend::Cuda;
+    }
+#endif
+    return ProjectorBackend::Cpu;
+}
+
+#ifndef TOMO_WITH_CUDA
+bool Projector::IsCudaDeviceAvailable()
+{
+    return false;
+}
+#endif
+
+vtkSmartPointer<vtkImageData> Projector::PerformProjection( vtkSmartPointer<vtkImageData> p_volume ) const
+{
+    switch( m_backend )
+    {
+        case ProjectorBackend::Cuda:
+#ifdef TOMO_WITH_CUDA
+            return this->PerformCudaProjection( p_volume );
+#else
+            std::cout << "Projector: CUDA backend requested but KEVERNALS was built without CUDA" << std::endl;
+            return nullptr;
+#endif
+        case ProjectorBackend::Cpu:
+        case ProjectorBackend::CpuIncremental:
+        case ProjectorBackend::CpuSimd:
+        case ProjectorBackend::CpuDistanceDriven:
+        case ProjectorBackend::CpuSeparableFootprint:
+        case ProjectorBackend::CpuMatched:
+        case ProjectorBackend::CpuHomography:
+        case ProjectorBackend::CpuDistanceDrivenMatched:
+        case ProjectorBackend::CpuSeparableFootprintMatched:
+            return this->PerformCpuProjection( p_volume );
+    }
+    return nullptr;
+}
+
+vtkSmartPointer<vtkImageData> Projector::PerformBackProjection( vtkSmartPointer<vtkImageData> p_projections ) const
+{
+    switch( m_backend )
+    {
+        case ProjectorBackend::Cuda:
+#ifdef TOMO_WITH_CUDA
+            return this->PerformCudaBackProjection( p_projections );
+#else
+            std::cout << "Projector: CUDA backend requested but KEVERNALS was built without CUDA" << std::endl;
+            return nullptr;
+#endif
+        case ProjectorBackend::Cpu:
+        case ProjectorBackend::CpuIncremental:
+        case ProjectorBackend::CpuSimd:
+        case ProjectorBackend::CpuDistanceDriven:
+        case ProjectorBackend::CpuSeparableFootprint:
+        case ProjectorBackend::CpuMatched:
+        case ProjectorBackend::CpuHomography:
+        case ProjectorBackend::CpuDistanceDrivenMatched:
+        case ProjectorBackend::CpuSeparableFootprintMatched:
+            return this->PerformCpuBackProjection( p_projections );
+    }
+    return nullptr;
+}
+
+bool Projector::PerformProjection( const vtkSmartPointer<vtkImageData> p_volume, const ProjectionsSubset & p_projectionsSubset, vtkSmartPointer<vtkImageData> p_projections ) const
+{
+    ProjectorPlan projectorPlan( m_tomoGeometry, m_backend, p_projectionsSubset );
+    return projectorPlan.IsValid() && projectorPlan.Project( p_volume, p_projections );
+}
+
+bool Projector::PerformBackProjection( const vtkSmartPointer<vtkImageData> p_projections, const ProjectionsSubset & p_projectionsSubset, vtkSmartPointer<vtkImageData> p_volume ) const
+{
+    ProjectorPlan projectorPlan( m_tomoGeometry, m_backend, p_projectionsSubset );
+    return projectorPlan.IsValid() && projectorPlan.BackProject( p_projections, p_volume );
+}
+
+vtkSmartPointer<vtkImageData> Projector::PerformCpuProjection( vtkSmartPointer<vtkImageData> p_volume ) const
+{
+    if( m_tomoGeometry == nullptr || p_volume == nullptr )
+    {
+        return nullptr;
+    }
+    auto geometry = ProjectorGeometry::FromTomoGeometry( m_tomoGeometry );
+
+    auto volumeDimensions = p_volume->GetDimensions();
+    if( volumeDimensions[0] != geometry.volumeDimension.x || volumeDimensions[1] != geometry.volumeDimension.y || volumeDimensions[2] != geometry.volumeDimension.z )
+    {
+        std::cout << "Projector: volume dimensions do not match the geometry" << std::endl;
+        return nullptr;
+    }
+
+    // Prepare data for output
+    auto outputImage = vtkSmartPointer<vtkImageData>::New();
+    outputImage->SetDimensions( geometry.projectionsDimension.x, geometry.projectionsDimension.y, geometry.projectionsDimension.z );
+    outputImage->SetSpacing( geometry.projectionsPixelsSpacing.x, geometry.projectionsPixelsSpacing.y, 1. );
+    outputImage->AllocateScalars( VTK_FLOAT, 1 );
+
+    const auto * volumeBuffer = static_cast<float *>( p_volume->GetScalarPointer() );
+    auto * projectionsBuffer = static_cast<float *>( outputImage->GetScalarPointer() );
+    switch( m_backend )
+    {
+        case ProjectorBackend::CpuIncremental:
+        case ProjectorBackend::CpuMatched:
+            cpuprojector::PerformIncrementalProjection( volumeBuffer, geometry, projectionsBuffer );
+            break;
+        case ProjectorBackend::CpuSimd:
+        case ProjectorBackend::CpuHomography:
+            cpuprojector::PerformPacketProjection( volumeBuffer, geometry, projectionsBuffer );
+            break;
+        case ProjectorBackend::CpuDistanceDriven:
+        case ProjectorBackend::CpuDistanceDrivenMatched:
+            cpuprojector::PerformDistanceDrivenProjection( volumeBuffer, geometry, projectionsBuffer );
+            break;
+        case ProjectorBackend::CpuSeparableFootprint:
+        case ProjectorBackend::CpuSeparableFootprintMatched:
+            cpuprojector::PerformSeparableFootprintProjection( volumeBuffer, geometry, projectionsBuffer );
+            break;
+        default:
+            cpuprojector::PerformProjection( volumeBuffer, geometry, projectionsBuffer );
+            break;
+    }
+
+    return outputImage;
+}
+
+vtkSmartPointer<vtkImageData> Projector::PerformCpuBackProjection( vtkSmartPointer<vtkImageData> p_projections ) const
+{
+    if( m_tomoGeometry == nullptr || p_projections == nullptr )
+    {
+        return nullptr;
+    }
+    auto geometry = ProjectorGeometry::FromTomoGeometry( m_tomoGeometry );
+
+    auto projectionsDimensions = p_projections->GetDimensions();
+    if( projectionsDimensions[0] != geometry.projectionsDimension.x || projectionsDimensions[1] != geometry.projectionsDimension.y || projectionsDimensions[2] != geometry.projectionsDimension.z )
+    {
+        std::cout << "Projector: projections dimensions do not match the geometry" << std::endl;
+        return nullptr;
+    }
+
+    // Prepare data for output
+    auto outputImage = vtkSmartPointer<vtkImageData>::New();
+    outputImage->SetDimensions( geometry.volumeDimension.x, geometry.volumeDimension.y, geometry.volumeDimension.z );
+    outputImage->SetSpacing( geometry.volumeVoxelsSpacing.x, geometry.volumeVoxelsSpacing.y, geometry.volumeVoxelsSpacing.z );
+    outputImage->AllocateScalars( VTK_FLOAT, 1 );
+
+    const auto * projectionsBuffer = static_cast<float *>( p_projections->GetScalarPointer() );
+    auto * volumeBuffer = static_cast<float *>( outputImage->GetScalarPointer() );
+    switch( m_backend )
+    {
+        case ProjectorBackend::CpuIncremental:
+        case ProjectorBackend::CpuSimd:
+            cpuprojector::PerformIncrementalBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+        case ProjectorBackend::CpuDistanceDriven:
+            cpuprojector::PerformDistanceDrivenBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+        case ProjectorBackend::CpuSeparableFootprint:
+            cpuprojector::PerformSeparableFootprintBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+        case ProjectorBackend::CpuMatched:
+            cpuprojector::PerformMatchedBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+        case ProjectorBackend::CpuDistanceDrivenMatched:
+            cpuprojector::PerformDistanceDrivenMatchedBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+        case ProjectorBackend::CpuSeparableFootprintMatched:
+            cpuprojector::PerformSeparableFootprintMatchedBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+        case ProjectorBackend::CpuHomography:
+            cpuprojector::PerformHomographyBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+        default:
+            cpuprojector::PerformBackProjection( projectionsBuffer, geometry, volumeBuffer );
+            break;
+    }
+
+    return outputImage;
+}
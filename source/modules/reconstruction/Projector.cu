@@ -2,6 +2,7 @@
 
 #include "modules/reconstruction/Projector.h"
 #include "modules/reconstruction/CudaErrorHandler.h"
+#include "modules/reconstruction/ProjectorPlan.h"
 
 #include <vtkTIFFWriter.h>
 
@@ -783,6 +784,12 @@ __global__ void CudaPerformBackProjection(
     }
 #endif
 }
+bool Projector::IsCudaDeviceAvailable()
+{
+    auto deviceCount{ 0 };
+    return cudaGetDeviceCount( &deviceCount ) == cudaSuccess && deviceCount > 0;
+}
+
 void Projector::ExtractDimension( const vtkSmartPointer<vtkImageData> p_imageDataPtr, dim3 & p_dimension ) const
 {
     if (p_imageDataPtr == nullptr)
@@ -870,7 +877,7 @@ void Projector::PerformProjection( const vtkSmartPointer<vtkImageData> p_volume,
 }
 
 
-vtkSmartPointer<vtkImageData>  Projector::PerformProjection( vtkSmartPointer<vtkImageData>  p_volume ) const
+vtkSmartPointer<vtkImageData>  Projector::PerformCudaProjection( vtkSmartPointer<vtkImageData>  p_volume ) const
 {
     //// Device memory for volume elements
     dim3 volumeDimensions;
@@ -1035,7 +1042,7 @@ vtkSmartPointer<vtkImageData>  Projector::PerformProjection( vtkSmartPointer<vtk
     ////}
 }
 
-vtkSmartPointer<vtkImageData>  Projector::PerformBackProjection( vtkSmartPointer<vtkImageData>  p_projections ) const
+vtkSmartPointer<vtkImageData>  Projector::PerformCudaBackProjection( vtkSmartPointer<vtkImageData>  p_projections ) const
 {
     //// Device memory for volume elements (result)
     dim3 volumeDimensions;
@@ -1206,6 +1213,93 @@ vtkSmartPointer<vtkImageData>  Projector::PerformBackProjection( vtkSmartPointer
     ////}
 }
 
+// ProjectorPlan device part: buffers and geometry tables are uploaded once, each call only copies its input and output
+void ProjectorPlan::PrepareCudaBuffers()
+{
+    const auto nbProjections = m_geometry.projectionsDimension.z;
+    checkCudaErrors( cudaMalloc( (void **)&m_deviceVolumeBuffer, m_geometry.GetVolumeVoxelsNumber() * sizeof( float ) ) );
+    checkCudaErrors( cudaMalloc( (void **)&m_deviceProjectionsBuffer, m_geometry.GetProjectionsPixelsNumber() * sizeof( float ) ) );
+    checkCudaErrors( cudaMalloc( (void **)&m_deviceProjectionsOriginInWorld, nbProjections * sizeof( float3 ) ) );
+    checkCudaErrors( cudaMemcpy( m_deviceProjectionsOriginInWorld, m_geometry.projectionsOriginInWorld.data(), nbProjections * sizeof( float3 ), cudaMemcpyHostToDevice ) );
+    checkCudaErrors( cudaMalloc( (void **)&m_deviceSourcesPositions, nbProjections * sizeof( float3 ) ) );
+    checkCudaErrors( cudaMemcpy( m_deviceSourcesPositions, m_geometry.sourcesPositions.data(), nbProjections * sizeof( float3 ), cudaMemcpyHostToDevice ) );
+}
+
+void ProjectorPlan::ReleaseCudaBuffers()
+{
+    if( m_deviceSourcesPositions != nullptr )
+    {
+        checkCudaErrors( cudaFree( m_deviceSourcesPositions ) );
+    }
+    if( m_deviceProjectionsOriginInWorld != nullptr )
+    {
+        checkCudaErrors( cudaFree( m_deviceProjectionsOriginInWorld ) );
+    }
+    if( m_deviceProjectionsBuffer != nullptr )
+    {
+        checkCudaErrors( cudaFree( m_deviceProjectionsBuffer ) );
+    }
+    if( m_deviceVolumeBuffer != nullptr )
+    {
+        checkCudaErrors( cudaFree( m_deviceVolumeBuffer ) );
+    }
+}
+
+void ProjectorPlan::PerformCudaProjection( const float * p_volumeBuffer, float * p_projectionsBuffer )
+{
+    const dim3 volumeDimensions( m_geometry.volumeDimension.x, m_geometry.volumeDimension.y, m_geometry.volumeDimension.z );
+    const dim3 projectionDimensions( m_geometry.projectionsDimension.x, m_geometry.projectionsDimension.y, m_geometry.projectionsDimension.z );
+    const auto volumeOrigin = make_float3( m_volumeOriginInWorld.x, m_volumeOriginInWorld.y, m_volumeOriginInWorld.z );
+    const auto volumeVoxelsSpacing = make_float3( m_geometry.volumeVoxelsSpacing.x, m_geometry.volumeVoxelsSpacing.y, m_geometry.volumeVoxelsSpacing.z );
+    const auto projectionsPixelSpacing = make_float2( m_geometry.projectionsPixelsSpacing.x, m_geometry.projectionsPixelsSpacing.y );
+
+    checkCudaErrors( cudaMemcpy( m_deviceVolumeBuffer, p_volumeBuffer, m_geometry.GetVolumeVoxelsNumber() * sizeof( float ), cudaMemcpyHostToDevice ) );
+
+    dim3 blockDims( 32, 16, 1 );
+    dim3 gridDims( ( projectionDimensions.x + blockDims.x - 1 ) / blockDims.x, ( projectionDimensions.y + blockDims.y - 1 ) / blockDims.y, ( projectionDimensions.z + blockDims.z - 1 ) / blockDims.z );
+    CudaPerformProjection<<<gridDims, blockDims>>>( m_deviceVolumeBuffer,
+                                                    volumeDimensions,
+                                                    volumeOrigin,
+                                                    volumeVoxelsSpacing,
+                                                    m_deviceProjectionsBuffer,
+                                                    projectionDimensions,
+                                                    projectionsPixelSpacing,
+                                                    reinterpret_cast<const float3 *>( m_deviceProjectionsOriginInWorld ),
+                                                    reinterpret_cast<const float3 *>( m_deviceSourcesPositions ) );
+    checkCudaErrors( cudaGetLastError() );
+
+    // blocking copy: waits for the kernel
+    checkCudaErrors( cudaMemcpy( p_projectionsBuffer, m_deviceProjectionsBuffer, m_geometry.GetProjectionsPixelsNumber() * sizeof( float ), cudaMemcpyDeviceToHost ) );
+}
+
+void ProjectorPlan::PerformCudaBackProjection( const float * p_projectionsBuffer, float * p_volumeBuffer )
+{
+    const dim3 volumeDimensions( m_geometry.volumeDimension.x, m_geometry.volumeDimension.y, m_geometry.volumeDimension.z );
+    const dim3 projectionDimensions( m_geometry.projectionsDimension.x, m_geometry.projectionsDimension.y, m_geometry.projectionsDimension.z );
+    const auto volumeOrigin = make_float3( m_volumeOriginInWorld.x, m_volumeOriginInWorld.y, m_volumeOriginInWorld.z );
+    const auto volumeVoxelsSpacing = make_float3( m_geometry.volumeVoxelsSpacing.x, m_geometry.volumeVoxelsSpacing.y, m_geometry.volumeVoxelsSpacing.z );
+    const auto projectionsPixelSpacing = make_float2( m_geometry.projectionsPixelsSpacing.x, m_geometry.projectionsPixelsSpacing.y );
+
+    checkCudaErrors( cudaMemcpy( m_deviceProjectionsBuffer, p_projectionsBuffer, m_geometry.GetProjectionsPixelsNumber() * sizeof( float ), cudaMemcpyHostToDevice ) );
+
+    dim3 blockDims( 32, 16, 1 );
+    dim3 gridDims( ( volumeDimensions.x + blockDims.x - 1 ) / blockDims.x, ( volumeDimensions.y + blockDims.y - 1 ) / blockDims.y, ( volumeDimensions.z + blockDims.z - 1 ) / blockDims.z );
+    CudaPerformBackProjection<<<gridDims, blockDims>>>( m_deviceProjectionsBuffer,
+                                                        volumeDimensions,
+                                                        volumeOrigin,
+                                                        volumeVoxelsSpacing,
+                                                        m_deviceVolumeBuffer,
+                                                        projectionDimensions,
+                                                        projectionsPixelSpacing,
+                                                        reinterpret_cast<const float3 *>( m_deviceProjectionsOriginInWorld ),
+                                                        reinterpret_cast<const float3 *>( m_deviceSourcesPositions ) );
+    checkCudaErrors( cudaGetLastError() );
+
+    // blocking copy: waits for the kernel
+    checkCudaErrors( cudaMemcpy( p_volumeBuffer, m_deviceVolumeBuffer, m_geometry.GetVolumeVoxelsNumber() * sizeof( float ), cudaMemcpyDeviceToHost ) );
+}
+
+
 
 /*
 
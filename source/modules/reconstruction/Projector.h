@@ -1,28 +1,67 @@
 #pragma once
 
 #include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectionsSubset.h"
 
 #include <vtkImageData.h>
 #include <vtkSmartPointer.h>
 
+// Implementation used for the forward and back projections
+enum class ProjectorBackend
+{
+    Cuda = 0,                       // CUDA kernels (only available when built with TOMO_ENABLE_CUDA)
+    Cpu,                            // multithreaded host port of the CUDA kernels
+    CpuIncremental,                 // multithreaded host projectors walking the rays with the incremental (Jacobs) traversal
+    CpuSimd,                        // CpuIncremental with the forward rays traced by SIMD packets (AVX2/AVX-512, chosen at runtime)
+    CpuDistanceDriven,              // multithreaded distance-driven projectors, the back projection being the normalized transpose of the projection weights
+    CpuSeparableFootprint,          // multithreaded separable footprint projectors, trapezoid along y and rectangle along x, back projection as CpuDistanceDriven
+    CpuMatched,                     // CpuIncremental forward projection with its exact transpose as back projection (no voxel normalization)
+    CpuHomography,                  // CpuSimd forward projection, slice-wise homography back projection with bilinear detector sampling
+    CpuDistanceDrivenMatched,       // CpuDistanceDriven forward projection with its exact transpose as back projection (no voxel normalization)
+    CpuSeparableFootprintMatched    // CpuSeparableFootprint forward projection with its exact transpose as back projection (no voxel normalization)
+};
+
+// Cuda when it is built and a device is present, Cpu otherwise
+ProjectorBackend DefaultProjectorBackend();
+
 struct dim3;
 struct float3;
 class Projector
 {
 public:
     Projector( TomoGeometry * p_tomoGeometry )
-      : m_tomoGeometry{ p_tomoGeometry } {};
+      : m_tomoGeometry{ p_tomoGeometry }
+      , m_backend{ DefaultProjectorBackend() } {};
+    Projector( TomoGeometry * p_tomoGeometry, ProjectorBackend p_backend )
+      : m_tomoGeometry{ p_tomoGeometry }
+      , m_backend{ p_backend } {};
     ~Projector() = default;
 
+    ProjectorBackend GetBackend() const { return m_backend; }
+    void SetBackend( ProjectorBackend p_backend ) { m_backend = p_backend; }
+
     vtkSmartPointer<vtkImageData> PerformProjection( vtkSmartPointer<vtkImageData> p_volume ) const;
     void PerformProjection( const vtkSmartPointer<vtkImageData> p_volume, const Position3D & p_sourcePosition, vtkSmartPointer<vtkImageData> p_projectionsContainer ) const;
     vtkSmartPointer<vtkImageData> PerformBackProjection( vtkSmartPointer<vtkImageData> p_projections ) const;
 
+    // Subset versions: only the p_projectionsSubset projections of the full stack p_projections are written (projection)
+    // or read (back projection). Each call sets up a ProjectorPlan: iterative algorithms should keep one plan per subset instead
+    bool PerformProjection( const vtkSmartPointer<vtkImageData> p_volume, const ProjectionsSubset & p_projectionsSubset, vtkSmartPointer<vtkImageData> p_projections ) const;
+    bool PerformBackProjection( const vtkSmartPointer<vtkImageData> p_projections, const ProjectionsSubset & p_projectionsSubset, vtkSmartPointer<vtkImageData> p_volume ) const;
+
+    static bool IsCudaDeviceAvailable();
+
 private:
+    vtkSmartPointer<vtkImageData> PerformCudaProjection( vtkSmartPointer<vtkImageData> p_volume ) const;
+    vtkSmartPointer<vtkImageData> PerformCudaBackProjection( vtkSmartPointer<vtkImageData> p_projections ) const;
+    vtkSmartPointer<vtkImageData> PerformCpuProjection( vtkSmartPointer<vtkImageData> p_volume ) const;
+    vtkSmartPointer<vtkImageData> PerformCpuBackProjection( vtkSmartPointer<vtkImageData> p_projections ) const;
+
     void ExtractDimension( const vtkSmartPointer<vtkImageData> p_imageDataPtr, dim3 & p_dimension ) const;
     void ExtractSpacing( const vtkSmartPointer<vtkImageData> p_imageDataPtr, float3 & p_spacing ) const;
     void ExtractOrigin( const vtkSmartPointer<vtkImageData> p_imageDataPtr, float3 & p_origin ) const;
 
     // Make it optional to check in PerformReconstruction method if we can do it...
     TomoGeometry * m_tomoGeometry;
+    ProjectorBackend m_backend;
 };
@@ -0,0 +1,452 @@
+#include "modules/reconstruction/ProjectorCpu.h"
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/RayTraversal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace    // anonymous namespace
+{
+using namespace cpuprojector;
+
+constexpr auto projectionFloatTolerance = 0.000001F;
+constexpr auto backProjectionFloatTolerance = 0.000000000000000000000001F;
+constexpr auto pixelNeighborhoodSemiLength{ 5 };    // same neighborhood as in CudaPerformBackProjection
+constexpr auto slabsPerThread{ 4 };                   // z slabs of the ray-driven back projection, per hardware thread
+
+// Appends (in increasing order) the alphas of the planes of one axis crossed between p_alphaMin and p_alphaMax
+inline void AppendAxisAlphas( float p_source, float p_director, float p_halfLength, int p_dimension, float p_alphaMin, float p_alphaMax, std::vector<float> & p_alphas )
+{
+    if( std::fabs( p_director ) <= projectionFloatTolerance )
+    {
+        return;
+    }
+    // plane i is located at -p_halfLength + i in the floating voxel coordinate system
+    const auto entryCoordinate = p_halfLength + p_source + p_alphaMin * p_director;
+    const auto exitCoordinate = p_halfLength + p_source + p_alphaMax * p_director;
+    const auto firstPlane = std::max( 0, static_cast<int>( std::ceil( std::min( entryCoordinate, exitCoordinate ) ) ) );
+    const auto lastPlane = std::min( p_dimension, static_cast<int>( std::floor( std::max( entryCoordinate, exitCoordinate ) ) ) );
+    const auto alphaStep = 1.F / p_director;
+    if( p_director > 0 )
+    {
+        for( auto plane{ firstPlane }; plane <= lastPlane; plane++ )
+        {
+            p_alphas.push_back( ( static_cast<float>( plane ) - p_halfLength - p_source ) * alphaStep );
+        }
+    }
+    else
+    {
+        for( auto plane{ lastPlane }; plane >= firstPlane; plane-- )
+        {
+            p_alphas.push_back( ( static_cast<float>( plane ) - p_halfLength - p_source ) * alphaStep );
+        }
+    }
+}
+
+// Host counterpart of FindProjectionAlphas_d: sorted alphas of the entry point, of every voxel plane crossing and of the exit point.
+// Each axis gives an already sorted sequence, so the three of them are merged instead of sorted
+inline void FindProjectionAlphas( const FloatingVoxelRay & p_ray, const Int3 & p_volumeDimension, const Float3 & p_volumeHalfLength, float p_alphaMin, float p_alphaMax, std::vector<float> & p_alphas )
+{
+    p_alphas.clear();
+    p_alphas.push_back( p_alphaMin );
+
+    AppendAxisAlphas( p_ray.source.x, p_ray.directorVector.x, p_volumeHalfLength.x, p_volumeDimension.x, p_alphaMin, p_alphaMax, p_alphas );
+    const auto yStart = static_cast<std::ptrdiff_t>( p_alphas.size() );
+    AppendAxisAlphas( p_ray.source.y, p_ray.directorVector.y, p_volumeHalfLength.y, p_volumeDimension.y, p_alphaMin, p_alphaMax, p_alphas );
+    std::inplace_merge( p_alphas.begin(), p_alphas.begin() + yStart, p_alphas.end() );
+    const auto zStart = static_cast<std::ptrdiff_t>( p_alphas.size() );
+    AppendAxisAlphas( p_ray.source.z, p_ray.directorVector.z, p_volumeHalfLength.z, p_volumeDimension.z, p_alphaMin, p_alphaMax, p_alphas );
+    std::inplace_merge( p_alphas.begin(), p_alphas.begin() + zStart, p_alphas.end() );
+
+    p_alphas.push_back( p_alphaMax );
+}
+
+// Ray-driven scatter: the ray of each detector pixel adds p_raysValues[pixel], weighted by its length inside the voxel,
+// to every voxel it crosses (volume set to 0 first). The weights are also summed in p_weightsBuffer if it is not null.
+// Each slab of slices is owned by a single task, so the scatter needs neither atomics nor private volume copies.
+// The entry and exit alphas of the rays (ComputeRaysAlphas) are computed once for all the slabs, each slab only clips them
+void ScatterRaysBySlabs( const float * p_raysValues, const ProjectorGeometry & p_geometry, const Float2 * p_raysAlphas, float * p_volumeBuffer, float * p_weightsBuffer )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto volumeHalfLength = VolumeHalfLength( volumeDimension );
+    const auto sliceSize = static_cast<size_t>( volumeDimension.x ) * volumeDimension.y;
+    const auto projectionSize = static_cast<size_t>( projectionsDimension.x ) * projectionsDimension.y;
+
+    const auto nbThreads = std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+    const auto nbSlabs = std::clamp( slabsPerThread * nbThreads, 1, std::max( 1, volumeDimension.z ) );
+
+    auto slabsIndices = IndexRange{ nbSlabs };
+    auto slabScatter = [&]( int p_slabIndex ) {
+        const auto zBegin = p_slabIndex * volumeDimension.z / nbSlabs;
+        const auto zEnd = ( p_slabIndex + 1 ) * volumeDimension.z / nbSlabs;
+        std::fill( p_volumeBuffer + zBegin * sliceSize, p_volumeBuffer + zEnd * sliceSize, 0.F );
+        if( p_weightsBuffer != nullptr )
+        {
+            std::fill( p_weightsBuffer + zBegin * sliceSize, p_weightsBuffer + zEnd * sliceSize, 0.F );
+        }
+
+        for( auto projectionIndex{ 0 }; projectionIndex < projectionsDimension.z; projectionIndex++ )
+        {
+            const auto * projectionValues = p_raysValues + projectionIndex * projectionSize;
+            const auto * projectionAlphas = p_raysAlphas + projectionIndex * projectionSize;
+            for( auto yProjPixel{ 0 }; yProjPixel < projectionsDimension.y; yProjPixel++ )
+            {
+                for( auto xProjPixel{ 0 }; xProjPixel < projectionsDimension.x; xProjPixel++ )
+                {
+                    const auto pixelIndex = yProjPixel * projectionsDimension.x + xProjPixel;
+                    const auto rayValue = projectionValues[pixelIndex];
+                    auto alphaMin = projectionAlphas[pixelIndex].x;
+                    auto alphaMax = projectionAlphas[pixelIndex].y;
+                    if( alphaMin >= alphaMax || ( p_weightsBuffer == nullptr && rayValue == 0.F ) )
+                    {
+                        continue;
+                    }
+                    const auto ray = ComputeRay( p_geometry, projectionIndex, xProjPixel, yProjPixel );
+                    if( !ClipAlphasOnAxis( ray.source.z, ray.directorVector.z, static_cast<float>( zBegin ) - volumeHalfLength.z, static_cast<float>( zEnd ) - volumeHalfLength.z, alphaMin, alphaMax )
+                        || alphaMin >= alphaMax )
+                    {
+                        continue;
+                    }
+
+                    if( p_weightsBuffer != nullptr )
+                    {
+                        TraverseRayInSlab( ray, volumeDimension, volumeHalfLength, zBegin, zEnd, alphaMin, alphaMax, [&]( int p_voxelIndex, float p_weight ) {
+                            p_volumeBuffer[p_voxelIndex] += p_weight * rayValue;
+                            p_weightsBuffer[p_voxelIndex] += p_weight;
+                        } );
+                    }
+                    else
+                    {
+                        TraverseRayInSlab( ray, volumeDimension, volumeHalfLength, zBegin, zEnd, alphaMin, alphaMax, [&]( int p_voxelIndex, float p_weight ) {
+                            p_volumeBuffer[p_voxelIndex] += p_weight * rayValue;
+                        } );
+                    }
+                }
+            }
+        }
+    };
+    std::for_each( std::execution::par, slabsIndices.begin(), slabsIndices.end(), slabScatter );
+}
+}    // end of anonymous namespace
+
+namespace cpuprojector
+{
+void PerformProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto volumeHalfLength = VolumeHalfLength( volumeDimension );
+    const auto maxNumberOfAlphas = static_cast<size_t>( volumeDimension.x + volumeDimension.y + volumeDimension.z + 5 );
+
+    // one task per detector row, all projections together
+    auto rowsIndices = IndexRange{ projectionsDimension.z * projectionsDimension.y };
+    auto rowProjector = [&]( int p_rowIndex ) {
+        const auto projectionIndex = p_rowIndex / projectionsDimension.y;
+        const auto yProjPixel = p_rowIndex % projectionsDimension.y;
+        auto * rowBuffer = p_projectionsBuffer + static_cast<size_t>( p_rowIndex ) * projectionsDimension.x;
+
+        // alphas of the worker thread, reserved once for the longest ray
+        thread_local std::vector<float> alphas;
+        alphas.reserve( maxNumberOfAlphas );
+        for( auto xProjPixel{ 0 }; xProjPixel < projectionsDimension.x; xProjPixel++ )
+        {
+            rowBuffer[xProjPixel] = 0.F;
+
+            const auto ray = ComputeRay( p_geometry, projectionIndex, xProjPixel, yProjPixel );
+            float alphaMin;
+            float alphaMax;
+            if( !FindEntryAndExitAlphas( ray, volumeHalfLength, alphaMin, alphaMax ) )
+            {
+                continue;
+            }
+            FindProjectionAlphas( ray, volumeDimension, volumeHalfLength, alphaMin, alphaMax, alphas );
+
+            auto total{ 0.F };
+            auto totalWeight{ 0.F };
+            const auto raySize = static_cast<int>( alphas.size() );
+            for( auto i{ 0 }; i < raySize - 1; i++ )
+            {
+                const auto weight = alphas[i + 1] - alphas[i];
+                if( weight <= projectionFloatTolerance )
+                {
+                    continue;
+                }
+                const auto centerAlpha = ( alphas[i + 1] + alphas[i] ) / 2.F;
+
+                const auto pixX = static_cast<int>( volumeHalfLength.x + ray.source.x + centerAlpha * ray.directorVector.x );
+                const auto pixY = static_cast<int>( volumeHalfLength.y + ray.source.y + centerAlpha * ray.directorVector.y );
+                const auto pixZ = static_cast<int>( volumeHalfLength.z + ray.source.z + centerAlpha * ray.directorVector.z );
+
+                if( pixX >= 0 && pixX < volumeDimension.x && pixY >= 0 && pixY < volumeDimension.y && pixZ >= 0 && pixZ < volumeDimension.z )
+                {
+                    const auto currentIntersectionVoxelIndex = ( static_cast<size_t>( pixZ ) * volumeDimension.y + pixY ) * volumeDimension.x + pixX;
+                    totalWeight += weight;
+                    total += weight * p_volumeBuffer[currentIntersectionVoxelIndex];
+                }
+            }
+            if( totalWeight > projectionFloatTolerance )
+            {
+                rowBuffer[xProjPixel] = total / totalWeight;
+            }
+        }
+    };
+    std::for_each( std::execution::par, rowsIndices.begin(), rowsIndices.end(), rowProjector );
+}
+
+void PerformBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto & spacing = p_geometry.volumeVoxelsSpacing;
+    const auto & pixelSpacing = p_geometry.projectionsPixelsSpacing;
+    const auto nbProjections = projectionsDimension.z;
+
+    // per projection features in the floating voxel coordinate system, computed once for all voxels
+    std::vector<Float3> sourcesPositionsF( nbProjections );
+    std::vector<Float3> projectionsOriginsF( nbProjections );
+    std::vector<Float3> projectionsEndsF( nbProjections );
+    for( auto projectionIndex{ 0 }; projectionIndex < nbProjections; projectionIndex++ )
+    {
+        const auto & origin = p_geometry.projectionsOriginInWorld[projectionIndex];
+        sourcesPositionsF[projectionIndex] = ToFloatingVoxel( p_geometry.sourcesPositions[projectionIndex], spacing );
+        projectionsOriginsF[projectionIndex] = ToFloatingVoxel( origin, spacing );
+        projectionsEndsF[projectionIndex].x = ( origin.x + static_cast<float>( projectionsDimension.x ) * pixelSpacing.x ) / spacing.x;
+        projectionsEndsF[projectionIndex].y = ( origin.y + static_cast<float>( projectionsDimension.y ) * pixelSpacing.y ) / spacing.y;
+        projectionsEndsF[projectionIndex].z = projectionsOriginsF[projectionIndex].z;
+    }
+    const auto neighborhoodMarginX = static_cast<float>( pixelNeighborhoodSemiLength ) * pixelSpacing.x / spacing.x;
+    const auto neighborhoodMarginY = static_cast<float>( pixelNeighborhoodSemiLength ) * pixelSpacing.y / spacing.y;
+
+    // one task per volume row
+    auto rowsIndices = IndexRange{ volumeDimension.z * volumeDimension.y };
+    auto rowBackProjector = [&]( int p_rowIndex ) {
+        const auto zVoxel = p_rowIndex / volumeDimension.y;
+        const auto yVoxel = p_rowIndex % volumeDimension.y;
+        auto * rowBuffer = p_volumeBuffer + static_cast<size_t>( p_rowIndex ) * volumeDimension.x;
+
+        Float3 currentVoxelF;
+        currentVoxelF.y = static_cast<float>( yVoxel ) - static_cast<float>( volumeDimension.y ) / 2.F;
+        currentVoxelF.z = static_cast<float>( zVoxel ) - static_cast<float>( volumeDimension.z ) / 2.F;
+        for( auto xVoxel{ 0 }; xVoxel < volumeDimension.x; xVoxel++ )
+        {
+            currentVoxelF.x = static_cast<float>( xVoxel ) - static_cast<float>( volumeDimension.x ) / 2.F;
+
+            auto total{ 0.F };
+            auto totalWeight{ 0.F };
+            for( auto projectionIndex{ 0 }; projectionIndex < nbProjections; projectionIndex++ )
+            {
+                const auto & sourceF = sourcesPositionsF[projectionIndex];
+                const auto & originF = projectionsOriginsF[projectionIndex];
+                const auto & endF = projectionsEndsF[projectionIndex];
+
+                // shadow of the voxel center on the detector
+                Float3 centerDirectorVectorF;
+                centerDirectorVectorF.x = currentVoxelF.x + 0.5F - sourceF.x;
+                centerDirectorVectorF.y = currentVoxelF.y + 0.5F - sourceF.y;
+                centerDirectorVectorF.z = currentVoxelF.z + 0.5F - sourceF.z;
+                const auto alphaZ = std::fabs( centerDirectorVectorF.z ) > backProjectionFloatTolerance ? ( originF.z - sourceF.z ) / centerDirectorVectorF.z : 0.F;
+                const auto intersectionX = sourceF.x + centerDirectorVectorF.x * alphaZ;
+                const auto intersectionY = sourceF.y + centerDirectorVectorF.y * alphaZ;
+                if( !( intersectionX > originF.x - neighborhoodMarginX && intersectionX < endF.x + neighborhoodMarginX
+                       && intersectionY > originF.y - neighborhoodMarginY && intersectionY < endF.y + neighborhoodMarginY ) )
+                {
+                    continue;
+                }
+
+                const auto pixelX = static_cast<int>( ( intersectionX - originF.x ) * spacing.x / pixelSpacing.x );
+                const auto pixelY = static_cast<int>( ( intersectionY - originF.y ) * spacing.y / pixelSpacing.y );
+                const auto infProjectionPixelX = std::clamp( pixelX - pixelNeighborhoodSemiLength, 0, projectionsDimension.x - 1 );
+                const auto supProjectionPixelX = std::clamp( pixelX + pixelNeighborhoodSemiLength, 0, projectionsDimension.x - 1 );
+                const auto infProjectionPixelY = std::clamp( pixelY - pixelNeighborhoodSemiLength, 0, projectionsDimension.y - 1 );
+                const auto supProjectionPixelY = std::clamp( pixelY + pixelNeighborhoodSemiLength, 0, projectionsDimension.y - 1 );
+
+                const auto * projectionBuffer = p_projectionsBuffer + static_cast<size_t>( projectionIndex ) * projectionsDimension.x * projectionsDimension.y;
+
+                // alphas of the voxel faces for the rays of the involved pixels
+                const auto directorZ = originF.z - sourceF.z;
+                Float3 alpha1;
+                Float3 alpha2;
+                alpha1.z = std::fabs( directorZ ) > backProjectionFloatTolerance ? ( currentVoxelF.z - sourceF.z ) / directorZ : 0.F;
+                alpha2.z = std::fabs( directorZ ) > backProjectionFloatTolerance ? ( currentVoxelF.z + 1.F - sourceF.z ) / directorZ : 0.F;
+                for( auto projectionPixelY{ infProjectionPixelY }; projectionPixelY <= supProjectionPixelY; projectionPixelY++ )
+                {
+                    const auto directorY = ( p_geometry.projectionsOriginInWorld[projectionIndex].y + ( static_cast<float>( projectionPixelY ) + 0.5F ) * pixelSpacing.y ) / spacing.y - sourceF.y;
+                    alpha1.y = std::fabs( directorY ) > backProjectionFloatTolerance ? ( currentVoxelF.y - sourceF.y ) / directorY : 0.F;
+                    alpha2.y = std::fabs( directorY ) > backProjectionFloatTolerance ? ( currentVoxelF.y + 1.F - sourceF.y ) / directorY : 0.F;
+
+                    for( auto projectionPixelX{ infProjectionPixelX }; projectionPixelX <= supProjectionPixelX; projectionPixelX++ )
+                    {
+                        const auto directorX = ( p_geometry.projectionsOriginInWorld[projectionIndex].x + ( static_cast<float>( projectionPixelX ) + 0.5F ) * pixelSpacing.x ) / spacing.x - sourceF.x;
+                        alpha1.x = std::fabs( directorX ) > backProjectionFloatTolerance ? ( currentVoxelF.x - sourceF.x ) / directorX : 0.F;
+                        alpha2.x = std::fabs( directorX ) > backProjectionFloatTolerance ? ( currentVoxelF.x + 1.F - sourceF.x ) / directorX : 0.F;
+
+                        // We take the highest of the mins to catch the incoming intersection alpha
+                        const auto alphaMin = std::max( std::max( 0.F, std::min( alpha1.x, alpha2.x ) ), std::max( std::min( alpha1.y, alpha2.y ), std::min( alpha1.z, alpha2.z ) ) );
+                        // We take the lowest of the maxs to catch the outgoing intersection alpha
+                        const auto alphaMax = std::min( std::min( 1.F, std::max( alpha1.x, alpha2.x ) ), std::min( std::max( alpha1.y, alpha2.y ), std::max( alpha1.z, alpha2.z ) ) );
+                        const auto weight = alphaMax - alphaMin;
+                        if( weight > backProjectionFloatTolerance )
+                        {
+                            totalWeight += weight;
+                            total += weight * projectionBuffer[projectionPixelY * projectionsDimension.x + projectionPixelX];
+                        }
+                    }
+                }
+            }
+            rowBuffer[xVoxel] = totalWeight > backProjectionFloatTolerance ? total / totalWeight : 0.F;
+        }
+    };
+    std::for_each( std::execution::par, rowsIndices.begin(), rowsIndices.end(), rowBackProjector );
+}
+
+void PerformIncrementalProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto volumeHalfLength = VolumeHalfLength( volumeDimension );
+
+    // one task per detector row, all projections together
+    auto rowsIndices = IndexRange{ projectionsDimension.z * projectionsDimension.y };
+    auto rowProjector = [&]( int p_rowIndex ) {
+        const auto projectionIndex = p_rowIndex / projectionsDimension.y;
+        const auto yProjPixel = p_rowIndex % projectionsDimension.y;
+        auto * rowBuffer = p_projectionsBuffer + static_cast<size_t>( p_rowIndex ) * projectionsDimension.x;
+
+        for( auto xProjPixel{ 0 }; xProjPixel < projectionsDimension.x; xProjPixel++ )
+        {
+            rowBuffer[xProjPixel] = 0.F;
+
+            const auto ray = ComputeRay( p_geometry, projectionIndex, xProjPixel, yProjPixel );
+            float alphaMin;
+            float alphaMax;
+            if( !FindEntryAndExitAlphas( ray, volumeHalfLength, alphaMin, alphaMax ) )
+            {
+                continue;
+            }
+
+            auto total{ 0.F };
+            auto totalWeight{ 0.F };
+            TraverseRay( ray, volumeDimension, volumeHalfLength, alphaMin, alphaMax, [&]( int p_voxelIndex, float p_weight ) {
+                totalWeight += p_weight;
+                total += p_weight * p_volumeBuffer[p_voxelIndex];
+            } );
+            if( totalWeight > projectionFloatTolerance )
+            {
+                rowBuffer[xProjPixel] = total / totalWeight;
+            }
+        }
+    };
+    std::for_each( std::execution::par, rowsIndices.begin(), rowsIndices.end(), rowProjector );
+}
+
+void PerformIncrementalBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    std::vector<Float2> raysAlphas( p_geometry.GetProjectionsPixelsNumber() );
+    ComputeRaysAlphas( p_geometry, raysAlphas.data() );
+    std::vector<float> weights( p_geometry.GetVolumeVoxelsNumber() );
+    ScatterRaysBySlabs( p_projectionsBuffer, p_geometry, raysAlphas.data(), p_volumeBuffer, weights.data() );
+
+    // same normalization as the voxel-driven back projection
+    std::transform( std::execution::par_unseq, p_volumeBuffer, p_volumeBuffer + weights.size(), weights.cbegin(), p_volumeBuffer, []( float p_value, float p_weight ) {
+        return p_weight > backProjectionFloatTolerance ? p_value / p_weight : 0.F;
+    } );
+}
+
+void PerformMatchedBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    std::vector<float> raysInverseWeights( p_geometry.GetProjectionsPixelsNumber() );
+    ComputeRaysInverseWeights( p_geometry, raysInverseWeights.data() );
+    std::vector<Float2> raysAlphas( raysInverseWeights.size() );
+    ComputeRaysAlphas( p_geometry, raysAlphas.data() );
+    std::vector<float> raysValues( raysInverseWeights.size() );
+    PerformMatchedBackProjectionWithWeights( p_projectionsBuffer, p_geometry, raysInverseWeights.data(), raysAlphas.data(), raysValues.data(), p_volumeBuffer );
+}
+
+void ComputeVoxelsWeights( const ProjectorGeometry & p_geometry, float * p_voxelsWeights )
+{
+    // scattering rays of value 1 sums their weights
+    const std::vector<float> ones( p_geometry.GetProjectionsPixelsNumber(), 1.F );
+    std::vector<Float2> raysAlphas( ones.size() );
+    ComputeRaysAlphas( p_geometry, raysAlphas.data() );
+    ScatterRaysBySlabs( ones.data(), p_geometry, raysAlphas.data(), p_voxelsWeights, nullptr );
+}
+
+void ComputeRaysAlphas( const ProjectorGeometry & p_geometry, Float2 * p_raysAlphas )
+{
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto volumeHalfLength = VolumeHalfLength( p_geometry.volumeDimension );
+
+    auto rowsIndices = IndexRange{ projectionsDimension.z * projectionsDimension.y };
+    auto rowAlphas = [&]( int p_rowIndex ) {
+        const auto projectionIndex = p_rowIndex / projectionsDimension.y;
+        const auto yProjPixel = p_rowIndex % projectionsDimension.y;
+        auto * rowRaysAlphas = p_raysAlphas + static_cast<size_t>( p_rowIndex ) * projectionsDimension.x;
+        for( auto xProjPixel{ 0 }; xProjPixel < projectionsDimension.x; xProjPixel++ )
+        {
+            const auto ray = ComputeRay( p_geometry, projectionIndex, xProjPixel, yProjPixel );
+            auto & alphas = rowRaysAlphas[xProjPixel];
+            if( !FindEntryAndExitAlphas( ray, volumeHalfLength, alphas.x, alphas.y ) )
+            {
+                alphas = Float2{};
+            }
+        }
+    };
+    std::for_each( std::execution::par, rowsIndices.begin(), rowsIndices.end(), rowAlphas );
+}
+
+void ComputeRaysInverseWeights( const ProjectorGeometry & p_geometry, float * p_raysInverseWeights )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto volumeHalfLength = VolumeHalfLength( volumeDimension );
+
+    auto rowsIndices = IndexRange{ projectionsDimension.z * projectionsDimension.y };
+    auto rowWeighter = [&]( int p_rowIndex ) {
+        const auto projectionIndex = p_rowIndex / projectionsDimension.y;
+        const auto yProjPixel = p_rowIndex % projectionsDimension.y;
+        const auto rowOffset = static_cast<size_t>( p_rowIndex ) * projectionsDimension.x;
+        for( auto xProjPixel{ 0 }; xProjPixel < projectionsDimension.x; xProjPixel++ )
+        {
+            p_raysInverseWeights[rowOffset + xProjPixel] = 0.F;
+
+            const auto ray = ComputeRay( p_geometry, projectionIndex, xProjPixel, yProjPixel );
+            float alphaMin;
+            float alphaMax;
+            if( !FindEntryAndExitAlphas( ray, volumeHalfLength, alphaMin, alphaMax ) )
+            {
+                continue;
+            }
+            auto totalWeight{ 0.F };
+            TraverseRay( ray, volumeDimension, volumeHalfLength, alphaMin, alphaMax, [&]( int, float p_weight ) { totalWeight += p_weight; } );
+            if( totalWeight > projectionFloatTolerance )
+            {
+                p_raysInverseWeights[rowOffset + xProjPixel] = 1.F / totalWeight;
+            }
+        }
+    };
+    std::for_each( std::execution::par, rowsIndices.begin(), rowsIndices.end(), rowWeighter );
+}
+
+void PerformIncrementalBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_voxelsWeights, const Float2 * p_raysAlphas, float * p_volumeBuffer )
+{
+    ScatterRaysBySlabs( p_projectionsBuffer, p_geometry, p_raysAlphas, p_volumeBuffer, nullptr );
+    std::transform( std::execution::par_unseq, p_volumeBuffer, p_volumeBuffer + p_geometry.GetVolumeVoxelsNumber(), p_voxelsWeights, p_volumeBuffer, []( float p_value, float p_weight ) {
+        return p_weight > backProjectionFloatTolerance ? p_value / p_weight : 0.F;
+    } );
+}
+
+void PerformMatchedBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, const Float2 * p_raysAlphas, float * p_raysValuesBuffer, float * p_volumeBuffer )
+{
+    // pass 1: each pixel value is divided by the total weight of its ray, the normalization of PerformIncrementalProjection
+    std::transform( std::execution::par_unseq, p_projectionsBuffer, p_projectionsBuffer + p_geometry.GetProjectionsPixelsNumber(), p_raysInverseWeights, p_raysValuesBuffer, std::multiplies<float>() );
+
+    // pass 2: plain scatter, without any voxel normalization
+    ScatterRaysBySlabs( p_raysValuesBuffer, p_geometry, p_raysAlphas, p_volumeBuffer, nullptr );
+}
+}    // namespace cpuprojector
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+// Host implementations of the projectors, multithreaded with the standard parallel algorithms.
+// As for the CUDA kernels, the coordinate system is the one centered in C, the pave volume center,
+// and buffers are x-fastest (volume: x, y, z ; projections: x, y, projection index)
+namespace cpuprojector
+{
+// Same ray-driven scheme as CudaPerformProjection: the ray from the source to each detector pixel center is cut
+// by the voxel planes (FindProjectionAlphas_d), and the projected value is the length weighted mean of the crossed voxels.
+// Parallelized over the detector rows of all the projections
+void PerformProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer );
+
+// Same voxel-driven scheme as CudaPerformBackProjection: for each voxel and each projection, the detector pixels around
+// the voxel center shadow are weighted by the length of their ray inside the voxel.
+// Parallelized over the volume rows
+void PerformBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+
+// Same values as PerformProjection, but the rays are walked with the incremental traversal of RayTraversal.h
+// (no alphas buffer, no merge, no cap on the number of crossed voxels).
+// Parallelized over the detector rows of all the projections
+void PerformIncrementalProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer );
+
+// Ray-driven back projection with the incremental traversal: each detector pixel scatters its value, weighted by the length
+// of its ray inside the voxel, to the voxels it crosses; each voxel is then normalized by its total weight.
+// The weights are the ones of PerformBackProjection, without its limited pixel neighborhood.
+// Parallelized over slabs of slices, each slab being owned by a single task
+void PerformIncrementalBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+
+// Exact transpose of PerformIncrementalProjection: each pixel value is divided by the total weight of its ray (the forward
+// normalization) then scattered, weighted by the ray length inside the voxels, without any voxel normalization,
+// so that <A x, y> = <x, A^T y>. Parallelized over slabs of slices, each slab being owned by a single task
+void PerformMatchedBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+
+// Geometry-only parts of the ray-driven back projections, to be computed once and reused (see ProjectorPlan).
+// Total weight of the rays crossing each voxel, the normalization of PerformIncrementalBackProjection
+void ComputeVoxelsWeights( const ProjectorGeometry & p_geometry, float * p_voxelsWeights );
+// Inverse of the total weight of each ray inside the volume (0 for the rays missing it), the normalization of PerformIncrementalProjection
+void ComputeRaysInverseWeights( const ProjectorGeometry & p_geometry, float * p_raysInverseWeights );
+// Entry and exit alphas (x, y) of each ray in the volume, equal for the rays missing it: the setup of the rays scattered
+// by the back projections, shared by all the slabs
+void ComputeRaysAlphas( const ProjectorGeometry & p_geometry, Float2 * p_raysAlphas );
+
+// PerformIncrementalBackProjection with the voxels weights of ComputeVoxelsWeights and the rays alphas of ComputeRaysAlphas
+void PerformIncrementalBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_voxelsWeights, const Float2 * p_raysAlphas, float * p_volumeBuffer );
+// PerformMatchedBackProjection with the rays inverse weights of ComputeRaysInverseWeights and the rays alphas of ComputeRaysAlphas,
+// p_raysValuesBuffer being a work buffer of the projections size
+void PerformMatchedBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, const Float2 * p_raysAlphas, float * p_raysValuesBuffer, float * p_volumeBuffer );
+}    // namespace cpuprojector
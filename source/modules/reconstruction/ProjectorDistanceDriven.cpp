@@ -0,0 +1,138 @@
+#include "modules/reconstruction/ProjectorDistanceDriven.h"
+
+#include "modules/reconstruction/SlicesTables.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <functional>
+#include <numeric>
+
+namespace    // anonymous namespace
+{
+using namespace cpuprojector;
+
+constexpr auto distanceDrivenFloatTolerance = 0.000001F;
+
+// Builds the x and y overlap tables of the slice p_sliceIndex seen from the source of p_projectionIndex:
+// the slice center plane is magnified by (zDetector - zSource) / (zSlice - zSource) on the detector plane
+// returns false if the slice is not between the source and the detector
+bool ComputeSliceTables( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_sliceIndex, OverlapTable & p_xTable, OverlapTable & p_yTable )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & spacing = p_geometry.volumeVoxelsSpacing;
+    const auto & source = p_geometry.sourcesPositions[p_projectionIndex];
+    const auto & origin = p_geometry.projectionsOriginInWorld[p_projectionIndex];
+
+    const auto zSlice = ( static_cast<float>( p_sliceIndex ) + 0.5F - static_cast<float>( volumeDimension.z ) / 2.F ) * spacing.z;
+    if( std::fabs( zSlice - source.z ) <= distanceDrivenFloatTolerance )
+    {
+        return false;
+    }
+    const auto magnification = ( origin.z - source.z ) / ( zSlice - source.z );
+    if( magnification <= distanceDrivenFloatTolerance )
+    {
+        return false;
+    }
+
+    const auto xVoxelsStart = source.x + ( -static_cast<float>( volumeDimension.x ) * spacing.x / 2.F - source.x ) * magnification;
+    const auto yVoxelsStart = source.y + ( -static_cast<float>( volumeDimension.y ) * spacing.y / 2.F - source.y ) * magnification;
+    ComputeOverlapTable( xVoxelsStart, spacing.x * magnification, volumeDimension.x, origin.x, p_geometry.projectionsPixelsSpacing.x, p_geometry.projectionsDimension.x, p_xTable );
+    ComputeOverlapTable( yVoxelsStart, spacing.y * magnification, volumeDimension.y, origin.y, p_geometry.projectionsPixelsSpacing.y, p_geometry.projectionsDimension.y, p_yTable );
+    return !p_xTable.entries.empty() && !p_yTable.entries.empty();
+}
+}    // end of anonymous namespace
+
+namespace cpuprojector
+{
+void ComputeOverlapTable( float p_voxelsStart, float p_voxelWidth, int p_nbVoxels, float p_pixelsStart, float p_pixelWidth, int p_nbPixels, OverlapTable & p_table )
+{
+    p_table.entries.clear();
+    p_table.pixelsOffsets.assign( std::max( 0, p_nbPixels ) + 1, 0 );
+    p_table.voxelsOffsets.assign( std::max( 0, p_nbVoxels ) + 1, 0 );
+
+    // first voxel and first pixel which may overlap
+    auto voxel = std::max( 0, static_cast<int>( std::floor( ( p_pixelsStart - p_voxelsStart ) / p_voxelWidth ) ) );
+    auto pixel = std::max( 0, static_cast<int>( std::floor( ( p_voxelsStart - p_pixelsStart ) / p_pixelWidth ) ) );
+    while( voxel < p_nbVoxels && pixel < p_nbPixels )
+    {
+        const auto voxelEnd = p_voxelsStart + static_cast<float>( voxel + 1 ) * p_voxelWidth;
+        const auto pixelEnd = p_pixelsStart + static_cast<float>( pixel + 1 ) * p_pixelWidth;
+        const auto overlapStart = std::max( p_voxelsStart + static_cast<float>( voxel ) * p_voxelWidth, p_pixelsStart + static_cast<float>( pixel ) * p_pixelWidth );
+        const auto overlap = std::min( voxelEnd, pixelEnd ) - overlapStart;
+        if( overlap > distanceDrivenFloatTolerance * p_pixelWidth )
+        {
+            p_table.entries.push_back( OverlapEntry{ pixel, voxel, overlap / p_pixelWidth } );
+            p_table.pixelsOffsets[pixel + 1]++;
+            p_table.voxelsOffsets[voxel + 1]++;
+        }
+        // the sweep moves the boundary reached first
+        if( voxelEnd < pixelEnd )
+        {
+            voxel++;
+        }
+        else
+        {
+            pixel++;
+        }
+    }
+    std::partial_sum( p_table.pixelsOffsets.begin(), p_table.pixelsOffsets.end(), p_table.pixelsOffsets.begin() );
+    std::partial_sum( p_table.voxelsOffsets.begin(), p_table.voxelsOffsets.end(), p_table.voxelsOffsets.begin() );
+}
+
+void ComputeDistanceDrivenRaysInverseWeights( const ProjectorGeometry & p_geometry, float * p_raysInverseWeights )
+{
+    ProjectSlicesTables( nullptr, p_geometry, ComputeSliceTables, p_raysInverseWeights );
+    std::transform( std::execution::par_unseq, p_raysInverseWeights, p_raysInverseWeights + p_geometry.GetProjectionsPixelsNumber(), p_raysInverseWeights, []( float p_weight ) {
+        return p_weight > distanceDrivenFloatTolerance ? 1.F / p_weight : 0.F;
+    } );
+}
+
+void ComputeDistanceDrivenVoxelsWeights( const ProjectorGeometry & p_geometry, float * p_voxelsWeights )
+{
+    BackProjectSlicesTables( nullptr, p_geometry, ComputeSliceTables, p_voxelsWeights );
+}
+
+void PerformDistanceDrivenProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer )
+{
+    std::vector<float> raysInverseWeights( p_geometry.GetProjectionsPixelsNumber() );
+    ComputeDistanceDrivenRaysInverseWeights( p_geometry, raysInverseWeights.data() );
+    PerformDistanceDrivenProjectionWithWeights( p_volumeBuffer, p_geometry, raysInverseWeights.data(), p_projectionsBuffer );
+}
+
+void PerformDistanceDrivenBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    std::vector<float> voxelsWeights( p_geometry.GetVolumeVoxelsNumber() );
+    ComputeDistanceDrivenVoxelsWeights( p_geometry, voxelsWeights.data() );
+    PerformDistanceDrivenBackProjectionWithWeights( p_projectionsBuffer, p_geometry, voxelsWeights.data(), p_volumeBuffer );
+}
+
+void PerformDistanceDrivenMatchedBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    std::vector<float> raysInverseWeights( p_geometry.GetProjectionsPixelsNumber() );
+    ComputeDistanceDrivenRaysInverseWeights( p_geometry, raysInverseWeights.data() );
+    std::vector<float> raysValues( raysInverseWeights.size() );
+    PerformDistanceDrivenMatchedBackProjectionWithWeights( p_projectionsBuffer, p_geometry, raysInverseWeights.data(), raysValues.data(), p_volumeBuffer );
+}
+
+void PerformDistanceDrivenProjectionWithWeights( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_projectionsBuffer )
+{
+    ProjectSlicesTables( p_volumeBuffer, p_geometry, ComputeSliceTables, p_projectionsBuffer );
+    std::transform( std::execution::par_unseq, p_projectionsBuffer, p_projectionsBuffer + p_geometry.GetProjectionsPixelsNumber(), p_raysInverseWeights, p_projectionsBuffer, std::multiplies<float>() );
+}
+
+void PerformDistanceDrivenBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_voxelsWeights, float * p_volumeBuffer )
+{
+    BackProjectSlicesTables( p_projectionsBuffer, p_geometry, ComputeSliceTables, p_volumeBuffer );
+    std::transform( std::execution::par_unseq, p_volumeBuffer, p_volumeBuffer + p_geometry.GetVolumeVoxelsNumber(), p_voxelsWeights, p_volumeBuffer, []( float p_value, float p_weight ) {
+        return p_weight > distanceDrivenFloatTolerance ? p_value / p_weight : 0.F;
+    } );
+}
+
+void PerformDistanceDrivenMatchedBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_raysValuesBuffer, float * p_volumeBuffer )
+{
+    // the projection normalization first, then the plain transpose of the overlaps
+    std::transform( std::execution::par_unseq, p_projectionsBuffer, p_projectionsBuffer + p_geometry.GetProjectionsPixelsNumber(), p_raysInverseWeights, p_raysValuesBuffer, std::multiplies<float>() );
+    BackProjectSlicesTables( p_raysValuesBuffer, p_geometry, ComputeSliceTables, p_volumeBuffer );
+}
+}    // namespace cpuprojector
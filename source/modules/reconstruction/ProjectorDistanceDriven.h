@@ -0,0 +1,58 @@
+#pragma once
+
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include <vector>
+
+// Distance-driven host projectors.
+// The detector and the volume slices are parallel (detectors at a common z), so a slice is seen from a source through
+// a plain magnification: the voxel boundaries of the slice center plane are mapped onto the detector plane, and the
+// voxel/pixel weights are the 1D overlaps of the mapped voxels and of the pixels, in x and in y separately.
+// With W the matrix of these weights, the projection is D_r W (a projected pixel is the weighted mean of its voxels, as for
+// the other projectors) and the back projection is the exact transpose W^T followed by the diagonal D_v (a back projected
+// voxel is the weighted mean of its pixels), D_r and D_v being the inverses of the rays and of the voxels total weights.
+// The back projection is then not the adjoint of the projection: the adjoint W^T D_r is the matched back projection
+// (CpuDistanceDrivenMatched backend).
+namespace cpuprojector
+{
+// One overlap between a pixel and a mapped voxel, weight being the covered fraction of the pixel
+struct OverlapEntry
+{
+    int pixel{ 0 };
+    int voxel{ 0 };
+    float weight{ 0.F };
+};
+
+// Overlaps of one axis, ordered both by pixel and by voxel
+struct OverlapTable
+{
+    std::vector<OverlapEntry> entries;
+    std::vector<int> pixelsOffsets;    // entries of pixel i are [pixelsOffsets[i], pixelsOffsets[i + 1][
+    std::vector<int> voxelsOffsets;    // entries of voxel j are [voxelsOffsets[j], voxelsOffsets[j + 1][
+};
+
+// Overlaps of p_nbVoxels voxels starting at p_voxelsStart with p_nbPixels pixels starting at p_pixelsStart,
+// both expressed on the detector plane, by a single merge-like sweep of the two sets of boundaries
+void ComputeOverlapTable( float p_voxelsStart, float p_voxelWidth, int p_nbVoxels, float p_pixelsStart, float p_pixelWidth, int p_nbPixels, OverlapTable & p_table );
+
+// D_r W. Parallelized over the slices (footprint tables) then over the detector rows, projection after projection
+void PerformDistanceDrivenProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer );
+
+// D_v W^T. Parallelized over the volume slices, each slice being owned by a single task
+void PerformDistanceDrivenBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+
+// W^T D_r, exact transpose of PerformDistanceDrivenProjection: <A x, y> = <x, A^T y>
+void PerformDistanceDrivenMatchedBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+
+// Geometry-only diagonals, to be computed once and reused (see ProjectorPlan).
+// Inverse of the total weight of each ray (0 for the rays seeing no voxel): D_r
+void ComputeDistanceDrivenRaysInverseWeights( const ProjectorGeometry & p_geometry, float * p_raysInverseWeights );
+// Total weight of each voxel: inverse of D_v
+void ComputeDistanceDrivenVoxelsWeights( const ProjectorGeometry & p_geometry, float * p_voxelsWeights );
+
+// Same projectors with the diagonals computed above
+void PerformDistanceDrivenProjectionWithWeights( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_projectionsBuffer );
+void PerformDistanceDrivenBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_voxelsWeights, float * p_volumeBuffer );
+// p_raysValuesBuffer being a work buffer of the projections size, receiving D_r p_projectionsBuffer
+void PerformDistanceDrivenMatchedBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_raysValuesBuffer, float * p_volumeBuffer );
+}    // namespace cpuprojector
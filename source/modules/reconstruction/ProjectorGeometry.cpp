@@ -0,0 +1,106 @@
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include "modules/geometry/TomoGeometry.h"
+
+#include <algorithm>
+
+namespace    // anonymous namespace
+{
+bool AreEqual( const Int3 & p_first, const Int3 & p_second )
+{
+    return p_first.x == p_second.x && p_first.y == p_second.y && p_first.z == p_second.z;
+}
+
+bool AreEqual( const Float2 & p_first, const Float2 & p_second )
+{
+    return p_first.x == p_second.x && p_first.y == p_second.y;
+}
+
+bool AreEqual( const Float3 & p_first, const Float3 & p_second )
+{
+    return p_first.x == p_second.x && p_first.y == p_second.y && p_first.z == p_second.z;
+}
+
+bool AreEqual( const std::vector<Float3> & p_first, const std::vector<Float3> & p_second )
+{
+    return p_first.size() == p_second.size()
+           && std::equal( p_first.cbegin(), p_first.cend(), p_second.cbegin(), []( const Float3 & p_a, const Float3 & p_b ) { return AreEqual( p_a, p_b ); } );
+}
+}    // end of anonymous namespace
+
+ProjectorGeometry ProjectorGeometry::FromTomoGeometry( TomoGeometry const * p_tomoGeometry )
+{
+    ProjectorGeometry geometry;
+    if( p_tomoGeometry == nullptr )
+    {
+        return geometry;
+    }
+
+    auto volumeSize = p_tomoGeometry->volumeSize3D();
+    geometry.volumeDimension.x = volumeSize.x;
+    geometry.volumeDimension.y = volumeSize.y;
+    geometry.volumeDimension.z = volumeSize.z;
+
+    auto voxelSpacing = p_tomoGeometry->volumeVoxelSpacing();
+    geometry.volumeVoxelsSpacing.x = voxelSpacing.x;
+    geometry.volumeVoxelsSpacing.y = voxelSpacing.y;
+    geometry.volumeVoxelsSpacing.z = voxelSpacing.z;
+
+    auto projectionsSize = p_tomoGeometry->projectionsRoisSize();
+    geometry.projectionsDimension.x = projectionsSize.x;
+    geometry.projectionsDimension.y = projectionsSize.y;
+    geometry.projectionsDimension.z = p_tomoGeometry->nbProjectionsRois();
+
+    auto pixelSpacing = p_tomoGeometry->projectionsPixelSpacing();
+    geometry.projectionsPixelsSpacing.x = pixelSpacing.x;
+    geometry.projectionsPixelsSpacing.y = pixelSpacing.y;
+
+    // accessors return copies: retrieve them once
+    auto projectionsBottomLeftPositions = p_tomoGeometry->projectionsRoisBottomLeftPositions();
+    auto detectorsZ = p_tomoGeometry->detectorsZCommonPosition();
+    geometry.projectionsOriginInWorld.resize( geometry.projectionsDimension.z );
+    for( auto projectionIndex{ 0 }; projectionIndex < geometry.projectionsDimension.z; projectionIndex++ )
+    {
+        geometry.projectionsOriginInWorld[projectionIndex].x = projectionsBottomLeftPositions.at( projectionIndex ).x;
+        geometry.projectionsOriginInWorld[projectionIndex].y = projectionsBottomLeftPositions.at( projectionIndex ).y;
+        geometry.projectionsOriginInWorld[projectionIndex].z = detectorsZ;
+    }
+
+    auto sourcesYPositions = p_tomoGeometry->sourcesYPositions();
+    auto sourcesX = p_tomoGeometry->sourcesXCommonPosition();
+    auto sourcesZ = p_tomoGeometry->sourcesZCommonPosition();
+    geometry.sourcesPositions.resize( geometry.projectionsDimension.z );
+    for( auto projectionIndex{ 0 }; projectionIndex < geometry.projectionsDimension.z; projectionIndex++ )
+    {
+        geometry.sourcesPositions[projectionIndex].x = sourcesX;
+        geometry.sourcesPositions[projectionIndex].y = sourcesYPositions.at( projectionIndex );
+        geometry.sourcesPositions[projectionIndex].z = sourcesZ;
+    }
+
+    return geometry;
+}
+
+ProjectorGeometry ProjectorGeometry::ExtractProjections( const std::vector<int> & p_projectionsIndices ) const
+{
+    ProjectorGeometry geometry;
+    geometry.volumeDimension = volumeDimension;
+    geometry.volumeVoxelsSpacing = volumeVoxelsSpacing;
+    geometry.projectionsDimension = projectionsDimension;
+    geometry.projectionsDimension.z = static_cast<int>( p_projectionsIndices.size() );
+    geometry.projectionsPixelsSpacing = projectionsPixelsSpacing;
+    geometry.projectionsOriginInWorld.reserve( p_projectionsIndices.size() );
+    geometry.sourcesPositions.reserve( p_projectionsIndices.size() );
+    for( auto projectionIndex : p_projectionsIndices )
+    {
+        geometry.projectionsOriginInWorld.push_back( projectionsOriginInWorld[projectionIndex] );
+        geometry.sourcesPositions.push_back( sourcesPositions[projectionIndex] );
+    }
+    return geometry;
+}
+
+bool ProjectorGeometry::IsSameAs( const ProjectorGeometry & p_other ) const
+{
+    return AreEqual( volumeDimension, p_other.volumeDimension ) && AreEqual( volumeVoxelsSpacing, p_other.volumeVoxelsSpacing )
+           && AreEqual( projectionsDimension, p_other.projectionsDimension ) && AreEqual( projectionsPixelsSpacing, p_other.projectionsPixelsSpacing )
+           && AreEqual( projectionsOriginInWorld, p_other.projectionsOriginInWorld ) && AreEqual( sourcesPositions, p_other.sourcesPositions );
+}
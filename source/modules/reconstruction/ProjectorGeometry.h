@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+class TomoGeometry;
+
+// Plain (CUDA-like) vector types used by the host projector kernels
+struct Int3
+{
+    int x{ 0 };
+    int y{ 0 };
+    int z{ 0 };
+};
+
+struct Float2
+{
+    float x{ 0.F };
+    float y{ 0.F };
+};
+
+struct Float3
+{
+    float x{ 0.F };
+    float y{ 0.F };
+    float z{ 0.F };
+};
+
+// Flat copy of the TomoGeometry features needed by the projectors.
+// It mirrors the arguments given to CudaPerformProjection and CudaPerformBackProjection
+struct ProjectorGeometry
+{
+    Int3 volumeDimension;
+    Float3 volumeVoxelsSpacing;
+
+    Int3 projectionsDimension;    // z is the number of projections
+    Float2 projectionsPixelsSpacing;
+
+    std::vector<Float3> projectionsOriginInWorld;    // bottom left corner of each projection ROI
+    std::vector<Float3> sourcesPositions;
+
+    int GetVolumeVoxelsNumber() const { return volumeDimension.x * volumeDimension.y * volumeDimension.z; }
+    int GetProjectionsPixelsNumber() const { return projectionsDimension.x * projectionsDimension.y * projectionsDimension.z; }
+
+    // Same geometry restricted to the given projections, in the given order (indices are not checked)
+    ProjectorGeometry ExtractProjections( const std::vector<int> & p_projectionsIndices ) const;
+    // exact comparison of every feature, used as a key by the projector caches
+    bool IsSameAs( const ProjectorGeometry & p_other ) const;
+
+    static ProjectorGeometry FromTomoGeometry( TomoGeometry const * p_tomoGeometry );
+};
@@ -0,0 +1,199 @@
+#include "modules/reconstruction/ProjectorHomography.h"
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+#include "modules/reconstruction/SimdTargets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <vector>
+
+namespace    // anonymous namespace
+{
+using namespace cpuprojector;
+
+constexpr auto homographyFloatTolerance = 0.000001F;
+
+// Detector row resampled along a voxel row: both detector rows around the shadow of the voxel row, and the weight of the second one
+struct DetectorRowsPair
+{
+    const float * firstRow;
+    const float * secondRow;
+    float secondRowWeight;
+    int nbPixels;
+};
+
+// Bilinear sample of the pair of detector rows at p_xPixel, which must be in [0, nbPixels - 1]
+inline float SampleRows( const DetectorRowsPair & p_rows, float p_xPixel )
+{
+    const auto firstPixel = static_cast<int>( p_xPixel );
+    const auto secondPixel = std::min( firstPixel + 1, p_rows.nbPixels - 1 );
+    const auto secondPixelWeight = p_xPixel - static_cast<float>( firstPixel );
+    const auto first = p_rows.firstRow[firstPixel] + secondPixelWeight * ( p_rows.firstRow[secondPixel] - p_rows.firstRow[firstPixel] );
+    const auto second = p_rows.secondRow[firstPixel] + secondPixelWeight * ( p_rows.secondRow[secondPixel] - p_rows.secondRow[firstPixel] );
+    return first + p_rows.secondRowWeight * ( second - first );
+}
+
+// Adds the samples at xScale * i + xShift to p_volumeRow[i] for i in [p_xBegin, p_xEnd[
+void AccumulateRow( const DetectorRowsPair & p_rows, float p_xScale, float p_xShift, int p_xBegin, int p_xEnd, float * p_volumeRow )
+{
+    const auto lastPixel = static_cast<float>( p_rows.nbPixels - 1 );
+    auto xPixel = p_xScale * static_cast<float>( p_xBegin ) + p_xShift;
+    for( auto xVoxel{ p_xBegin }; xVoxel < p_xEnd; xVoxel++ )
+    {
+        p_volumeRow[xVoxel] += SampleRows( p_rows, std::clamp( xPixel, 0.F, lastPixel ) );
+        xPixel += p_xScale;
+    }
+}
+
+#ifdef TOMO_WITH_X86_SIMD
+// AccumulateRow with 8 voxels per step
+TOMO_TARGET_AVX2 void AccumulateRowAvx2( const DetectorRowsPair & p_rows, float p_xScale, float p_xShift, int p_xBegin, int p_xEnd, float * p_volumeRow )
+{
+    constexpr auto width{ 8 };
+    const auto zero = _mm256_setzero_ps();
+    const auto lastPixel = _mm256_set1_ps( static_cast<float>( p_rows.nbPixels - 1 ) );
+    const auto lastPixelIndex = _mm256_set1_epi32( p_rows.nbPixels - 1 );
+    const auto one = _mm256_set1_epi32( 1 );
+    const auto secondRowWeight = _mm256_set1_ps( p_rows.secondRowWeight );
+    const auto step = _mm256_set1_ps( p_xScale * width );
+
+    auto xPixel = _mm256_fmadd_ps( _mm256_set1_ps( p_xScale ), _mm256_setr_ps( 0.F, 1.F, 2.F, 3.F, 4.F, 5.F, 6.F, 7.F ), _mm256_set1_ps( p_xScale * static_cast<float>( p_xBegin ) + p_xShift ) );
+    auto xVoxel{ p_xBegin };
+    for( ; xVoxel + width <= p_xEnd; xVoxel += width )
+    {
+        const auto clampedPixel = _mm256_min_ps( _mm256_max_ps( xPixel, zero ), lastPixel );
+        const auto firstPixel = _mm256_cvttps_epi32( clampedPixel );
+        const auto secondPixel = _mm256_min_epi32( _mm256_add_epi32( firstPixel, one ), lastPixelIndex );
+        const auto secondPixelWeight = _mm256_sub_ps( clampedPixel, _mm256_cvtepi32_ps( firstPixel ) );
+
+        const auto firstRowFirst = _mm256_i32gather_ps( p_rows.firstRow, firstPixel, 4 );
+        const auto firstRowSecond = _mm256_i32gather_ps( p_rows.firstRow, secondPixel, 4 );
+        const auto secondRowFirst = _mm256_i32gather_ps( p_rows.secondRow, firstPixel, 4 );
+        const auto secondRowSecond = _mm256_i32gather_ps( p_rows.secondRow, secondPixel, 4 );
+        const auto first = _mm256_fmadd_ps( secondPixelWeight, _mm256_sub_ps( firstRowSecond, firstRowFirst ), firstRowFirst );
+        const auto second = _mm256_fmadd_ps( secondPixelWeight, _mm256_sub_ps( secondRowSecond, secondRowFirst ), secondRowFirst );
+        const auto sample = _mm256_fmadd_ps( secondRowWeight, _mm256_sub_ps( second, first ), first );
+
+        _mm256_storeu_ps( p_volumeRow + xVoxel, _mm256_add_ps( _mm256_loadu_ps( p_volumeRow + xVoxel ), sample ) );
+        xPixel = _mm256_add_ps( xPixel, step );
+    }
+    AccumulateRow( p_rows, p_xScale, p_xShift, xVoxel, p_xEnd, p_volumeRow );
+}
+#endif
+
+// Range [p_begin, p_end[ of the voxels whose shadow p_scale * i + p_shift is on a detector of p_nbPixels pixels
+// (pixel borders included, the samples of the outer half pixels being clamped)
+void FindSeenVoxels( float p_scale, float p_shift, int p_nbVoxels, int p_nbPixels, int & p_begin, int & p_end )
+{
+    const auto lowerBound = ( -0.5F - p_shift ) / p_scale;
+    const auto upperBound = ( static_cast<float>( p_nbPixels ) - 0.5F - p_shift ) / p_scale;
+    p_begin = std::clamp( static_cast<int>( std::ceil( std::min( lowerBound, upperBound ) ) ), 0, p_nbVoxels );
+    p_end = std::clamp( static_cast<int>( std::floor( std::max( lowerBound, upperBound ) ) ) + 1, p_begin, p_nbVoxels );
+}
+}    // end of anonymous namespace
+
+namespace cpuprojector
+{
+bool ComputeSliceToProjectionTransform( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_sliceIndex, SliceToProjectionTransform & p_transform )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & spacing = p_geometry.volumeVoxelsSpacing;
+    const auto & pixelSpacing = p_geometry.projectionsPixelsSpacing;
+    const auto & source = p_geometry.sourcesPositions[p_projectionIndex];
+    const auto & origin = p_geometry.projectionsOriginInWorld[p_projectionIndex];
+
+    const auto zSlice = ( static_cast<float>( p_sliceIndex ) + 0.5F - static_cast<float>( volumeDimension.z ) / 2.F ) * spacing.z;
+    if( std::fabs( zSlice - source.z ) <= homographyFloatTolerance )
+    {
+        return false;
+    }
+    const auto magnification = ( origin.z - source.z ) / ( zSlice - source.z );
+    if( magnification <= homographyFloatTolerance )
+    {
+        return false;
+    }
+
+    // center of the first voxel of the slice, and its shadow on the detector
+    const auto xFirstVoxel = ( 0.5F - static_cast<float>( volumeDimension.x ) / 2.F ) * spacing.x;
+    const auto yFirstVoxel = ( 0.5F - static_cast<float>( volumeDimension.y ) / 2.F ) * spacing.y;
+    p_transform.xScale = spacing.x * magnification / pixelSpacing.x;
+    p_transform.yScale = spacing.y * magnification / pixelSpacing.y;
+    p_transform.xShift = ( source.x + ( xFirstVoxel - source.x ) * magnification - origin.x ) / pixelSpacing.x - 0.5F;
+    p_transform.yShift = ( source.y + ( yFirstVoxel - source.y ) * magnification - origin.y ) / pixelSpacing.y - 0.5F;
+    return true;
+}
+
+void PerformHomographyBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto sliceSize = static_cast<size_t>( volumeDimension.x ) * volumeDimension.y;
+    const auto projectionSize = static_cast<size_t>( projectionsDimension.x ) * projectionsDimension.y;
+    static const auto useAvx2 = DetectSimdLevel() >= SimdLevel::Avx2;
+
+    // one task per slice: the slice is only written by its task
+    auto slicesIndices = IndexRange{ volumeDimension.z };
+    auto sliceBackProjector = [&]( int p_sliceIndex ) {
+        auto * sliceBuffer = p_volumeBuffer + p_sliceIndex * sliceSize;
+        std::fill( sliceBuffer, sliceBuffer + sliceSize, 0.F );
+        // the views count of the slice, grown once per worker thread
+        thread_local std::vector<unsigned short> nbViews;
+        nbViews.assign( sliceSize, 0 );
+
+        for( auto projectionIndex{ 0 }; projectionIndex < projectionsDimension.z; projectionIndex++ )
+        {
+            SliceToProjectionTransform transform;
+            if( !ComputeSliceToProjectionTransform( p_geometry, projectionIndex, p_sliceIndex, transform ) )
+            {
+                continue;
+            }
+            int xBegin;
+            int xEnd;
+            int yBegin;
+            int yEnd;
+            FindSeenVoxels( transform.xScale, transform.xShift, volumeDimension.x, projectionsDimension.x, xBegin, xEnd );
+            FindSeenVoxels( transform.yScale, transform.yShift, volumeDimension.y, projectionsDimension.y, yBegin, yEnd );
+            if( xBegin >= xEnd )
+            {
+                continue;
+            }
+
+            const auto * projectionBuffer = p_projectionsBuffer + projectionIndex * projectionSize;
+            const auto lastRow = static_cast<float>( projectionsDimension.y - 1 );
+            for( auto yVoxel{ yBegin }; yVoxel < yEnd; yVoxel++ )
+            {
+                // a voxel row is seen on a single pair of detector rows
+                const auto yPixel = std::clamp( transform.yScale * static_cast<float>( yVoxel ) + transform.yShift, 0.F, lastRow );
+                const auto firstRow = static_cast<int>( yPixel );
+                const auto secondRow = std::min( firstRow + 1, projectionsDimension.y - 1 );
+                const DetectorRowsPair rows{ projectionBuffer + static_cast<size_t>( firstRow ) * projectionsDimension.x,
+                                             projectionBuffer + static_cast<size_t>( secondRow ) * projectionsDimension.x,
+                                             yPixel - static_cast<float>( firstRow ),
+                                             projectionsDimension.x };
+
+                auto * volumeRow = sliceBuffer + static_cast<size_t>( yVoxel ) * volumeDimension.x;
+#ifdef TOMO_WITH_X86_SIMD
+                if( useAvx2 )
+                {
+                    AccumulateRowAvx2( rows, transform.xScale, transform.xShift, xBegin, xEnd, volumeRow );
+                }
+                else
+#endif
+                {
+                    AccumulateRow( rows, transform.xScale, transform.xShift, xBegin, xEnd, volumeRow );
+                }
+                auto * nbViewsRow = nbViews.data() + static_cast<size_t>( yVoxel ) * volumeDimension.x;
+                std::for_each( nbViewsRow + xBegin, nbViewsRow + xEnd, []( unsigned short & p_nbViews ) { p_nbViews++; } );
+            }
+        }
+
+        for( auto voxelIndex{ 0 }; voxelIndex < static_cast<int>( sliceSize ); voxelIndex++ )
+        {
+            sliceBuffer[voxelIndex] = nbViews[voxelIndex] > 0 ? sliceBuffer[voxelIndex] / static_cast<float>( nbViews[voxelIndex] ) : 0.F;
+        }
+    };
+    std::for_each( std::execution::par, slicesIndices.begin(), slicesIndices.end(), sliceBackProjector );
+}
+}    // namespace cpuprojector
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+// Slice-wise homography back projection.
+// The detectors share the same z and each reconstruction slice is a z plane, so a slice is mapped onto a projection by a
+// 2D affine transform (magnification + shift) of its center plane. For each (slice, projection), the transform is
+// computed once, then the detector is resampled at the voxel centers shadows with bilinear interpolation, stepping
+// incrementally along x (SIMD lanes when the CPU allows it). A voxel gets the mean of the projections which see it.
+namespace cpuprojector
+{
+// Detector pixel coordinates (origin at the center of the first pixel) of the shadow of voxel (i, j) of a slice:
+// xPixel = xScale * i + xShift, yPixel = yScale * j + yShift
+struct SliceToProjectionTransform
+{
+    float xScale{ 0.F };
+    float xShift{ 0.F };
+    float yScale{ 0.F };
+    float yShift{ 0.F };
+};
+
+// returns false if the slice is not between the source and the detector
+bool ComputeSliceToProjectionTransform( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_sliceIndex, SliceToProjectionTransform & p_transform );
+
+// Parallelized over the volume slices, each slice being owned by a single task
+void PerformHomographyBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+}    // namespace cpuprojector
@@ -0,0 +1,304 @@
+#include "modules/reconstruction/ProjectorPlan.h"
+
+#include "modules/reconstruction/ProjectorCpu.h"
+#include "modules/reconstruction/ProjectorDistanceDriven.h"
+#include "modules/reconstruction/ProjectorHomography.h"
+#include "modules/reconstruction/ProjectorSeparableFootprint.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+
+#include <algorithm>
+#include <iostream>
+
+ProjectorPlan::ProjectorPlan( TomoGeometry const * p_tomoGeometry )
+  : ProjectorPlan( p_tomoGeometry, DefaultProjectorBackend() )
+{
+}
+
+ProjectorPlan::ProjectorPlan( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend )
+  : ProjectorPlan( p_tomoGeometry, p_backend, p_tomoGeometry != nullptr ? projectionssubset::All( p_tomoGeometry->nbProjectionsRois() ) : ProjectionsSubset{} )
+{
+}
+
+ProjectorPlan::ProjectorPlan( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, const ProjectionsSubset & p_projectionsSubset )
+  : m_backend{ p_backend }
+  , m_projectionsSubset{ p_projectionsSubset }
+{
+    if( p_tomoGeometry == nullptr )
+    {
+        std::cout << "ProjectorPlan: geometry is nullptr" << std::endl;
+        return;
+    }
+    auto fullGeometry = ProjectorGeometry::FromTomoGeometry( p_tomoGeometry );
+    m_nbProjections = fullGeometry.projectionsDimension.z;
+    if( !projectionssubset::IsValid( m_projectionsSubset, m_nbProjections ) )
+    {
+        std::cout << "ProjectorPlan: invalid projections subset" << std::endl;
+        return;
+    }
+    m_isContiguousSubset = projectionssubset::IsContiguous( m_projectionsSubset );
+    m_geometry = fullGeometry.ExtractProjections( m_projectionsSubset );
+    if( !m_isContiguousSubset )
+    {
+        m_subsetProjections.resize( m_geometry.GetProjectionsPixelsNumber() );
+    }
+    if( m_geometry.GetVolumeVoxelsNumber() <= 0 || m_geometry.GetProjectionsPixelsNumber() <= 0 )
+    {
+        std::cout << "ProjectorPlan: empty volume or projections" << std::endl;
+        return;
+    }
+    auto volumeBottomLeftFront = p_tomoGeometry->volumeBLF();
+    m_volumeOriginInWorld.x = volumeBottomLeftFront.x;
+    m_volumeOriginInWorld.y = volumeBottomLeftFront.y;
+    m_volumeOriginInWorld.z = volumeBottomLeftFront.z;
+
+    if( m_backend == ProjectorBackend::Cuda )
+    {
+#ifdef TOMO_WITH_CUDA
+        this->PrepareCudaBuffers();
+#else
+        std::cout << "ProjectorPlan: Cuda backend requested but not built" << std::endl;
+        return;
+#endif
+    }
+    else
+    {
+        this->PrepareCpuBuffers();
+    }
+    m_isValid = true;
+}
+
+ProjectorPlan::~ProjectorPlan()
+{
+#ifdef TOMO_WITH_CUDA
+    this->ReleaseCudaBuffers();
+#endif
+}
+
+vtkSmartPointer<vtkImageData> ProjectorPlan::CreateProjectionsImage() const
+{
+    auto projectionsImage = vtkSmartPointer<vtkImageData>::New();
+    projectionsImage->SetDimensions( m_geometry.projectionsDimension.x, m_geometry.projectionsDimension.y, m_nbProjections );
+    projectionsImage->SetSpacing( m_geometry.projectionsPixelsSpacing.x, m_geometry.projectionsPixelsSpacing.y, 1. );
+    projectionsImage->AllocateScalars( VTK_FLOAT, 1 );
+    return projectionsImage;
+}
+
+vtkSmartPointer<vtkImageData> ProjectorPlan::CreateVolumeImage() const
+{
+    auto volumeImage = vtkSmartPointer<vtkImageData>::New();
+    volumeImage->SetDimensions( m_geometry.volumeDimension.x, m_geometry.volumeDimension.y, m_geometry.volumeDimension.z );
+    volumeImage->SetSpacing( m_geometry.volumeVoxelsSpacing.x, m_geometry.volumeVoxelsSpacing.y, m_geometry.volumeVoxelsSpacing.z );
+    volumeImage->AllocateScalars( VTK_FLOAT, 1 );
+    return volumeImage;
+}
+
+bool ProjectorPlan::Project( const vtkSmartPointer<vtkImageData> p_volume, vtkSmartPointer<vtkImageData> p_projections )
+{
+    if( !m_isValid || !this->HasVolumeDimensions( p_volume ) || !this->HasProjectionsDimensions( p_projections ) )
+    {
+        std::cout << "ProjectorPlan: volume or projections do not match the plan" << std::endl;
+        return false;
+    }
+    this->Project( static_cast<const float *>( p_volume->GetScalarPointer() ), static_cast<float *>( p_projections->GetScalarPointer() ) );
+    p_projections->Modified();
+    return true;
+}
+
+bool ProjectorPlan::BackProject( const vtkSmartPointer<vtkImageData> p_projections, vtkSmartPointer<vtkImageData> p_volume )
+{
+    if( !m_isValid || !this->HasProjectionsDimensions( p_projections ) || !this->HasVolumeDimensions( p_volume ) )
+    {
+        std::cout << "ProjectorPlan: projections or volume do not match the plan" << std::endl;
+        return false;
+    }
+    this->BackProject( static_cast<const float *>( p_projections->GetScalarPointer() ), static_cast<float *>( p_volume->GetScalarPointer() ) );
+    p_volume->Modified();
+    return true;
+}
+
+void ProjectorPlan::Project( const float * p_volumeBuffer, float * p_projectionsBuffer )
+{
+    auto * subsetProjectionsBuffer = this->SubsetOutput( p_projectionsBuffer );
+    if( m_backend == ProjectorBackend::Cuda )
+    {
+#ifdef TOMO_WITH_CUDA
+        this->PerformCudaProjection( p_volumeBuffer, subsetProjectionsBuffer );
+#endif
+    }
+    else
+    {
+        this->PerformCpuProjection( p_volumeBuffer, subsetProjectionsBuffer );
+    }
+    this->ScatterSubset( p_projectionsBuffer );
+}
+
+void ProjectorPlan::BackProject( const float * p_projectionsBuffer, float * p_volumeBuffer )
+{
+    const auto * subsetProjectionsBuffer = this->GatherSubset( p_projectionsBuffer );
+    if( m_backend == ProjectorBackend::Cuda )
+    {
+#ifdef TOMO_WITH_CUDA
+        this->PerformCudaBackProjection( subsetProjectionsBuffer, p_volumeBuffer );
+#endif
+        return;
+    }
+    this->PerformCpuBackProjection( subsetProjectionsBuffer, p_volumeBuffer );
+}
+
+const float * ProjectorPlan::GatherSubset( const float * p_projectionsBuffer )
+{
+    const auto projectionSize = static_cast<size_t>( m_geometry.projectionsDimension.x ) * m_geometry.projectionsDimension.y;
+    if( m_isContiguousSubset )
+    {
+        return p_projectionsBuffer + m_projectionsSubset.front() * projectionSize;
+    }
+    for( auto subsetIndex{ 0U }; subsetIndex < m_projectionsSubset.size(); subsetIndex++ )
+    {
+        const auto * projection = p_projectionsBuffer + m_projectionsSubset[subsetIndex] * projectionSize;
+        std::copy( projection, projection + projectionSize, m_subsetProjections.begin() + subsetIndex * projectionSize );
+    }
+    return m_subsetProjections.data();
+}
+
+float * ProjectorPlan::SubsetOutput( float * p_projectionsBuffer )
+{
+    const auto projectionSize = static_cast<size_t>( m_geometry.projectionsDimension.x ) * m_geometry.projectionsDimension.y;
+    return m_isContiguousSubset ? p_projectionsBuffer + m_projectionsSubset.front() * projectionSize : m_subsetProjections.data();
+}
+
+void ProjectorPlan::ScatterSubset( float * p_projectionsBuffer ) const
+{
+    if( m_isContiguousSubset )
+    {
+        return;
+    }
+    const auto projectionSize = static_cast<size_t>( m_geometry.projectionsDimension.x ) * m_geometry.projectionsDimension.y;
+    for( auto subsetIndex{ 0U }; subsetIndex < m_projectionsSubset.size(); subsetIndex++ )
+    {
+        const auto subsetProjection = m_subsetProjections.cbegin() + subsetIndex * projectionSize;
+        std::copy( subsetProjection, subsetProjection + projectionSize, p_projectionsBuffer + m_projectionsSubset[subsetIndex] * projectionSize );
+    }
+}
+
+bool ProjectorPlan::HasVolumeDimensions( const vtkSmartPointer<vtkImageData> p_image ) const
+{
+    if( p_image == nullptr || p_image->GetScalarType() != VTK_FLOAT )
+    {
+        return false;
+    }
+    auto dimensions = p_image->GetDimensions();
+    return dimensions[0] == m_geometry.volumeDimension.x && dimensions[1] == m_geometry.volumeDimension.y && dimensions[2] == m_geometry.volumeDimension.z;
+}
+
+bool ProjectorPlan::HasProjectionsDimensions( const vtkSmartPointer<vtkImageData> p_image ) const
+{
+    if( p_image == nullptr || p_image->GetScalarType() != VTK_FLOAT )
+    {
+        return false;
+    }
+    auto dimensions = p_image->GetDimensions();
+    return dimensions[0] == m_geometry.projectionsDimension.x && dimensions[1] == m_geometry.projectionsDimension.y && dimensions[2] == m_nbProjections;
+}
+
+void ProjectorPlan::PrepareCpuBuffers()
+{
+    switch( m_backend )
+    {
+        case ProjectorBackend::CpuIncremental:
+        case ProjectorBackend::CpuSimd:
+            m_voxelsWeights.resize( m_geometry.GetVolumeVoxelsNumber() );
+            cpuprojector::ComputeVoxelsWeights( m_geometry, m_voxelsWeights.data() );
+            m_raysAlphas.resize( m_geometry.GetProjectionsPixelsNumber() );
+            cpuprojector::ComputeRaysAlphas( m_geometry, m_raysAlphas.data() );
+            break;
+        case ProjectorBackend::CpuMatched:
+            m_raysInverseWeights.resize( m_geometry.GetProjectionsPixelsNumber() );
+            cpuprojector::ComputeRaysInverseWeights( m_geometry, m_raysInverseWeights.data() );
+            m_raysValues.resize( m_raysInverseWeights.size() );
+            m_raysAlphas.resize( m_raysInverseWeights.size() );
+            cpuprojector::ComputeRaysAlphas( m_geometry, m_raysAlphas.data() );
+            break;
+        case ProjectorBackend::CpuDistanceDriven:
+            m_raysInverseWeights.resize( m_geometry.GetProjectionsPixelsNumber() );
+            cpuprojector::ComputeDistanceDrivenRaysInverseWeights( m_geometry, m_raysInverseWeights.data() );
+            m_voxelsWeights.resize( m_geometry.GetVolumeVoxelsNumber() );
+            cpuprojector::ComputeDistanceDrivenVoxelsWeights( m_geometry, m_voxelsWeights.data() );
+            break;
+        case ProjectorBackend::CpuDistanceDrivenMatched:
+            m_raysInverseWeights.resize( m_geometry.GetProjectionsPixelsNumber() );
+            cpuprojector::ComputeDistanceDrivenRaysInverseWeights( m_geometry, m_raysInverseWeights.data() );
+            m_raysValues.resize( m_raysInverseWeights.size() );
+            break;
+        case ProjectorBackend::CpuSeparableFootprint:
+            m_raysInverseWeights.resize( m_geometry.GetProjectionsPixelsNumber() );
+            cpuprojector::ComputeSeparableFootprintRaysInverseWeights( m_geometry, m_raysInverseWeights.data() );
+            m_voxelsWeights.resize( m_geometry.GetVolumeVoxelsNumber() );
+            cpuprojector::ComputeSeparableFootprintVoxelsWeights( m_geometry, m_voxelsWeights.data() );
+            break;
+        case ProjectorBackend::CpuSeparableFootprintMatched:
+            m_raysInverseWeights.resize( m_geometry.GetProjectionsPixelsNumber() );
+            cpuprojector::ComputeSeparableFootprintRaysInverseWeights( m_geometry, m_raysInverseWeights.data() );
+            m_raysValues.resize( m_raysInverseWeights.size() );
+            break;
+        default:
+            break;
+    }
+}
+
+void ProjectorPlan::PerformCpuProjection( const float * p_volumeBuffer, float * p_projectionsBuffer )
+{
+    switch( m_backend )
+    {
+        case ProjectorBackend::CpuIncremental:
+        case ProjectorBackend::CpuMatched:
+            cpuprojector::PerformIncrementalProjection( p_volumeBuffer, m_geometry, p_projectionsBuffer );
+            break;
+        case ProjectorBackend::CpuSimd:
+        case ProjectorBackend::CpuHomography:
+            cpuprojector::PerformPacketProjection( p_volumeBuffer, m_geometry, p_projectionsBuffer );
+            break;
+        case ProjectorBackend::CpuDistanceDriven:
+        case ProjectorBackend::CpuDistanceDrivenMatched:
+            cpuprojector::PerformDistanceDrivenProjectionWithWeights( p_volumeBuffer, m_geometry, m_raysInverseWeights.data(), p_projectionsBuffer );
+            break;
+        case ProjectorBackend::CpuSeparableFootprint:
+        case ProjectorBackend::CpuSeparableFootprintMatched:
+            cpuprojector::PerformSeparableFootprintProjectionWithWeights( p_volumeBuffer, m_geometry, m_raysInverseWeights.data(), p_projectionsBuffer );
+            break;
+        default:
+            cpuprojector::PerformProjection( p_volumeBuffer, m_geometry, p_projectionsBuffer );
+            break;
+    }
+}
+
+void ProjectorPlan::PerformCpuBackProjection( const float * p_projectionsBuffer, float * p_volumeBuffer )
+{
+    switch( m_backend )
+    {
+        case ProjectorBackend::CpuIncremental:
+        case ProjectorBackend::CpuSimd:
+            cpuprojector::PerformIncrementalBackProjectionWithWeights( p_projectionsBuffer, m_geometry, m_voxelsWeights.data(), m_raysAlphas.data(), p_volumeBuffer );
+            break;
+        case ProjectorBackend::CpuDistanceDriven:
+            cpuprojector::PerformDistanceDrivenBackProjectionWithWeights( p_projectionsBuffer, m_geometry, m_voxelsWeights.data(), p_volumeBuffer );
+            break;
+        case ProjectorBackend::CpuSeparableFootprint:
+            cpuprojector::PerformSeparableFootprintBackProjectionWithWeights( p_projectionsBuffer, m_geometry, m_voxelsWeights.data(), p_volumeBuffer );
+            break;
+        case ProjectorBackend::CpuMatched:
+            cpuprojector::PerformMatchedBackProjectionWithWeights( p_projectionsBuffer, m_geometry, m_raysInverseWeights.data(), m_raysAlphas.data(), m_raysValues.data(), p_volumeBuffer );
+            break;
+        case ProjectorBackend::CpuDistanceDrivenMatched:
+            cpuprojector::PerformDistanceDrivenMatchedBackProjectionWithWeights( p_projectionsBuffer, m_geometry, m_raysInverseWeights.data(), m_raysValues.data(), p_volumeBuffer );
+            break;
+        case ProjectorBackend::CpuSeparableFootprintMatched:
+            cpuprojector::PerformSeparableFootprintMatchedBackProjectionWithWeights( p_projectionsBuffer, m_geometry, m_raysInverseWeights.data(), m_raysValues.data(), p_volumeBuffer );
+            break;
+        case ProjectorBackend::CpuHomography:
+            cpuprojector::PerformHomographyBackProjection( p_projectionsBuffer, m_geometry, p_volumeBuffer );
+            break;
+        default:
+            cpuprojector::PerformBackProjection( p_projectionsBuffer, m_geometry, p_volumeBuffer );
+            break;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectionsSubset.h"
+#include "modules/reconstruction/Projector.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <vector>
+
+// Projector set up once for a geometry and reused by the iterations of a reconstruction.
+// The geometry tables, the work buffers of the backend (device buffers for Cuda, geometry-only normalizations and rays
+// alphas for the ray-driven and footprint host projectors) are built in the constructor: Project and BackProject then
+// write in place into images created by CreateProjectionsImage and CreateVolumeImage. The scratch of the host projector
+// tasks (rays alphas, footprint tables) is kept in thread-local buffers grown by the first calls, so the steady state
+// does not allocate image-sized buffers; the per call tables and the parallel algorithms tasks are still allocated.
+// A plan can be restricted to a subset of the projections: it then works on the full projections stack, but projects
+// into the selected projections only (the other ones are left untouched) and back projects the selected ones only,
+// the back projection normalizations being the ones of the subset.
+class ProjectorPlan
+{
+public:
+    ProjectorPlan( TomoGeometry const * p_tomoGeometry );
+    ProjectorPlan( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend );
+    ProjectorPlan( TomoGeometry const * p_tomoGeometry, ProjectorBackend p_backend, const ProjectionsSubset & p_projectionsSubset );
+    ~ProjectorPlan();
+    ProjectorPlan( const ProjectorPlan & ) = delete;
+    ProjectorPlan & operator=( const ProjectorPlan & ) = delete;
+
+    bool IsValid() const { return m_isValid; }
+    ProjectorBackend GetBackend() const { return m_backend; }
+    // geometry of the subset projections
+    const ProjectorGeometry & GetGeometry() const { return m_geometry; }
+    const ProjectionsSubset & GetProjectionsSubset() const { return m_projectionsSubset; }
+    int GetNbProjections() const { return m_nbProjections; }    // in the full projections stack
+
+    // Images with the dimensions and spacings of the plan (full projections stack), to be used as outputs of Project and BackProject
+    vtkSmartPointer<vtkImageData> CreateProjectionsImage() const;
+    vtkSmartPointer<vtkImageData> CreateVolumeImage() const;
+
+    // return false (the reason is printed) if an image is null or does not have the plan dimensions
+    bool Project( const vtkSmartPointer<vtkImageData> p_volume, vtkSmartPointer<vtkImageData> p_projections );
+    bool BackProject( const vtkSmartPointer<vtkImageData> p_projections, vtkSmartPointer<vtkImageData> p_volume );
+
+    // Buffers of GetGeometry().GetVolumeVoxelsNumber() floats and of GetNbProjections() projections
+    void Project( const float * p_volumeBuffer, float * p_projectionsBuffer );
+    void BackProject( const float * p_projectionsBuffer, float * p_volumeBuffer );
+
+private:
+    bool HasVolumeDimensions( const vtkSmartPointer<vtkImageData> p_image ) const;
+    bool HasProjectionsDimensions( const vtkSmartPointer<vtkImageData> p_image ) const;
+
+    // subset projections of the full stack, either in place (contiguous subset) or gathered in m_subsetProjections
+    const float * GatherSubset( const float * p_projectionsBuffer );
+    float * SubsetOutput( float * p_projectionsBuffer );
+    void ScatterSubset( float * p_projectionsBuffer ) const;
+
+    void PrepareCpuBuffers();
+    void PerformCpuProjection( const float * p_volumeBuffer, float * p_projectionsBuffer );
+    void PerformCpuBackProjection( const float * p_projectionsBuffer, float * p_volumeBuffer );
+
+    // implemented in Projector.cu
+    void PrepareCudaBuffers();
+    void ReleaseCudaBuffers();
+    void PerformCudaProjection( const float * p_volumeBuffer, float * p_projectionsBuffer );
+    void PerformCudaBackProjection( const float * p_projectionsBuffer, float * p_volumeBuffer );
+
+    ProjectorBackend m_backend;
+    bool m_isValid{ false };
+    ProjectorGeometry m_geometry;
+    ProjectionsSubset m_projectionsSubset;
+    int m_nbProjections{ 0 };
+    bool m_isContiguousSubset{ true };
+    Float3 m_volumeOriginInWorld;    // bottom left front corner, needed by the Cuda kernels only
+
+    // host work buffers
+    std::vector<float> m_voxelsWeights;
+    std::vector<float> m_raysInverseWeights;
+    std::vector<float> m_raysValues;
+    std::vector<Float2> m_raysAlphas;
+    std::vector<float> m_subsetProjections;
+
+    // device buffers
+    float * m_deviceVolumeBuffer{ nullptr };
+    float * m_deviceProjectionsBuffer{ nullptr };
+    Float3 * m_deviceProjectionsOriginInWorld{ nullptr };
+    Float3 * m_deviceSourcesPositions{ nullptr };
+};
@@ -0,0 +1,192 @@
+#include "modules/reconstruction/ProjectorSeparableFootprint.h"
+
+#include "modules/reconstruction/SlicesTables.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <execution>
+#include <functional>
+#include <numeric>
+
+namespace    // anonymous namespace
+{
+using namespace cpuprojector;
+
+constexpr auto footprintFloatTolerance = 0.000001F;
+
+// Integral from -infinity to p_position of the trapezoid of unit height whose sorted corners are p_corners
+float TrapezoidIntegral( const std::array<float, 4> & p_corners, float p_position )
+{
+    const auto & [t0, t1, t2, t3] = p_corners;
+    if( p_position <= t0 )
+    {
+        return 0.F;
+    }
+    if( p_position < t1 )
+    {
+        return ( p_position - t0 ) * ( p_position - t0 ) / ( 2.F * ( t1 - t0 ) );
+    }
+    const auto rising = ( t1 - t0 ) / 2.F;
+    if( p_position <= t2 )
+    {
+        return rising + p_position - t1;
+    }
+    const auto plateau = t2 - t1;
+    if( p_position < t3 )
+    {
+        return rising + plateau + ( t3 - t2 ) / 2.F - ( t3 - p_position ) * ( t3 - p_position ) / ( 2.F * ( t3 - t2 ) );
+    }
+    return rising + plateau + ( t3 - t2 ) / 2.F;
+}
+
+// Magnification from the plane p_z to the detector plane of a projection
+inline float Magnification( const Float3 & p_source, float p_zDetector, float p_z )
+{
+    return std::fabs( p_z - p_source.z ) > footprintFloatTolerance ? ( p_zDetector - p_source.z ) / ( p_z - p_source.z ) : 0.F;
+}
+
+// Trapezoid footprints along y of the voxel rows of the slice p_sliceIndex, seen from the source of p_projectionIndex
+// returns false if the slice is not between the source and the detector
+bool ComputeTrapezoidTable( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_sliceIndex, FootprintTable & p_table )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & spacing = p_geometry.volumeVoxelsSpacing;
+    const auto & source = p_geometry.sourcesPositions[p_projectionIndex];
+    const auto & origin = p_geometry.projectionsOriginInWorld[p_projectionIndex];
+    const auto nbPixels = p_geometry.projectionsDimension.y;
+    const auto pixelWidth = p_geometry.projectionsPixelsSpacing.y;
+
+    const auto zBottom = ( static_cast<float>( p_sliceIndex ) - static_cast<float>( volumeDimension.z ) / 2.F ) * spacing.z;
+    const auto bottomMagnification = Magnification( source, origin.z, zBottom );
+    const auto topMagnification = Magnification( source, origin.z, zBottom + spacing.z );
+    if( bottomMagnification <= footprintFloatTolerance || topMagnification <= footprintFloatTolerance )
+    {
+        return false;
+    }
+
+    p_table.voxelsEntries.clear();
+    p_table.voxelsOffsets.assign( volumeDimension.y + 1, 0 );
+    p_table.pixelsOffsets.assign( nbPixels + 1, 0 );
+    for( auto yVoxel{ 0 }; yVoxel < volumeDimension.y; yVoxel++ )
+    {
+        const auto yLow = ( static_cast<float>( yVoxel ) - static_cast<float>( volumeDimension.y ) / 2.F ) * spacing.y;
+        std::array<float, 4> corners{ source.y + ( yLow - source.y ) * bottomMagnification,
+                                      source.y + ( yLow - source.y ) * topMagnification,
+                                      source.y + ( yLow + spacing.y - source.y ) * bottomMagnification,
+                                      source.y + ( yLow + spacing.y - source.y ) * topMagnification };
+        std::sort( corners.begin(), corners.end() );
+
+        const auto firstPixel = std::max( 0, static_cast<int>( std::floor( ( corners[0] - origin.y ) / pixelWidth ) ) );
+        const auto lastPixel = std::min( nbPixels - 1, static_cast<int>( std::floor( ( corners[3] - origin.y ) / pixelWidth ) ) );
+        auto previousIntegral = TrapezoidIntegral( corners, origin.y + static_cast<float>( firstPixel ) * pixelWidth );
+        for( auto pixel{ firstPixel }; pixel <= lastPixel; pixel++ )
+        {
+            const auto integral = TrapezoidIntegral( corners, origin.y + static_cast<float>( pixel + 1 ) * pixelWidth );
+            const auto weight = ( integral - previousIntegral ) / pixelWidth;
+            previousIntegral = integral;
+            if( weight > footprintFloatTolerance )
+            {
+                p_table.voxelsEntries.push_back( OverlapEntry{ pixel, yVoxel, weight } );
+                p_table.voxelsOffsets[yVoxel + 1]++;
+                p_table.pixelsOffsets[pixel + 1]++;
+            }
+        }
+    }
+    std::partial_sum( p_table.voxelsOffsets.begin(), p_table.voxelsOffsets.end(), p_table.voxelsOffsets.begin() );
+    std::partial_sum( p_table.pixelsOffsets.begin(), p_table.pixelsOffsets.end(), p_table.pixelsOffsets.begin() );
+
+    // neighbouring footprints overlap: counting sort of the same entries by pixel
+    p_table.pixelsEntries.resize( p_table.voxelsEntries.size() );
+    p_table.cursors.assign( p_table.pixelsOffsets.begin(), p_table.pixelsOffsets.end() - 1 );
+    for( const auto & entry : p_table.voxelsEntries )
+    {
+        p_table.pixelsEntries[p_table.cursors[entry.pixel]++] = entry;
+    }
+    return !p_table.voxelsEntries.empty();
+}
+
+// Rectangle footprints along x of the voxel columns of the slice p_sliceIndex, seen from the source of p_projectionIndex
+bool ComputeRectangleTable( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_sliceIndex, OverlapTable & p_table )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & spacing = p_geometry.volumeVoxelsSpacing;
+    const auto & source = p_geometry.sourcesPositions[p_projectionIndex];
+    const auto & origin = p_geometry.projectionsOriginInWorld[p_projectionIndex];
+
+    const auto zCenter = ( static_cast<float>( p_sliceIndex ) + 0.5F - static_cast<float>( volumeDimension.z ) / 2.F ) * spacing.z;
+    const auto magnification = Magnification( source, origin.z, zCenter );
+    if( magnification <= footprintFloatTolerance )
+    {
+        return false;
+    }
+    const auto xVoxelsStart = source.x + ( -static_cast<float>( volumeDimension.x ) * spacing.x / 2.F - source.x ) * magnification;
+    ComputeOverlapTable( xVoxelsStart, spacing.x * magnification, volumeDimension.x, origin.x, p_geometry.projectionsPixelsSpacing.x, p_geometry.projectionsDimension.x, p_table );
+    return !p_table.entries.empty();
+}
+
+// Rectangle and trapezoid footprints of the slice p_sliceIndex seen from the source of p_projectionIndex
+bool ComputeFootprintTables( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_sliceIndex, OverlapTable & p_xTable, FootprintTable & p_yTable )
+{
+    return ComputeRectangleTable( p_geometry, p_projectionIndex, p_sliceIndex, p_xTable ) && ComputeTrapezoidTable( p_geometry, p_projectionIndex, p_sliceIndex, p_yTable );
+}
+}    // end of anonymous namespace
+
+namespace cpuprojector
+{
+void ComputeSeparableFootprintRaysInverseWeights( const ProjectorGeometry & p_geometry, float * p_raysInverseWeights )
+{
+    ProjectSlicesTables( nullptr, p_geometry, ComputeFootprintTables, p_raysInverseWeights );
+    std::transform( std::execution::par_unseq, p_raysInverseWeights, p_raysInverseWeights + p_geometry.GetProjectionsPixelsNumber(), p_raysInverseWeights, []( float p_weight ) {
+        return p_weight > footprintFloatTolerance ? 1.F / p_weight : 0.F;
+    } );
+}
+
+void ComputeSeparableFootprintVoxelsWeights( const ProjectorGeometry & p_geometry, float * p_voxelsWeights )
+{
+    BackProjectSlicesTables( nullptr, p_geometry, ComputeFootprintTables, p_voxelsWeights );
+}
+
+void PerformSeparableFootprintProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer )
+{
+    std::vector<float> raysInverseWeights( p_geometry.GetProjectionsPixelsNumber() );
+    ComputeSeparableFootprintRaysInverseWeights( p_geometry, raysInverseWeights.data() );
+    PerformSeparableFootprintProjectionWithWeights( p_volumeBuffer, p_geometry, raysInverseWeights.data(), p_projectionsBuffer );
+}
+
+void PerformSeparableFootprintBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    std::vector<float> voxelsWeights( p_geometry.GetVolumeVoxelsNumber() );
+    ComputeSeparableFootprintVoxelsWeights( p_geometry, voxelsWeights.data() );
+    PerformSeparableFootprintBackProjectionWithWeights( p_projectionsBuffer, p_geometry, voxelsWeights.data(), p_volumeBuffer );
+}
+
+void PerformSeparableFootprintMatchedBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer )
+{
+    std::vector<float> raysInverseWeights( p_geometry.GetProjectionsPixelsNumber() );
+    ComputeSeparableFootprintRaysInverseWeights( p_geometry, raysInverseWeights.data() );
+    std::vector<float> raysValues( raysInverseWeights.size() );
+    PerformSeparableFootprintMatchedBackProjectionWithWeights( p_projectionsBuffer, p_geometry, raysInverseWeights.data(), raysValues.data(), p_volumeBuffer );
+}
+
+void PerformSeparableFootprintProjectionWithWeights( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_projectionsBuffer )
+{
+    ProjectSlicesTables( p_volumeBuffer, p_geometry, ComputeFootprintTables, p_projectionsBuffer );
+    std::transform( std::execution::par_unseq, p_projectionsBuffer, p_projectionsBuffer + p_geometry.GetProjectionsPixelsNumber(), p_raysInverseWeights, p_projectionsBuffer, std::multiplies<float>() );
+}
+
+void PerformSeparableFootprintBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_voxelsWeights, float * p_volumeBuffer )
+{
+    BackProjectSlicesTables( p_projectionsBuffer, p_geometry, ComputeFootprintTables, p_volumeBuffer );
+    std::transform( std::execution::par_unseq, p_volumeBuffer, p_volumeBuffer + p_geometry.GetVolumeVoxelsNumber(), p_voxelsWeights, p_volumeBuffer, []( float p_value, float p_weight ) {
+        return p_weight > footprintFloatTolerance ? p_value / p_weight : 0.F;
+    } );
+}
+
+void PerformSeparableFootprintMatchedBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_raysValuesBuffer, float * p_volumeBuffer )
+{
+    // the projection normalization first, then the plain transpose of the footprints
+    std::transform( std::execution::par_unseq, p_projectionsBuffer, p_projectionsBuffer + p_geometry.GetProjectionsPixelsNumber(), p_raysInverseWeights, p_raysValuesBuffer, std::multiplies<float>() );
+    BackProjectSlicesTables( p_raysValuesBuffer, p_geometry, ComputeFootprintTables, p_volumeBuffer );
+}
+}    // namespace cpuprojector
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "modules/reconstruction/ProjectorDistanceDriven.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include <vector>
+
+// Separable footprint host projectors (SF-TR).
+// The footprint of a voxel on the detector is the product of two 1D functions:
+// - along y, the direction in which the sources move, a trapezoid: hull of the shadows of the voxel y boundaries taken
+//   at the bottom and at the top of the voxel, which accounts for the obliquity of the rays through the voxel thickness,
+// - along x, a rectangle: shadow of the voxel x boundaries taken at the slice center (as in the distance-driven projectors).
+// A pixel weight is the mean of the footprint over the pixel. As for the distance-driven projectors, with W the matrix of
+// these weights, the projection is D_r W, the back projection D_v W^T and the matched back projection W^T D_r its adjoint
+// (CpuSeparableFootprintMatched backend).
+namespace cpuprojector
+{
+// Trapezoid footprints of the voxel rows of a slice on the detector rows, stored twice
+struct FootprintTable
+{
+    std::vector<OverlapEntry> voxelsEntries;    // ordered by voxel: entries of voxel j are [voxelsOffsets[j], voxelsOffsets[j + 1][
+    std::vector<int> voxelsOffsets;
+    std::vector<OverlapEntry> pixelsEntries;    // ordered by pixel: entries of pixel i are [pixelsOffsets[i], pixelsOffsets[i + 1][
+    std::vector<int> pixelsOffsets;
+    std::vector<int> cursors;    // counting sort scratch, kept with the table to be reused
+};
+
+// Entries of a footprint table ordered by pixel and by voxel (see SlicesTables.h)
+inline const std::vector<OverlapEntry> & PixelsEntries( const FootprintTable & p_table )
+{
+    return p_table.pixelsEntries;
+}
+
+inline const std::vector<OverlapEntry> & VoxelsEntries( const FootprintTable & p_table )
+{
+    return p_table.voxelsEntries;
+}
+
+// D_r W. Parallelized over the slices (footprint tables) then over the detector rows, projection after projection
+void PerformSeparableFootprintProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer );
+
+// D_v W^T. Parallelized over the volume slices, each slice being owned by a single task
+void PerformSeparableFootprintBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+
+// W^T D_r, exact transpose of PerformSeparableFootprintProjection
+void PerformSeparableFootprintMatchedBackProjection( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, float * p_volumeBuffer );
+
+// Geometry-only diagonals (see ComputeDistanceDrivenRaysInverseWeights) and the projectors using them, p_raysValuesBuffer
+// being a work buffer of the projections size receiving D_r p_projectionsBuffer
+void ComputeSeparableFootprintRaysInverseWeights( const ProjectorGeometry & p_geometry, float * p_raysInverseWeights );
+void ComputeSeparableFootprintVoxelsWeights( const ProjectorGeometry & p_geometry, float * p_voxelsWeights );
+void PerformSeparableFootprintProjectionWithWeights( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_projectionsBuffer );
+void PerformSeparableFootprintBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_voxelsWeights, float * p_volumeBuffer );
+void PerformSeparableFootprintMatchedBackProjectionWithWeights( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, const float * p_raysInverseWeights, float * p_raysValuesBuffer, float * p_volumeBuffer );
+}    // namespace cpuprojector
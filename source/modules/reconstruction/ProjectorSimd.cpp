@@ -0,0 +1,358 @@
+#include "modules/reconstruction/ProjectorSimd.h"
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/ProjectorCpu.h"
+#include "modules/reconstruction/RayTraversal.h"
+#include "modules/reconstruction/SimdTargets.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <vector>
+
+namespace    // anonymous namespace
+{
+using namespace cpuprojector;
+
+constexpr auto maxPacketWidth{ 16 };
+
+// Traversal state of the rays of a packet, one lane per ray, laid out to be loaded in vector registers
+struct alignas( 64 ) RayPacket
+{
+    float alphaCurrent[maxPacketWidth];
+    float alphaMax[maxPacketWidth];
+    float alphaNextX[maxPacketWidth];
+    float alphaNextY[maxPacketWidth];
+    float alphaNextZ[maxPacketWidth];
+    float alphaDeltaX[maxPacketWidth];
+    float alphaDeltaY[maxPacketWidth];
+    float alphaDeltaZ[maxPacketWidth];
+    int32_t indexX[maxPacketWidth];
+    int32_t indexY[maxPacketWidth];
+    int32_t indexZ[maxPacketWidth];
+    int32_t stepX[maxPacketWidth];
+    int32_t stepY[maxPacketWidth];
+    int32_t stepZ[maxPacketWidth];
+    int32_t voxelIndex[maxPacketWidth];
+    int32_t active[maxPacketWidth];    // -1 for the rays crossing the volume, 0 otherwise
+};
+
+// Sets up the rays of the pixels [p_xFirstPixel, p_xFirstPixel + p_width[ of a detector row
+// returns false if none of them crosses the volume
+bool InitRayPacket( const ProjectorGeometry & p_geometry, const Float3 & p_volumeHalfLength, int p_projectionIndex, int p_yProjPixel, int p_xFirstPixel, int p_width, RayPacket & p_packet )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    auto anyActive{ false };
+    for( auto lane{ 0 }; lane < p_width; lane++ )
+    {
+        const auto xProjPixel = p_xFirstPixel + lane;
+        float alphaMin{ 0.F };
+        float alphaMax{ 0.F };
+        FloatingVoxelRay ray;
+        auto crossing{ false };
+        if( xProjPixel < p_geometry.projectionsDimension.x )
+        {
+            ray = ComputeRay( p_geometry, p_projectionIndex, xProjPixel, p_yProjPixel );
+            crossing = FindEntryAndExitAlphas( ray, p_volumeHalfLength, alphaMin, alphaMax );
+        }
+        if( !crossing )
+        {
+            // inert lane: never selected, never gathered
+            p_packet.alphaCurrent[lane] = 0.F;
+            p_packet.alphaMax[lane] = 0.F;
+            p_packet.alphaNextX[lane] = p_packet.alphaNextY[lane] = p_packet.alphaNextZ[lane] = 1.F;
+            p_packet.alphaDeltaX[lane] = p_packet.alphaDeltaY[lane] = p_packet.alphaDeltaZ[lane] = 0.F;
+            p_packet.indexX[lane] = p_packet.indexY[lane] = p_packet.indexZ[lane] = 0;
+            p_packet.stepX[lane] = p_packet.stepY[lane] = p_packet.stepZ[lane] = 0;
+            p_packet.voxelIndex[lane] = 0;
+            p_packet.active[lane] = 0;
+            continue;
+        }
+        const auto xStepper = MakeAxisStepper( ray.source.x, ray.directorVector.x, p_volumeHalfLength.x, 0, volumeDimension.x, alphaMin );
+        const auto yStepper = MakeAxisStepper( ray.source.y, ray.directorVector.y, p_volumeHalfLength.y, 0, volumeDimension.y, alphaMin );
+        const auto zStepper = MakeAxisStepper( ray.source.z, ray.directorVector.z, p_volumeHalfLength.z, 0, volumeDimension.z, alphaMin );
+        p_packet.alphaCurrent[lane] = alphaMin;
+        p_packet.alphaMax[lane] = alphaMax;
+        p_packet.alphaNextX[lane] = xStepper.alphaNext;
+        p_packet.alphaNextY[lane] = yStepper.alphaNext;
+        p_packet.alphaNextZ[lane] = zStepper.alphaNext;
+        p_packet.alphaDeltaX[lane] = xStepper.alphaDelta;
+        p_packet.alphaDeltaY[lane] = yStepper.alphaDelta;
+        p_packet.alphaDeltaZ[lane] = zStepper.alphaDelta;
+        p_packet.indexX[lane] = xStepper.index;
+        p_packet.indexY[lane] = yStepper.index;
+        p_packet.indexZ[lane] = zStepper.index;
+        p_packet.stepX[lane] = xStepper.step;
+        p_packet.stepY[lane] = yStepper.step;
+        p_packet.stepZ[lane] = zStepper.step;
+        p_packet.voxelIndex[lane] = ( zStepper.index * volumeDimension.y + yStepper.index ) * volumeDimension.x + xStepper.index;
+        p_packet.active[lane] = -1;
+        anyActive = true;
+    }
+    return anyActive;
+}
+
+#ifdef TOMO_WITH_X86_SIMD
+// Lockstep version of TraverseRay for 8 rays: each lane advances its own closest axis, the lanes whose ray has left the
+// volume are masked out of the gathers and of the accumulations
+TOMO_TARGET_AVX2 void ProjectRowAvx2( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, const Float3 & p_volumeHalfLength, int p_projectionIndex, int p_yProjPixel, float * p_rowBuffer )
+{
+    constexpr auto width{ 8 };
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto tolerance = _mm256_set1_ps( rayFloatTolerance );
+    const auto allOnes = _mm256_castsi256_ps( _mm256_set1_epi32( -1 ) );
+    const auto yStride = _mm256_set1_epi32( volumeDimension.x );
+    const auto zStride = _mm256_set1_epi32( volumeDimension.x * volumeDimension.y );
+    const auto lastX = _mm256_set1_epi32( volumeDimension.x - 1 );
+    const auto lastY = _mm256_set1_epi32( volumeDimension.y - 1 );
+    const auto lastZ = _mm256_set1_epi32( volumeDimension.z - 1 );
+    const auto zeroIndex = _mm256_setzero_si256();
+
+    RayPacket packet;
+    alignas( 32 ) float results[width];
+    for( auto xFirstPixel{ 0 }; xFirstPixel < p_geometry.projectionsDimension.x; xFirstPixel += width )
+    {
+        const auto packetWidth = std::min( width, p_geometry.projectionsDimension.x - xFirstPixel );
+        if( !InitRayPacket( p_geometry, p_volumeHalfLength, p_projectionIndex, p_yProjPixel, xFirstPixel, packetWidth, packet ) )
+        {
+            std::fill( p_rowBuffer + xFirstPixel, p_rowBuffer + xFirstPixel + packetWidth, 0.F );
+            continue;
+        }
+
+        auto alphaCurrent = _mm256_load_ps( packet.alphaCurrent );
+        const auto alphaMax = _mm256_load_ps( packet.alphaMax );
+        auto alphaNextX = _mm256_load_ps( packet.alphaNextX );
+        auto alphaNextY = _mm256_load_ps( packet.alphaNextY );
+        auto alphaNextZ = _mm256_load_ps( packet.alphaNextZ );
+        const auto alphaDeltaX = _mm256_load_ps( packet.alphaDeltaX );
+        const auto alphaDeltaY = _mm256_load_ps( packet.alphaDeltaY );
+        const auto alphaDeltaZ = _mm256_load_ps( packet.alphaDeltaZ );
+        auto indexX = _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.indexX ) );
+        auto indexY = _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.indexY ) );
+        auto indexZ = _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.indexZ ) );
+        const auto stepX = _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.stepX ) );
+        const auto stepY = _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.stepY ) );
+        const auto stepZ = _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.stepZ ) );
+        auto voxelIndex = _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.voxelIndex ) );
+        auto active = _mm256_castsi256_ps( _mm256_load_si256( reinterpret_cast<const __m256i *>( packet.active ) ) );
+        auto total = _mm256_setzero_ps();
+        auto totalWeight = _mm256_setzero_ps();
+
+        while( _mm256_movemask_ps( active ) != 0 )
+        {
+            // same axis selection as TraverseRay: x, unless y is strictly closer, unless z is strictly closer than both
+            const auto yBeforeX = _mm256_cmp_ps( alphaNextY, alphaNextX, _CMP_LT_OQ );
+            const auto alphaNextXY = _mm256_min_ps( alphaNextX, alphaNextY );
+            const auto selectZ = _mm256_cmp_ps( alphaNextZ, alphaNextXY, _CMP_LT_OQ );
+            const auto selectY = _mm256_andnot_ps( selectZ, yBeforeX );
+            const auto selectX = _mm256_andnot_ps( _mm256_or_ps( selectZ, yBeforeX ), allOnes );
+
+            const auto alphaNext = _mm256_min_ps( _mm256_min_ps( alphaNextXY, alphaNextZ ), alphaMax );
+            const auto weight = _mm256_sub_ps( alphaNext, alphaCurrent );
+            const auto contributing = _mm256_and_ps( active, _mm256_cmp_ps( weight, tolerance, _CMP_GT_OQ ) );
+            const auto values = _mm256_mask_i32gather_ps( _mm256_setzero_ps(), p_volumeBuffer, voxelIndex, contributing, 4 );
+            const auto contributingWeight = _mm256_and_ps( contributing, weight );
+            total = _mm256_fmadd_ps( contributingWeight, values, total );
+            totalWeight = _mm256_add_ps( totalWeight, contributingWeight );
+
+            active = _mm256_andnot_ps( _mm256_cmp_ps( alphaNext, alphaMax, _CMP_GE_OQ ), active );
+            alphaCurrent = alphaNext;
+
+            const auto laneStepX = _mm256_and_si256( stepX, _mm256_castps_si256( selectX ) );
+            const auto laneStepY = _mm256_and_si256( stepY, _mm256_castps_si256( selectY ) );
+            const auto laneStepZ = _mm256_and_si256( stepZ, _mm256_castps_si256( selectZ ) );
+            indexX = _mm256_add_epi32( indexX, laneStepX );
+            indexY = _mm256_add_epi32( indexY, laneStepY );
+            indexZ = _mm256_add_epi32( indexZ, laneStepZ );
+            voxelIndex = _mm256_add_epi32( voxelIndex, laneStepX );
+            voxelIndex = _mm256_add_epi32( voxelIndex, _mm256_mullo_epi32( laneStepY, yStride ) );
+            voxelIndex = _mm256_add_epi32( voxelIndex, _mm256_mullo_epi32( laneStepZ, zStride ) );
+
+            auto outside = _mm256_or_si256( _mm256_cmpgt_epi32( zeroIndex, indexX ), _mm256_cmpgt_epi32( indexX, lastX ) );
+            outside = _mm256_or_si256( outside, _mm256_or_si256( _mm256_cmpgt_epi32( zeroIndex, indexY ), _mm256_cmpgt_epi32( indexY, lastY ) ) );
+            outside = _mm256_or_si256( outside, _mm256_or_si256( _mm256_cmpgt_epi32( zeroIndex, indexZ ), _mm256_cmpgt_epi32( indexZ, lastZ ) ) );
+            active = _mm256_andnot_ps( _mm256_castsi256_ps( outside ), active );
+
+            alphaNextX = _mm256_add_ps( alphaNextX, _mm256_and_ps( selectX, alphaDeltaX ) );
+            alphaNextY = _mm256_add_ps( alphaNextY, _mm256_and_ps( selectY, alphaDeltaY ) );
+            alphaNextZ = _mm256_add_ps( alphaNextZ, _mm256_and_ps( selectZ, alphaDeltaZ ) );
+        }
+
+        const auto weighted = _mm256_cmp_ps( totalWeight, tolerance, _CMP_GT_OQ );
+        _mm256_store_ps( results, _mm256_and_ps( weighted, _mm256_div_ps( total, _mm256_max_ps( totalWeight, tolerance ) ) ) );
+        std::copy( results, results + packetWidth, p_rowBuffer + xFirstPixel );
+    }
+}
+
+// Same as ProjectRowAvx2 for 16 rays, with the mask registers
+TOMO_TARGET_AVX512 void ProjectRowAvx512( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, const Float3 & p_volumeHalfLength, int p_projectionIndex, int p_yProjPixel, float * p_rowBuffer )
+{
+    constexpr auto width{ 16 };
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto tolerance = _mm512_set1_ps( rayFloatTolerance );
+    const auto yStride = _mm512_set1_epi32( volumeDimension.x );
+    const auto zStride = _mm512_set1_epi32( volumeDimension.x * volumeDimension.y );
+    const auto dimensionX = _mm512_set1_epi32( volumeDimension.x );
+    const auto dimensionY = _mm512_set1_epi32( volumeDimension.y );
+    const auto dimensionZ = _mm512_set1_epi32( volumeDimension.z );
+    const auto zeroIndex = _mm512_setzero_si512();
+
+    RayPacket packet;
+    alignas( 64 ) float results[width];
+    for( auto xFirstPixel{ 0 }; xFirstPixel < p_geometry.projectionsDimension.x; xFirstPixel += width )
+    {
+        const auto packetWidth = std::min( width, p_geometry.projectionsDimension.x - xFirstPixel );
+        if( !InitRayPacket( p_geometry, p_volumeHalfLength, p_projectionIndex, p_yProjPixel, xFirstPixel, packetWidth, packet ) )
+        {
+            std::fill( p_rowBuffer + xFirstPixel, p_rowBuffer + xFirstPixel + packetWidth, 0.F );
+            continue;
+        }
+
+        auto alphaCurrent = _mm512_load_ps( packet.alphaCurrent );
+        const auto alphaMax = _mm512_load_ps( packet.alphaMax );
+        auto alphaNextX = _mm512_load_ps( packet.alphaNextX );
+        auto alphaNextY = _mm512_load_ps( packet.alphaNextY );
+        auto alphaNextZ = _mm512_load_ps( packet.alphaNextZ );
+        const auto alphaDeltaX = _mm512_load_ps( packet.alphaDeltaX );
+        const auto alphaDeltaY = _mm512_load_ps( packet.alphaDeltaY );
+        const auto alphaDeltaZ = _mm512_load_ps( packet.alphaDeltaZ );
+        auto indexX = _mm512_load_si512( packet.indexX );
+        auto indexY = _mm512_load_si512( packet.indexY );
+        auto indexZ = _mm512_load_si512( packet.indexZ );
+        const auto stepX = _mm512_load_si512( packet.stepX );
+        const auto stepY = _mm512_load_si512( packet.stepY );
+        const auto stepZ = _mm512_load_si512( packet.stepZ );
+        auto voxelIndex = _mm512_load_si512( packet.voxelIndex );
+        auto active = _mm512_cmpneq_epi32_mask( _mm512_load_si512( packet.active ), zeroIndex );
+        auto total = _mm512_setzero_ps();
+        auto totalWeight = _mm512_setzero_ps();
+        // minima in their zero-masking form with all lanes selected: the plain _mm512_min_ps of gcc 12 merges into an
+        // undefined vector, reported by -Wmaybe-uninitialized
+        constexpr __mmask16 allLanes = 0xFFFF;
+
+        while( active != 0 )
+        {
+            const __mmask16 yBeforeX = _mm512_cmp_ps_mask( alphaNextY, alphaNextX, _CMP_LT_OQ );
+            const auto alphaNextXY = _mm512_maskz_min_ps( allLanes, alphaNextX, alphaNextY );
+            const __mmask16 selectZ = _mm512_cmp_ps_mask( alphaNextZ, alphaNextXY, _CMP_LT_OQ );
+            const __mmask16 selectY = static_cast<__mmask16>( ~selectZ & yBeforeX );
+            const __mmask16 selectX = static_cast<__mmask16>( ~( selectZ | yBeforeX ) );
+
+            const auto alphaNext = _mm512_maskz_min_ps( allLanes, _mm512_maskz_min_ps( allLanes, alphaNextXY, alphaNextZ ), alphaMax );
+            const auto weight = _mm512_sub_ps( alphaNext, alphaCurrent );
+            const __mmask16 contributing = _mm512_mask_cmp_ps_mask( active, weight, tolerance, _CMP_GT_OQ );
+            const auto values = _mm512_mask_i32gather_ps( _mm512_setzero_ps(), contributing, voxelIndex, p_volumeBuffer, 4 );
+            total = _mm512_mask3_fmadd_ps( weight, values, total, contributing );
+            totalWeight = _mm512_mask_add_ps( totalWeight, contributing, totalWeight, weight );
+
+            active = static_cast<__mmask16>( active & ~_mm512_cmp_ps_mask( alphaNext, alphaMax, _CMP_GE_OQ ) );
+            alphaCurrent = alphaNext;
+
+            indexX = _mm512_mask_add_epi32( indexX, selectX, indexX, stepX );
+            indexY = _mm512_mask_add_epi32( indexY, selectY, indexY, stepY );
+            indexZ = _mm512_mask_add_epi32( indexZ, selectZ, indexZ, stepZ );
+            voxelIndex = _mm512_mask_add_epi32( voxelIndex, selectX, voxelIndex, stepX );
+            voxelIndex = _mm512_mask_add_epi32( voxelIndex, selectY, voxelIndex, _mm512_mullo_epi32( stepY, yStride ) );
+            voxelIndex = _mm512_mask_add_epi32( voxelIndex, selectZ, voxelIndex, _mm512_mullo_epi32( stepZ, zStride ) );
+
+            // unsigned comparison: negative indices are seen as huge ones
+            active = _mm512_mask_cmplt_epu32_mask( active, indexX, dimensionX );
+            active = _mm512_mask_cmplt_epu32_mask( active, indexY, dimensionY );
+            active = _mm512_mask_cmplt_epu32_mask( active, indexZ, dimensionZ );
+
+            alphaNextX = _mm512_mask_add_ps( alphaNextX, selectX, alphaNextX, alphaDeltaX );
+            alphaNextY = _mm512_mask_add_ps( alphaNextY, selectY, alphaNextY, alphaDeltaY );
+            alphaNextZ = _mm512_mask_add_ps( alphaNextZ, selectZ, alphaNextZ, alphaDeltaZ );
+        }
+
+        const __mmask16 weighted = _mm512_cmp_ps_mask( totalWeight, tolerance, _CMP_GT_OQ );
+        _mm512_store_ps( results, _mm512_maskz_div_ps( weighted, total, totalWeight ) );
+        std::copy( results, results + packetWidth, p_rowBuffer + xFirstPixel );
+    }
+}
+#endif
+}    // end of anonymous namespace
+
+namespace cpuprojector
+{
+SimdLevel DetectSimdLevel()
+{
+#ifdef TOMO_WITH_X86_SIMD
+#if defined( _MSC_VER )
+    int registers[4];
+    __cpuid( registers, 0 );
+    if( registers[0] < 7 )
+    {
+        return SimdLevel::Scalar;
+    }
+    __cpuid( registers, 1 );
+    const auto fma = ( registers[2] & ( 1 << 12 ) ) != 0;
+    const auto osxsave = ( registers[2] & ( 1 << 27 ) ) != 0;
+    if( !osxsave )
+    {
+        return SimdLevel::Scalar;
+    }
+    const auto enabledStates = _xgetbv( 0 );
+    __cpuidex( registers, 7, 0 );
+    const auto avx2 = ( registers[1] & ( 1 << 5 ) ) != 0;
+    const auto avx512f = ( registers[1] & ( 1 << 16 ) ) != 0;
+    // the OS must save the ymm (and zmm) registers
+    if( avx512f && ( enabledStates & 0xE6 ) == 0xE6 )
+    {
+        return SimdLevel::Avx512;
+    }
+    if( avx2 && fma && ( enabledStates & 0x6 ) == 0x6 )
+    {
+        return SimdLevel::Avx2;
+    }
+#else
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports( "avx512f" ) )
+    {
+        return SimdLevel::Avx512;
+    }
+    if( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) )
+    {
+        return SimdLevel::Avx2;
+    }
+#endif
+#endif
+    return SimdLevel::Scalar;
+}
+
+void PerformPacketProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer )
+{
+    static const auto detectedSimdLevel = DetectSimdLevel();
+    PerformPacketProjection( p_volumeBuffer, p_geometry, p_projectionsBuffer, detectedSimdLevel );
+}
+
+void PerformPacketProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer, SimdLevel p_simdLevel )
+{
+#ifdef TOMO_WITH_X86_SIMD
+    if( p_simdLevel != SimdLevel::Scalar )
+    {
+        const auto & projectionsDimension = p_geometry.projectionsDimension;
+        const auto volumeHalfLength = VolumeHalfLength( p_geometry.volumeDimension );
+
+        // one task per detector row, all projections together
+        auto rowsIndices = IndexRange{ projectionsDimension.z * projectionsDimension.y };
+        auto rowProjector = [&]( int p_rowIndex ) {
+            const auto projectionIndex = p_rowIndex / projectionsDimension.y;
+            const auto yProjPixel = p_rowIndex % projectionsDimension.y;
+            auto * rowBuffer = p_projectionsBuffer + static_cast<size_t>( p_rowIndex ) * projectionsDimension.x;
+            if( p_simdLevel == SimdLevel::Avx512 )
+            {
+                ProjectRowAvx512( p_volumeBuffer, p_geometry, volumeHalfLength, projectionIndex, yProjPixel, rowBuffer );
+            }
+            else
+            {
+                ProjectRowAvx2( p_volumeBuffer, p_geometry, volumeHalfLength, projectionIndex, yProjPixel, rowBuffer );
+            }
+        };
+        std::for_each( std::execution::par, rowsIndices.begin(), rowsIndices.end(), rowProjector );
+        return;
+    }
+#endif
+    PerformIncrementalProjection( p_volumeBuffer, p_geometry, p_projectionsBuffer );
+}
+}    // namespace cpuprojector
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+// Vectorized host forward projector: the neighbouring pixels of a detector row share the same source and have almost
+// parallel rays, so they are traced in lockstep as a packet, one ray per SIMD lane, with the incremental traversal of
+// RayTraversal.h and masked gathers of the crossed voxels.
+namespace cpuprojector
+{
+enum class SimdLevel
+{
+    Scalar = 0,    // no packet: PerformIncrementalProjection
+    Avx2,          // packets of 8 rays
+    Avx512         // packets of 16 rays
+};
+
+// Highest level supported by both the build and the running CPU
+SimdLevel DetectSimdLevel();
+
+// Same values as PerformIncrementalProjection, computed with the packets of the detected level.
+// Parallelized over the detector rows of all the projections
+void PerformPacketProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer );
+
+// Same with a forced level, which must not be above DetectSimdLevel()
+void PerformPacketProjection( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, float * p_projectionsBuffer, SimdLevel p_simdLevel );
+}    // namespace cpuprojector
@@ -0,0 +1,643 @@
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectorCpu.h"
+#include "modules/reconstruction/ProjectorDistanceDriven.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+#include "modules/reconstruction/ProjectorHomography.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+#include "modules/reconstruction/ProjectorSeparableFootprint.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+constexpr int nbDotProductRepetitions = 5;
+constexpr int nbBenchmarkRepetitions = 3;
+constexpr double rayDrivenTolerance = 0.001;           // max abs error on volumes in [0, 1]
+constexpr double footprintMeanTolerance = 0.05;        // mean abs error on smooth volumes in [0, 2]
+constexpr double adjointRelativeTolerance = 0.0001;    // | <Ax, y> - <x, A^T y> | / | <Ax, y> |
+constexpr double homographyShiftTolerance = 0.15;      // mean difference with the ray-driven back projection of a ramp, in pixels
+constexpr double homographyRampTolerance = 0.3;        // mean abs difference, the ray-driven one averaging the ramp over the voxel footprint
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+namespace    // anonymous namespace
+{
+using ProjectorFunction = std::function<void( const float *, const ProjectorGeometry &, float * )>;
+
+struct NamedProjector
+{
+    std::string name;
+    ProjectorFunction function;
+};
+
+struct NamedProjectorPair
+{
+    std::string name;
+    ProjectorFunction projection;
+    ProjectorFunction backProjection;
+};
+
+// Normalized back projection with its transpose and its geometry-only normalizations
+struct NormalizedBackProjector
+{
+    std::string name;
+    ProjectorFunction backProjection;
+    ProjectorFunction matchedBackProjection;
+    std::function<void( const ProjectorGeometry &, float * )> computeRaysInverseWeights;
+    std::function<void( const ProjectorGeometry &, float * )> computeVoxelsWeights;
+};
+
+// Double precision Siddon reference: plane crossings of the ray from the source to the pixel center, sorted,
+// and the voxel of each segment found from its midpoint. Returns the (voxel index, alpha length) of the crossed voxels
+std::vector<std::pair<int, double>> ReferenceRayWeights( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_xProjPixel, int p_yProjPixel )
+{
+    const auto & dimension = p_geometry.volumeDimension;
+    const auto & spacing = p_geometry.volumeVoxelsSpacing;
+    const auto & source = p_geometry.sourcesPositions[p_projectionIndex];
+    const auto & origin = p_geometry.projectionsOriginInWorld[p_projectionIndex];
+
+    const double sizes[3] = { static_cast<double>( dimension.x ), static_cast<double>( dimension.y ), static_cast<double>( dimension.z ) };
+    const double sourceF[3] = { static_cast<double>( source.x ) / spacing.x, static_cast<double>( source.y ) / spacing.y, static_cast<double>( source.z ) / spacing.z };
+    const double pixelF[3] = { ( origin.x + ( p_xProjPixel + 0.5 ) * p_geometry.projectionsPixelsSpacing.x ) / spacing.x,
+                               ( origin.y + ( p_yProjPixel + 0.5 ) * p_geometry.projectionsPixelsSpacing.y ) / spacing.y,
+                               static_cast<double>( origin.z ) / spacing.z };
+    double director[3];
+    auto alphaMin{ 0. };
+    auto alphaMax{ 1. };
+    for( auto axis{ 0 }; axis < 3; axis++ )
+    {
+        director[axis] = pixelF[axis] - sourceF[axis];
+        if( std::fabs( director[axis] ) < 1e-12 )
+        {
+            if( std::fabs( sourceF[axis] ) >= sizes[axis] / 2. )
+            {
+                return {};
+            }
+            continue;
+        }
+        const auto alpha1 = ( -sizes[axis] / 2. - sourceF[axis] ) / director[axis];
+        const auto alphaN = ( sizes[axis] / 2. - sourceF[axis] ) / director[axis];
+        alphaMin = std::max( alphaMin, std::min( alpha1, alphaN ) );
+        alphaMax = std::min( alphaMax, std::max( alpha1, alphaN ) );
+    }
+    if( alphaMin >= alphaMax )
+    {
+        return {};
+    }
+
+    std::vector<double> alphas{ alphaMin, alphaMax };
+    for( auto axis{ 0 }; axis < 3; axis++ )
+    {
+        if( std::fabs( director[axis] ) < 1e-12 )
+        {
+            continue;
+        }
+        for( auto plane{ 0 }; plane <= static_cast<int>( sizes[axis] ); plane++ )
+        {
+            const auto alpha = ( plane - sizes[axis] / 2. - sourceF[axis] ) / director[axis];
+            if( alpha > alphaMin && alpha < alphaMax )
+            {
+                alphas.push_back( alpha );
+            }
+        }
+    }
+    std::sort( alphas.begin(), alphas.end() );
+
+    std::vector<std::pair<int, double>> weights;
+    for( auto index{ 0U }; index + 1 < alphas.size(); index++ )
+    {
+        const auto weight = alphas[index + 1] - alphas[index];
+        if( weight <= 1e-12 )
+        {
+            continue;
+        }
+        const auto centerAlpha = ( alphas[index + 1] + alphas[index] ) / 2.;
+        int voxel[3];
+        for( auto axis{ 0 }; axis < 3; axis++ )
+        {
+            voxel[axis] = std::clamp( static_cast<int>( std::floor( sizes[axis] / 2. + sourceF[axis] + centerAlpha * director[axis] ) ), 0, static_cast<int>( sizes[axis] ) - 1 );
+        }
+        weights.emplace_back( ( voxel[2] * dimension.y + voxel[1] ) * dimension.x + voxel[0], weight );
+    }
+    return weights;
+}
+
+// Calls p_rayFunction( pixelIndex, weights ) for each ray of the geometry
+void ForEachReferenceRay( const ProjectorGeometry & p_geometry, const std::function<void( int, const std::vector<std::pair<int, double>> & )> & p_rayFunction )
+{
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    for( auto projectionIndex{ 0 }; projectionIndex < projectionsDimension.z; projectionIndex++ )
+    {
+        for( auto yProjPixel{ 0 }; yProjPixel < projectionsDimension.y; yProjPixel++ )
+        {
+            for( auto xProjPixel{ 0 }; xProjPixel < projectionsDimension.x; xProjPixel++ )
+            {
+                const auto pixelIndex = ( projectionIndex * projectionsDimension.y + yProjPixel ) * projectionsDimension.x + xProjPixel;
+                p_rayFunction( pixelIndex, ReferenceRayWeights( p_geometry, projectionIndex, xProjPixel, yProjPixel ) );
+            }
+        }
+    }
+}
+
+// Length weighted mean of the voxels crossed by each ray
+std::vector<double> ReferenceProjection( const std::vector<float> & p_volume, const ProjectorGeometry & p_geometry )
+{
+    std::vector<double> projections( p_geometry.GetProjectionsPixelsNumber(), 0. );
+    ForEachReferenceRay( p_geometry, [&]( int p_pixelIndex, const std::vector<std::pair<int, double>> & p_weights ) {
+        auto total{ 0. };
+        auto totalWeight{ 0. };
+        for( const auto & [voxelIndex, weight] : p_weights )
+        {
+            total += weight * p_volume[voxelIndex];
+            totalWeight += weight;
+        }
+        projections[p_pixelIndex] = totalWeight > 0. ? total / totalWeight : 0.;
+    } );
+    return projections;
+}
+
+// Transpose of ReferenceProjection
+std::vector<double> ReferenceMatchedBackProjection( const std::vector<float> & p_projections, const ProjectorGeometry & p_geometry )
+{
+    std::vector<double> volume( p_geometry.GetVolumeVoxelsNumber(), 0. );
+    ForEachReferenceRay( p_geometry, [&]( int p_pixelIndex, const std::vector<std::pair<int, double>> & p_weights ) {
+        auto totalWeight{ 0. };
+        for( const auto & voxelWeight : p_weights )
+        {
+            totalWeight += voxelWeight.second;
+        }
+        for( const auto & [voxelIndex, weight] : p_weights )
+        {
+            volume[voxelIndex] += weight / totalWeight * p_projections[p_pixelIndex];
+        }
+    } );
+    return volume;
+}
+
+// Ray-driven forward projections, expected to reproduce the reference
+std::vector<NamedProjector> RayDrivenProjections()
+{
+    std::vector<NamedProjector> projectors{ { "Cpu", cpuprojector::PerformProjection }, { "CpuIncremental", cpuprojector::PerformIncrementalProjection } };
+    const auto detectedSimdLevel = cpuprojector::DetectSimdLevel();
+    if( detectedSimdLevel >= cpuprojector::SimdLevel::Avx2 )
+    {
+        projectors.push_back( { "CpuSimd (AVX2)", []( const float * p_volume, const ProjectorGeometry & p_geometry, float * p_projections ) {
+                                   cpuprojector::PerformPacketProjection( p_volume, p_geometry, p_projections, cpuprojector::SimdLevel::Avx2 );
+                               } } );
+    }
+    if( detectedSimdLevel >= cpuprojector::SimdLevel::Avx512 )
+    {
+        projectors.push_back( { "CpuSimd (AVX-512)", []( const float * p_volume, const ProjectorGeometry & p_geometry, float * p_projections ) {
+                                   cpuprojector::PerformPacketProjection( p_volume, p_geometry, p_projections, cpuprojector::SimdLevel::Avx512 );
+                               } } );
+    }
+    return projectors;
+}
+
+// Footprint based forward projections, approximations of the reference
+std::vector<NamedProjector> FootprintProjections()
+{
+    return { { "CpuDistanceDriven", cpuprojector::PerformDistanceDrivenProjection }, { "CpuSeparableFootprint", cpuprojector::PerformSeparableFootprintProjection } };
+}
+
+// Every forward projection with its exact transpose: the ray-driven ones share the weights of the matched back projection
+std::vector<NamedProjectorPair> AdjointPairs()
+{
+    std::vector<NamedProjectorPair> pairs;
+    for( const auto & projector : RayDrivenProjections() )
+    {
+        pairs.push_back( { projector.name, projector.function, cpuprojector::PerformMatchedBackProjection } );
+    }
+    pairs.push_back( { "CpuDistanceDriven", cpuprojector::PerformDistanceDrivenProjection, cpuprojector::PerformDistanceDrivenMatchedBackProjection } );
+    pairs.push_back( { "CpuSeparableFootprint", cpuprojector::PerformSeparableFootprintProjection, cpuprojector::PerformSeparableFootprintMatchedBackProjection } );
+    return pairs;
+}
+
+// Normalized back projections D_v W^T with their transposes W^T D_r and their geometry-only normalizations
+std::vector<NormalizedBackProjector> NormalizedTransposes()
+{
+    return { { "CpuIncremental", cpuprojector::PerformIncrementalBackProjection, cpuprojector::PerformMatchedBackProjection, cpuprojector::ComputeRaysInverseWeights,
+               cpuprojector::ComputeVoxelsWeights },
+             { "CpuDistanceDriven", cpuprojector::PerformDistanceDrivenBackProjection, cpuprojector::PerformDistanceDrivenMatchedBackProjection,
+               cpuprojector::ComputeDistanceDrivenRaysInverseWeights, cpuprojector::ComputeDistanceDrivenVoxelsWeights },
+             { "CpuSeparableFootprint", cpuprojector::PerformSeparableFootprintBackProjection, cpuprojector::PerformSeparableFootprintMatchedBackProjection,
+               cpuprojector::ComputeSeparableFootprintRaysInverseWeights, cpuprojector::ComputeSeparableFootprintVoxelsWeights } };
+}
+
+// Resources geometries and the synthetic oblique one
+std::vector<std::pair<std::string, ProjectorGeometry>> TestGeometries()
+{
+    std::vector<std::pair<std::string, ProjectorGeometry>> geometries;
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        geometries.emplace_back( path.filename().string(), ProjectorGeometry::FromTomoGeometry( &tomoGeometry ) );
+    }
+    geometries.emplace_back( "oblique", ObliqueGeometry() );
+    return geometries;
+}
+
+// Back projections normalized by the voxels weights: weighted means of the pixels
+std::vector<NamedProjector> NormalizedBackProjections()
+{
+    return { { "Cpu", cpuprojector::PerformBackProjection },
+             { "CpuIncremental", cpuprojector::PerformIncrementalBackProjection },
+             { "CpuDistanceDriven", cpuprojector::PerformDistanceDrivenBackProjection },
+             { "CpuSeparableFootprint", cpuprojector::PerformSeparableFootprintBackProjection },
+             { "CpuHomography", cpuprojector::PerformHomographyBackProjection } };
+}
+}    // end of anonymous namespace
+
+TEST( ProjectorTest, GeometriesAvailable )
+{
+    const auto paths = GeometriesFilesPaths();
+    ASSERT_FALSE( paths.empty() );
+    for( const auto & path : paths )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        EXPECT_TRUE( tomoGeometry.IsValid() ) << path;
+    }
+}
+
+TEST( ProjectorTest, RayDrivenProjectionsMatchDoubleReference )
+{
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto geometry = ProjectorGeometry::FromTomoGeometry( &tomoGeometry );
+        const auto volume = RandomBuffer( geometry.GetVolumeVoxelsNumber(), 1U );
+        const auto reference = ReferenceProjection( volume, geometry );
+
+        for( const auto & projector : RayDrivenProjections() )
+        {
+            std::vector<float> projections( geometry.GetProjectionsPixelsNumber() );
+            projector.function( volume.data(), geometry, projections.data() );
+            auto maxError{ 0. };
+            for( auto index{ 0U }; index < projections.size(); index++ )
+            {
+                maxError = std::max( maxError, std::fabs( projections[index] - reference[index] ) );
+            }
+            std::cout << path.filename() << " " << projector.name << ": max error " << maxError << std::endl;
+            EXPECT_LT( maxError, rayDrivenTolerance ) << path << " " << projector.name;
+        }
+    }
+}
+
+TEST( ProjectorTest, FootprintProjectionsStayCloseToDoubleReference )
+{
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto geometry = ProjectorGeometry::FromTomoGeometry( &tomoGeometry );
+        const auto volume = SmoothVolume( geometry );
+        const auto reference = ReferenceProjection( volume, geometry );
+
+        for( const auto & projector : FootprintProjections() )
+        {
+            std::vector<float> projections( geometry.GetProjectionsPixelsNumber() );
+            projector.function( volume.data(), geometry, projections.data() );
+            // the rays grazing the volume borders are not comparable: only the pixels seen by both are considered
+            auto totalError{ 0. };
+            auto nbPixels{ 0 };
+            for( auto index{ 0U }; index < projections.size(); index++ )
+            {
+                if( projections[index] != 0.F && reference[index] != 0. )
+                {
+                    totalError += std::fabs( projections[index] - reference[index] );
+                    nbPixels++;
+                }
+            }
+            ASSERT_GT( nbPixels, 0 ) << path << " " << projector.name;
+            const auto meanError = totalError / nbPixels;
+            std::cout << path.filename() << " " << projector.name << ": mean error " << meanError << std::endl;
+            EXPECT_LT( meanError, footprintMeanTolerance ) << path << " " << projector.name;
+        }
+    }
+}
+
+TEST( ProjectorTest, NormalizedBackProjectionsOfConstantAreConstant )
+{
+    constexpr auto constantValue = 3.F;
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto geometry = ProjectorGeometry::FromTomoGeometry( &tomoGeometry );
+        const std::vector<float> projections( geometry.GetProjectionsPixelsNumber(), constantValue );
+
+        for( const auto & backProjector : NormalizedBackProjections() )
+        {
+            std::vector<float> volume( geometry.GetVolumeVoxelsNumber() );
+            backProjector.function( projections.data(), geometry, volume.data() );
+            for( auto value : volume )
+            {
+                // voxels seen by no pixel are 0
+                if( value != 0.F )
+                {
+                    ASSERT_NEAR( value, constantValue, 0.0001 ) << path << " " << backProjector.name;
+                }
+            }
+        }
+    }
+}
+
+TEST( ProjectorTest, HomographyBackProjectionOfRampMatchesRayDriven )
+{
+    // Each projection is back projected alone (the ray-driven mean weights the projections, the homography one does not),
+    // with a ramp of one unit per pixel along x then along y: a misregistered shadow shifts the mean difference.
+    // Only the voxels whose whole footprint is on the detector, and which are crossed by a ray, are compared
+    for( const auto & [name, fullGeometry] : TestGeometries() )
+    {
+        for( auto projectionIndex{ 0 }; projectionIndex < fullGeometry.projectionsDimension.z; projectionIndex++ )
+        {
+            const auto geometry = fullGeometry.ExtractProjections( { projectionIndex } );
+            const auto & volumeDimension = geometry.volumeDimension;
+            const auto & projectionsDimension = geometry.projectionsDimension;
+            for( auto isXRamp : { true, false } )
+            {
+                std::vector<float> projections( geometry.GetProjectionsPixelsNumber() );
+                for( auto index{ 0 }; index < static_cast<int>( projections.size() ); index++ )
+                {
+                    projections[index] = static_cast<float>( isXRamp ? index % projectionsDimension.x : index / projectionsDimension.x );
+                }
+                std::vector<float> homographyVolume( geometry.GetVolumeVoxelsNumber() );
+                std::vector<float> rayDrivenVolume( homographyVolume.size() );
+                cpuprojector::PerformHomographyBackProjection( projections.data(), geometry, homographyVolume.data() );
+                cpuprojector::PerformIncrementalBackProjection( projections.data(), geometry, rayDrivenVolume.data() );
+
+                auto totalDifference{ 0. };
+                auto totalError{ 0. };
+                auto nbVoxels{ 0 };
+                for( auto z{ 0 }; z < volumeDimension.z; z++ )
+                {
+                    cpuprojector::SliceToProjectionTransform transform;
+                    if( !cpuprojector::ComputeSliceToProjectionTransform( geometry, 0, z, transform ) )
+                    {
+                        continue;
+                    }
+                    const auto xMargin = std::fabs( transform.xScale ) + 1.F;
+                    const auto yMargin = std::fabs( transform.yScale ) + 1.F;
+                    for( auto y{ 0 }; y < volumeDimension.y; y++ )
+                    {
+                        for( auto x{ 0 }; x < volumeDimension.x; x++ )
+                        {
+                            const auto xPixel = transform.xScale * x + transform.xShift;
+                            const auto yPixel = transform.yScale * y + transform.yShift;
+                            if( xPixel < xMargin || xPixel > projectionsDimension.x - 1 - xMargin || yPixel < yMargin || yPixel > projectionsDimension.y - 1 - yMargin )
+                            {
+                                continue;
+                            }
+                            const auto voxelIndex = ( z * volumeDimension.y + y ) * volumeDimension.x + x;
+                            // the ramp is positive inside the margins: 0 means that no ray crosses the voxel
+                            if( rayDrivenVolume[voxelIndex] == 0.F )
+                            {
+                                continue;
+                            }
+                            const auto difference = static_cast<double>( homographyVolume[voxelIndex] ) - rayDrivenVolume[voxelIndex];
+                            totalDifference += difference;
+                            totalError += std::fabs( difference );
+                            nbVoxels++;
+                        }
+                    }
+                }
+                ASSERT_GT( nbVoxels, 0 ) << name << " projection " << projectionIndex;
+                EXPECT_LT( std::fabs( totalDifference / nbVoxels ), homographyShiftTolerance ) << name << " projection " << projectionIndex << ( isXRamp ? " x" : " y" ) << " ramp";
+                EXPECT_LT( totalError / nbVoxels, homographyRampTolerance ) << name << " projection " << projectionIndex << ( isXRamp ? " x" : " y" ) << " ramp";
+            }
+        }
+    }
+}
+
+TEST( ProjectorTest, ProjectionsAreAdjointToTheirTransposes )
+{
+    for( const auto & [name, geometry] : TestGeometries() )
+    {
+        for( const auto & pair : AdjointPairs() )
+        {
+            for( auto repetition{ 0 }; repetition < nbDotProductRepetitions; repetition++ )
+            {
+                const auto volume = RandomBuffer( geometry.GetVolumeVoxelsNumber(), 2U * repetition + 10U );
+                const auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 2U * repetition + 11U );
+                std::vector<float> projectedVolume( projections.size() );
+                std::vector<float> backProjectedProjections( volume.size() );
+                pair.projection( volume.data(), geometry, projectedVolume.data() );
+                pair.backProjection( projections.data(), geometry, backProjectedProjections.data() );
+
+                const auto forwardDot = Dot( projectedVolume, projections );
+                const auto backwardDot = Dot( volume, backProjectedProjections );
+                ASSERT_GT( std::fabs( forwardDot ), 0. ) << name << " " << pair.name;
+                EXPECT_LT( std::fabs( forwardDot - backwardDot ) / std::fabs( forwardDot ), adjointRelativeTolerance )
+                    << name << " " << pair.name << " <Ax, y> = " << forwardDot << " <x, A^T y> = " << backwardDot;
+            }
+        }
+    }
+}
+
+TEST( ProjectorTest, NormalizedBackProjectionsAreNormalizedTransposes )
+{
+    // D_v W^T y = D_v ( W^T D_r ) ( D_r^-1 y ): the normalized and the matched back projections share their weights
+    for( const auto & [name, geometry] : TestGeometries() )
+    {
+        const auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 13U );
+        for( const auto & backProjector : NormalizedTransposes() )
+        {
+            std::vector<float> raysInverseWeights( projections.size() );
+            std::vector<float> voxelsWeights( geometry.GetVolumeVoxelsNumber() );
+            backProjector.computeRaysInverseWeights( geometry, raysInverseWeights.data() );
+            backProjector.computeVoxelsWeights( geometry, voxelsWeights.data() );
+            auto weightedProjections = projections;
+            for( auto index{ 0U }; index < projections.size(); index++ )
+            {
+                weightedProjections[index] = raysInverseWeights[index] > 0.F ? projections[index] / raysInverseWeights[index] : 0.F;
+            }
+
+            std::vector<float> normalizedVolume( voxelsWeights.size() );
+            std::vector<float> transposedVolume( voxelsWeights.size() );
+            backProjector.backProjection( projections.data(), geometry, normalizedVolume.data() );
+            backProjector.matchedBackProjection( weightedProjections.data(), geometry, transposedVolume.data() );
+            auto maxError{ 0.F };
+            for( auto index{ 0U }; index < voxelsWeights.size(); index++ )
+            {
+                const auto expected = voxelsWeights[index] > 0.000001F ? transposedVolume[index] / voxelsWeights[index] : 0.F;
+                maxError = std::max( maxError, std::fabs( normalizedVolume[index] - expected ) );
+            }
+            EXPECT_LT( maxError, 0.0001F ) << name << " " << backProjector.name;
+        }
+    }
+}
+
+TEST( ProjectorTest, MatchedBackProjectionMatchesDoubleReference )
+{
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto geometry = ProjectorGeometry::FromTomoGeometry( &tomoGeometry );
+        const auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 3U );
+        const auto reference = ReferenceMatchedBackProjection( projections, geometry );
+
+        std::vector<float> volume( geometry.GetVolumeVoxelsNumber() );
+        cpuprojector::PerformMatchedBackProjection( projections.data(), geometry, volume.data() );
+        const auto referenceMax = *std::max_element( reference.cbegin(), reference.cend() );
+        ASSERT_GT( referenceMax, 0. ) << path;
+        auto maxError{ 0. };
+        for( auto index{ 0U }; index < volume.size(); index++ )
+        {
+            maxError = std::max( maxError, std::fabs( volume[index] - reference[index] ) );
+        }
+        EXPECT_LT( maxError / referenceMax, adjointRelativeTolerance ) << path;
+    }
+}
+
+TEST( ProjectorTest, PlanMatchesDirectCalls )
+{
+    const std::vector<std::pair<ProjectorBackend, std::pair<ProjectorFunction, ProjectorFunction>>> backends{
+        { ProjectorBackend::CpuIncremental, { cpuprojector::PerformIncrementalProjection, cpuprojector::PerformIncrementalBackProjection } },
+        { ProjectorBackend::CpuMatched, { cpuprojector::PerformIncrementalProjection, cpuprojector::PerformMatchedBackProjection } },
+        { ProjectorBackend::CpuDistanceDriven, { cpuprojector::PerformDistanceDrivenProjection, cpuprojector::PerformDistanceDrivenBackProjection } },
+        { ProjectorBackend::CpuDistanceDrivenMatched, { cpuprojector::PerformDistanceDrivenProjection, cpuprojector::PerformDistanceDrivenMatchedBackProjection } },
+        { ProjectorBackend::CpuSeparableFootprintMatched, { cpuprojector::PerformSeparableFootprintProjection, cpuprojector::PerformSeparableFootprintMatchedBackProjection } } };
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto geometry = ProjectorGeometry::FromTomoGeometry( &tomoGeometry );
+        const auto volume = RandomBuffer( geometry.GetVolumeVoxelsNumber(), 4U );
+        const auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 5U );
+        for( const auto & [backend, functions] : backends )
+        {
+            ProjectorPlan plan( &tomoGeometry, backend );
+            ASSERT_TRUE( plan.IsValid() ) << path;
+
+            std::vector<float> expectedProjections( projections.size() );
+            std::vector<float> planProjections( projections.size() );
+            functions.first( volume.data(), geometry, expectedProjections.data() );
+            std::vector<float> expectedVolume( volume.size() );
+            std::vector<float> planVolume( volume.size() );
+            functions.second( projections.data(), geometry, expectedVolume.data() );
+            // twice: the plan buffers must be reusable
+            for( auto repetition{ 0 }; repetition < 2; repetition++ )
+            {
+                plan.Project( volume.data(), planProjections.data() );
+                plan.BackProject( projections.data(), planVolume.data() );
+                for( auto index{ 0U }; index < projections.size(); index++ )
+                {
+                    ASSERT_NEAR( planProjections[index], expectedProjections[index], 0.00001 ) << path << " " << static_cast<int>( backend );
+                }
+                for( auto index{ 0U }; index < volume.size(); index++ )
+                {
+                    ASSERT_NEAR( planVolume[index], expectedVolume[index], 0.0001 * std::max( 1.F, std::fabs( expectedVolume[index] ) ) ) << path << " " << static_cast<int>( backend );
+                }
+            }
+        }
+    }
+}
+
+TEST( ProjectorTest, SubsetsMatchFullProjections )
+{
+    constexpr auto untouchedValue = -1.F;
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        ProjectorPlan fullPlan( &tomoGeometry, ProjectorBackend::CpuMatched );
+        ASSERT_TRUE( fullPlan.IsValid() ) << path;
+        const auto & geometry = fullPlan.GetGeometry();
+        const auto projectionSize = geometry.projectionsDimension.x * geometry.projectionsDimension.y;
+        const auto volume = RandomBuffer( geometry.GetVolumeVoxelsNumber(), 6U );
+        const auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 7U );
+        std::vector<float> fullProjections( projections.size() );
+        std::vector<float> fullVolume( volume.size() );
+        fullPlan.Project( volume.data(), fullProjections.data() );
+        fullPlan.BackProject( projections.data(), fullVolume.data() );
+
+        // interleaved subsets (gathered) and halves (contiguous, in place)
+        auto subsets = projectionssubset::Interleaved( geometry.projectionsDimension.z, 2 );
+        subsets.push_back( projectionssubset::Contiguous( 0, geometry.projectionsDimension.z / 2 ) );
+        subsets.push_back( projectionssubset::Contiguous( geometry.projectionsDimension.z / 2, geometry.projectionsDimension.z - geometry.projectionsDimension.z / 2 ) );
+        std::vector<float> subsetsVolumesSum( volume.size(), 0.F );
+        for( const auto & subset : subsets )
+        {
+            ProjectorPlan subsetPlan( &tomoGeometry, ProjectorBackend::CpuMatched, subset );
+            ASSERT_TRUE( subsetPlan.IsValid() ) << path;
+            std::vector<float> subsetProjections( projections.size(), untouchedValue );
+            subsetPlan.Project( volume.data(), subsetProjections.data() );
+            for( auto projectionIndex{ 0 }; projectionIndex < geometry.projectionsDimension.z; projectionIndex++ )
+            {
+                const auto selected = std::find( subset.cbegin(), subset.cend(), projectionIndex ) != subset.cend();
+                for( auto pixelIndex{ projectionIndex * projectionSize }; pixelIndex < ( projectionIndex + 1 ) * projectionSize; pixelIndex++ )
+                {
+                    ASSERT_EQ( subsetProjections[pixelIndex], selected ? fullProjections[pixelIndex] : untouchedValue ) << path;
+                }
+            }
+
+            std::vector<float> subsetVolume( volume.size() );
+            subsetPlan.BackProject( projections.data(), subsetVolume.data() );
+            // the interleaved subsets only are summed, the halves cover the projections a second time
+            if( projectionssubset::IsContiguous( subset ) )
+            {
+                continue;
+            }
+            std::transform( subsetsVolumesSum.cbegin(), subsetsVolumesSum.cend(), subsetVolume.cbegin(), subsetsVolumesSum.begin(), std::plus<float>() );
+        }
+
+        // the matched back projection is a sum over the projections
+        for( auto index{ 0U }; index < volume.size(); index++ )
+        {
+            ASSERT_NEAR( subsetsVolumesSum[index], fullVolume[index], 0.0001 * std::max( 1.F, std::fabs( fullVolume[index] ) ) ) << path;
+        }
+    }
+}
+
+// Not a check: throughput report of every host backend, in rays/s and voxels/s
+TEST( ProjectorBenchmark, Throughput )
+{
+    std::vector<std::pair<std::string, std::pair<ProjectorFunction, ProjectorFunction>>> backends{
+        { "Cpu", { cpuprojector::PerformProjection, cpuprojector::PerformBackProjection } },
+        { "CpuIncremental", { cpuprojector::PerformIncrementalProjection, cpuprojector::PerformIncrementalBackProjection } },
+        { "CpuSimd", { []( const float * p_volume, const ProjectorGeometry & p_geometry, float * p_projections ) { cpuprojector::PerformPacketProjection( p_volume, p_geometry, p_projections ); },
+                       cpuprojector::PerformIncrementalBackProjection } },
+        { "CpuDistanceDriven", { cpuprojector::PerformDistanceDrivenProjection, cpuprojector::PerformDistanceDrivenBackProjection } },
+        { "CpuSeparableFootprint", { cpuprojector::PerformSeparableFootprintProjection, cpuprojector::PerformSeparableFootprintBackProjection } },
+        { "CpuMatched", { cpuprojector::PerformIncrementalProjection, cpuprojector::PerformMatchedBackProjection } },
+        { "CpuHomography", { []( const float * p_volume, const ProjectorGeometry & p_geometry, float * p_projections ) { cpuprojector::PerformPacketProjection( p_volume, p_geometry, p_projections ); },
+                             cpuprojector::PerformHomographyBackProjection } } };
+
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto geometry = ProjectorGeometry::FromTomoGeometry( &tomoGeometry );
+        const auto nbRays = static_cast<double>( geometry.GetProjectionsPixelsNumber() );
+        const auto nbVoxels = static_cast<double>( geometry.GetVolumeVoxelsNumber() );
+        auto volume = RandomBuffer( geometry.GetVolumeVoxelsNumber(), 4U );
+        auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 5U );
+
+        for( const auto & [name, functions] : backends )
+        {
+            const auto startProjection = std::chrono::steady_clock::now();
+            for( auto repetition{ 0 }; repetition < nbBenchmarkRepetitions; repetition++ )
+            {
+                functions.first( volume.data(), geometry, projections.data() );
+            }
+            const auto startBackProjection = std::chrono::steady_clock::now();
+            for( auto repetition{ 0 }; repetition < nbBenchmarkRepetitions; repetition++ )
+            {
+                functions.second( projections.data(), geometry, volume.data() );
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            const auto projectionSeconds = std::chrono::duration<double>( startBackProjection - startProjection ).count() / nbBenchmarkRepetitions;
+            const auto backProjectionSeconds = std::chrono::duration<double>( end - startBackProjection ).count() / nbBenchmarkRepetitions;
+            std::cout << path.filename() << " " << name << ": projection " << nbRays / projectionSeconds << " rays/s " << nbVoxels / projectionSeconds << " voxels/s"
+                      << ", back projection " << nbRays / backProjectionSeconds << " rays/s " << nbVoxels / backProjectionSeconds << " voxels/s" << std::endl;
+            EXPECT_GT( projectionSeconds, 0. );
+        }
+    }
+}
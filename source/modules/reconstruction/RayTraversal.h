@@ -0,0 +1,191 @@
+#pragma once
+
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+// Ray tools shared by the host projectors.
+// Everything is expressed in the floating voxel coordinate system: origin is the volume center, unit is a voxel spacing,
+// so that the volume spans [-halfLength, halfLength] on each axis and voxel plane i is at -halfLength + i
+namespace cpuprojector
+{
+constexpr auto rayFloatTolerance = 0.000001F;
+
+struct FloatingVoxelRay
+{
+    Float3 source;
+    Float3 directorVector;    // from the source to the detector pixel center: alpha = 1 on the detector
+};
+
+inline Float3 ToFloatingVoxel( const Float3 & p_worldPosition, const Float3 & p_voxelsSpacing )
+{
+    return Float3{ p_worldPosition.x / p_voxelsSpacing.x, p_worldPosition.y / p_voxelsSpacing.y, p_worldPosition.z / p_voxelsSpacing.z };
+}
+
+inline Float3 VolumeHalfLength( const Int3 & p_volumeDimension )
+{
+    return Float3{ static_cast<float>( p_volumeDimension.x ) / 2.F, static_cast<float>( p_volumeDimension.y ) / 2.F, static_cast<float>( p_volumeDimension.z ) / 2.F };
+}
+
+inline FloatingVoxelRay ComputeRay( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_xProjPixel, int p_yProjPixel )
+{
+    const auto & spacing = p_geometry.volumeVoxelsSpacing;
+    const auto & origin = p_geometry.projectionsOriginInWorld[p_projectionIndex];
+
+    FloatingVoxelRay ray;
+    ray.source = ToFloatingVoxel( p_geometry.sourcesPositions[p_projectionIndex], spacing );
+
+    Float3 projectionPosition;
+    projectionPosition.x = ( origin.x + ( static_cast<float>( p_xProjPixel ) + 0.5F ) * p_geometry.projectionsPixelsSpacing.x ) / spacing.x;
+    projectionPosition.y = ( origin.y + ( static_cast<float>( p_yProjPixel ) + 0.5F ) * p_geometry.projectionsPixelsSpacing.y ) / spacing.y;
+    projectionPosition.z = origin.z / spacing.z;
+
+    ray.directorVector.x = projectionPosition.x - ray.source.x;
+    ray.directorVector.y = projectionPosition.y - ray.source.y;
+    ray.directorVector.z = projectionPosition.z - ray.source.z;
+    return ray;
+}
+
+// Restrict [p_alphaMin, p_alphaMax] to the slab between the planes p_lowerPlane and p_upperPlane of one axis
+// returns false if the ray does not cross the slab
+inline bool ClipAlphasOnAxis( float p_source, float p_director, float p_lowerPlane, float p_upperPlane, float & p_alphaMin, float & p_alphaMax )
+{
+    if( std::fabs( p_director ) > rayFloatTolerance )
+    {
+        const auto alpha1 = ( p_lowerPlane - p_source ) / p_director;
+        const auto alphaN = ( p_upperPlane - p_source ) / p_director;
+        p_alphaMin = std::max( p_alphaMin, std::min( alpha1, alphaN ) );
+        p_alphaMax = std::min( p_alphaMax, std::max( alpha1, alphaN ) );
+        return true;
+    }
+    // ray parallel to the slab planes
+    return p_source >= p_lowerPlane && p_source <= p_upperPlane;
+}
+
+// Computes the alphas of the volume entry and exit points
+// returns false if the ray does not intersect the volume between the source and the detector
+inline bool FindEntryAndExitAlphas( const FloatingVoxelRay & p_ray, const Float3 & p_volumeHalfLength, float & p_alphaMin, float & p_alphaMax )
+{
+    p_alphaMin = 0.F;
+    p_alphaMax = 1.F;
+    if( !ClipAlphasOnAxis( p_ray.source.x, p_ray.directorVector.x, -p_volumeHalfLength.x, p_volumeHalfLength.x, p_alphaMin, p_alphaMax )
+        || !ClipAlphasOnAxis( p_ray.source.y, p_ray.directorVector.y, -p_volumeHalfLength.y, p_volumeHalfLength.y, p_alphaMin, p_alphaMax )
+        || !ClipAlphasOnAxis( p_ray.source.z, p_ray.directorVector.z, -p_volumeHalfLength.z, p_volumeHalfLength.z, p_alphaMin, p_alphaMax ) )
+    {
+        return false;
+    }
+    return p_alphaMin < p_alphaMax;
+}
+
+// Per axis state of the incremental traversal
+struct AxisStepper
+{
+    int index{ 0 };                                              // current voxel index along the axis
+    int step{ 0 };                                               // +1, -1 (or 0 if the ray is parallel to the planes)
+    float alphaNext{ std::numeric_limits<float>::max() };    // alpha of the next plane crossing
+    float alphaDelta{ std::numeric_limits<float>::max() };   // alpha between two plane crossings
+};
+
+// p_lowerIndex and p_upperIndex bound the voxel indices the ray may cross on this axis ([p_lowerIndex, p_upperIndex[)
+inline AxisStepper MakeAxisStepper( float p_source, float p_director, float p_halfLength, int p_lowerIndex, int p_upperIndex, float p_alphaEntry )
+{
+    AxisStepper stepper;
+    const auto entryCoordinate = p_halfLength + p_source + p_alphaEntry * p_director;    // from the volume corner
+    if( std::fabs( p_director ) <= rayFloatTolerance )
+    {
+        stepper.index = std::clamp( static_cast<int>( std::floor( entryCoordinate ) ), p_lowerIndex, p_upperIndex - 1 );
+        return stepper;
+    }
+    if( p_director > 0 )
+    {
+        stepper.index = std::clamp( static_cast<int>( std::floor( entryCoordinate ) ), p_lowerIndex, p_upperIndex - 1 );
+        stepper.step = 1;
+        stepper.alphaNext = ( static_cast<float>( stepper.index + 1 ) - p_halfLength - p_source ) / p_director;
+    }
+    else
+    {
+        stepper.index = std::clamp( static_cast<int>( std::ceil( entryCoordinate ) ) - 1, p_lowerIndex, p_upperIndex - 1 );
+        stepper.step = -1;
+        stepper.alphaNext = ( static_cast<float>( stepper.index ) - p_halfLength - p_source ) / p_director;
+    }
+    stepper.alphaDelta = 1.F / std::fabs( p_director );
+    return stepper;
+}
+
+// Incremental traversal (Jacobs et al.) of the ray between p_alphaMin and p_alphaMax, restricted to the slices [p_zBegin, p_zEnd[:
+// the ray steps from voxel to voxel by advancing the axis whose next plane crossing is the closest, so there is neither
+// alphas buffer nor sort, and the voxel index is updated by a stride instead of being recomputed from a midpoint.
+// [p_alphaMin, p_alphaMax] must already be clipped to the volume and to the slices.
+// p_visitor( voxelIndex, weight ) is called for each crossed voxel, weight being the alpha length inside the voxel
+template<typename VoxelVisitor>
+inline void TraverseRayInSlab( const FloatingVoxelRay & p_ray,
+                               const Int3 & p_volumeDimension,
+                               const Float3 & p_volumeHalfLength,
+                               int p_zBegin,
+                               int p_zEnd,
+                               float p_alphaMin,
+                               float p_alphaMax,
+                               VoxelVisitor && p_visitor )
+{
+    auto xStepper = MakeAxisStepper( p_ray.source.x, p_ray.directorVector.x, p_volumeHalfLength.x, 0, p_volumeDimension.x, p_alphaMin );
+    auto yStepper = MakeAxisStepper( p_ray.source.y, p_ray.directorVector.y, p_volumeHalfLength.y, 0, p_volumeDimension.y, p_alphaMin );
+    auto zStepper = MakeAxisStepper( p_ray.source.z, p_ray.directorVector.z, p_volumeHalfLength.z, p_zBegin, p_zEnd, p_alphaMin );
+
+    const auto yStride = p_volumeDimension.x;
+    const auto zStride = p_volumeDimension.x * p_volumeDimension.y;
+    auto voxelIndex = zStepper.index * zStride + yStepper.index * yStride + xStepper.index;
+
+    auto alphaCurrent = p_alphaMin;
+    while( true )
+    {
+        // the axis with the closest plane crossing is the next to be stepped
+        auto * nextStepper = &xStepper;
+        auto stride = 1;
+        auto lowerIndex = 0;
+        auto upperIndex = p_volumeDimension.x;
+        if( yStepper.alphaNext < nextStepper->alphaNext )
+        {
+            nextStepper = &yStepper;
+            stride = yStride;
+            upperIndex = p_volumeDimension.y;
+        }
+        if( zStepper.alphaNext < nextStepper->alphaNext )
+        {
+            nextStepper = &zStepper;
+            stride = zStride;
+            lowerIndex = p_zBegin;
+            upperIndex = p_zEnd;
+        }
+
+        const auto alphaNext = std::min( nextStepper->alphaNext, p_alphaMax );
+        const auto weight = alphaNext - alphaCurrent;
+        if( weight > rayFloatTolerance )
+        {
+            p_visitor( voxelIndex, weight );
+        }
+        if( alphaNext >= p_alphaMax )
+        {
+            return;
+        }
+
+        alphaCurrent = alphaNext;
+        nextStepper->index += nextStepper->step;
+        if( nextStepper->index < lowerIndex || nextStepper->index >= upperIndex )
+        {
+            return;
+        }
+        voxelIndex += nextStepper->step * stride;
+        nextStepper->alphaNext += nextStepper->alphaDelta;
+    }
+}
+
+// Incremental traversal of the whole volume, see TraverseRayInSlab
+template<typename VoxelVisitor>
+inline void TraverseRay( const FloatingVoxelRay & p_ray, const Int3 & p_volumeDimension, const Float3 & p_volumeHalfLength, float p_alphaMin, float p_alphaMax, VoxelVisitor && p_visitor )
+{
+    TraverseRayInSlab( p_ray, p_volumeDimension, p_volumeHalfLength, 0, p_volumeDimension.z, p_alphaMin, p_alphaMax, std::forward<VoxelVisitor>( p_visitor ) );
+}
+}    // namespace cpuprojector
@@ -0,0 +1,165 @@
+#include "modules/reconstruction/ReconstructionCheckpoint.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace    // anonymous namespace
+{
+constexpr char checkpointMagic[8] = { 'K', 'E', 'V', 'C', 'K', 'P', 'T', '\0' };
+constexpr uint32_t checkpointVersion = 1;
+constexpr size_t algorithmNameSize = 16;
+
+// fixed width fields, native (little endian) byte order
+struct CheckpointHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t volumeOffset;    // in bytes, from the start of the file
+    char algorithm[algorithmNameSize];
+    int32_t nextIteration;
+    int32_t subsetCursor;
+    int32_t nbSubsets;
+    int32_t subsetsOrdering;
+    int32_t backend;
+    int32_t volumeDimension[3];
+    uint64_t geometryFingerprint;
+    uint64_t projectionsFingerprint;
+    char reserved[48];
+};
+static_assert( sizeof( CheckpointHeader ) == 128, "the volume offset must stay 64 bytes aligned" );
+
+// FNV-1a, enough to tell a different geometry or different projections
+constexpr uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t fnvPrime = 1099511628211ULL;
+
+uint64_t Fingerprint( const void * p_data, size_t p_size, uint64_t p_fingerprint )
+{
+    const auto bytes = static_cast<const unsigned char *>( p_data );
+    for( size_t index{ 0 }; index < p_size; index++ )
+    {
+        p_fingerprint = ( p_fingerprint ^ bytes[index] ) * fnvPrime;
+    }
+    return p_fingerprint;
+}
+
+uint64_t Fingerprint( const ProjectorGeometry & p_geometry )
+{
+    auto fingerprint = Fingerprint( &p_geometry.volumeDimension, sizeof( Int3 ), fnvOffsetBasis );
+    fingerprint = Fingerprint( &p_geometry.volumeVoxelsSpacing, sizeof( Float3 ), fingerprint );
+    fingerprint = Fingerprint( &p_geometry.projectionsDimension, sizeof( Int3 ), fingerprint );
+    fingerprint = Fingerprint( &p_geometry.projectionsPixelsSpacing, sizeof( Float2 ), fingerprint );
+    fingerprint = Fingerprint( p_geometry.projectionsOriginInWorld.data(), p_geometry.projectionsOriginInWorld.size() * sizeof( Float3 ), fingerprint );
+    return Fingerprint( p_geometry.sourcesPositions.data(), p_geometry.sourcesPositions.size() * sizeof( Float3 ), fingerprint );
+}
+}    // end of anonymous namespace
+
+ReconstructionCheckpoint::ReconstructionCheckpoint( const CheckpointOptions & p_options,
+                                                    const std::string & p_algorithm,
+                                                    const ProjectorGeometry & p_geometry,
+                                                    const float * p_projectionsBuffer,
+                                                    size_t p_projectionsPixelsNumber )
+  : m_options{ p_options }
+  , m_algorithm{ p_algorithm.substr( 0, algorithmNameSize - 1 ) }
+  , m_volumeDimension{ p_geometry.volumeDimension }
+{
+    if( !this->IsEnabled() )
+    {
+        return;
+    }
+    m_options.iterationStep = std::max( 1, m_options.iterationStep );
+    m_options.subsetStep = std::max( 0, m_options.subsetStep );
+    m_geometryFingerprint = Fingerprint( p_geometry );
+    m_projectionsFingerprint = Fingerprint( p_projectionsBuffer, p_projectionsPixelsNumber * sizeof( float ), fnvOffsetBasis );
+}
+
+std::optional<CheckpointState> ReconstructionCheckpoint::Resume( const CheckpointState & p_currentState, float * p_volumeBuffer ) const
+{
+    if( !this->IsEnabled() || !m_options.resume || !std::filesystem::exists( m_options.filePath ) )
+    {
+        return std::nullopt;
+    }
+    std::ifstream file( m_options.filePath, std::ios::binary );
+    CheckpointHeader header;
+    if( !file.read( reinterpret_cast<char *>( &header ), sizeof( header ) ) || std::memcmp( header.magic, checkpointMagic, sizeof( checkpointMagic ) ) != 0
+        || header.version != checkpointVersion || header.subsetCursor < 0 || header.subsetCursor >= std::max( 1, header.nbSubsets ) )
+    {
+        std::cout << "ReconstructionCheckpoint: " << m_options.filePath << " is not a checkpoint file" << std::endl;
+        return std::nullopt;
+    }
+    header.algorithm[algorithmNameSize - 1] = '\0';
+    const auto isSameReconstruction = m_algorithm == header.algorithm && header.volumeDimension[0] == m_volumeDimension.x && header.volumeDimension[1] == m_volumeDimension.y
+                                      && header.volumeDimension[2] == m_volumeDimension.z && header.geometryFingerprint == m_geometryFingerprint
+                                      && header.projectionsFingerprint == m_projectionsFingerprint && header.nbSubsets == p_currentState.nbSubsets
+                                      && header.subsetsOrdering == p_currentState.subsetsOrdering && header.backend == static_cast<int32_t>( p_currentState.backend );
+    if( !isSameReconstruction )
+    {
+        std::cout << "ReconstructionCheckpoint: " << m_options.filePath << " belongs to another reconstruction, it is ignored" << std::endl;
+        return std::nullopt;
+    }
+
+    // the volume is read in a temporary buffer: a truncated file leaves p_volumeBuffer unchanged
+    const auto voxelsNumber = static_cast<size_t>( m_volumeDimension.x ) * m_volumeDimension.y * m_volumeDimension.z;
+    std::vector<float> volume( voxelsNumber );
+    file.seekg( header.volumeOffset );
+    if( !file.read( reinterpret_cast<char *>( volume.data() ), static_cast<std::streamsize>( voxelsNumber * sizeof( float ) ) ) )
+    {
+        std::cout << "ReconstructionCheckpoint: " << m_options.filePath << " is truncated" << std::endl;
+        return std::nullopt;
+    }
+    std::copy( volume.cbegin(), volume.cend(), p_volumeBuffer );
+
+    CheckpointState state;
+    state.nextIteration = header.nextIteration;
+    state.subsetCursor = header.subsetCursor;
+    state.nbSubsets = header.nbSubsets;
+    state.subsetsOrdering = header.subsetsOrdering;
+    state.backend = static_cast<ProjectorBackend>( header.backend );
+    return state;
+}
+
+bool ReconstructionCheckpoint::Save( const CheckpointState & p_state, const float * p_volumeBuffer ) const
+{
+    if( !this->IsEnabled() )
+    {
+        return false;
+    }
+    CheckpointHeader header{};
+    std::memcpy( header.magic, checkpointMagic, sizeof( checkpointMagic ) );
+    header.version = checkpointVersion;
+    header.volumeOffset = sizeof( CheckpointHeader );
+    std::copy( m_algorithm.cbegin(), m_algorithm.cend(), header.algorithm );
+    header.nextIteration = p_state.nextIteration;
+    header.subsetCursor = p_state.subsetCursor;
+    header.nbSubsets = p_state.nbSubsets;
+    header.subsetsOrdering = p_state.subsetsOrdering;
+    header.backend = static_cast<int32_t>( p_state.backend );
+    header.volumeDimension[0] = m_volumeDimension.x;
+    header.volumeDimension[1] = m_volumeDimension.y;
+    header.volumeDimension[2] = m_volumeDimension.z;
+    header.geometryFingerprint = m_geometryFingerprint;
+    header.projectionsFingerprint = m_projectionsFingerprint;
+
+    const auto temporaryFilePath = m_options.filePath + ".tmp";
+    {
+        std::ofstream file( temporaryFilePath, std::ios::binary | std::ios::trunc );
+        const auto voxelsNumber = static_cast<size_t>( m_volumeDimension.x ) * m_volumeDimension.y * m_volumeDimension.z;
+        if( !file.write( reinterpret_cast<const char *>( &header ), sizeof( header ) )
+            || !file.write( reinterpret_cast<const char *>( p_volumeBuffer ), static_cast<std::streamsize>( voxelsNumber * sizeof( float ) ) ) || !file.flush() )
+        {
+            std::cout << "ReconstructionCheckpoint: writing of " << temporaryFilePath << " failed" << std::endl;
+            return false;
+        }
+    }
+    std::error_code errorCode;
+    std::filesystem::rename( temporaryFilePath, m_options.filePath, errorCode );
+    if( errorCode )
+    {
+        std::cout << "ReconstructionCheckpoint: renaming of " << temporaryFilePath << " failed, " << errorCode.message() << std::endl;
+        return false;
+    }
+    return true;
+}
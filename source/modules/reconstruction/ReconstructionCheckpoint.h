@@ -0,0 +1,65 @@
+#pragma once
+
+#include "modules/reconstruction/Projector.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// Checkpointing of an iterative reconstruction, disabled by an empty file path
+struct CheckpointOptions
+{
+    std::string filePath;
+    int iterationStep{ 1 };    // the volume is saved after the iterations N - 1, 2N - 1, ...
+    int subsetStep{ 0 };       // ordered subsets reconstructions also save after the subsets N - 1, 2N - 1, ... of each iteration, 0 never
+    bool resume{ true };       // start from the checkpoint of filePath when it matches the reconstruction
+};
+
+// Position of a reconstruction between two iterations (or two subsets), with the key of its cached normalizations
+// (OrderedSubsetsProjectorCache: backend, number of subsets and ordering, the geometry being checked by fingerprint)
+struct CheckpointState
+{
+    int nextIteration{ 0 };
+    int subsetCursor{ 0 };    // next subset of nextIteration, 0 without subsets
+    int nbSubsets{ 0 };
+    int subsetsOrdering{ 0 };
+    ProjectorBackend backend{ ProjectorBackend::Cpu };
+};
+
+// Checkpoint file of a reconstruction: a 128 bytes header (algorithm, state, volume dimension, fingerprints of the
+// geometry and of the measured projections) followed by the raw float volume. The volume starts at a 64 bytes aligned
+// offset, so that the file can be memory mapped. Saving writes a temporary file renamed over the previous checkpoint:
+// a run killed while saving keeps the previous one
+class ReconstructionCheckpoint
+{
+public:
+    ReconstructionCheckpoint( const CheckpointOptions & p_options,
+                              const std::string & p_algorithm,
+                              const ProjectorGeometry & p_geometry,
+                              const float * p_projectionsBuffer,
+                              size_t p_projectionsPixelsNumber );
+    ~ReconstructionCheckpoint() = default;
+
+    bool IsEnabled() const { return !m_options.filePath.empty(); }
+    bool IsIterationSaved( int p_iteration ) const { return this->IsEnabled() && ( p_iteration + 1 ) % m_options.iterationStep == 0; }
+    // the last subset of an iteration is left to IsIterationSaved
+    bool IsSubsetSaved( int p_subsetIndex, int p_nbSubsets ) const
+    {
+        return this->IsEnabled() && m_options.subsetStep > 0 && ( p_subsetIndex + 1 ) % m_options.subsetStep == 0 && p_subsetIndex + 1 < p_nbSubsets;
+    }
+
+    // state of the checkpoint file if it matches the reconstruction (algorithm, geometry, projections and p_currentState
+    // normalizations key), its volume being loaded in p_volumeBuffer (of the geometry volume size). nullopt otherwise,
+    // p_volumeBuffer being unchanged
+    std::optional<CheckpointState> Resume( const CheckpointState & p_currentState, float * p_volumeBuffer ) const;
+
+    bool Save( const CheckpointState & p_state, const float * p_volumeBuffer ) const;
+
+private:
+    CheckpointOptions m_options;
+    std::string m_algorithm;
+    Int3 m_volumeDimension;
+    uint64_t m_geometryFingerprint{ 0 };
+    uint64_t m_projectionsFingerprint{ 0 };
+};
@@ -0,0 +1,59 @@
+#include "modules/reconstruction/ProjectorGeometry.h"
+#include "modules/reconstruction/ReconstructionCheckpoint.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( ReconstructionCheckpointTest, ReconstructionCheckpointResumesMatchingReconstructions )
+{
+    ProjectorGeometry geometry;
+    geometry.volumeDimension = { 4, 3, 2 };
+    geometry.volumeVoxelsSpacing = { 1.F, 1.F, 2.F };
+    geometry.projectionsDimension = { 5, 4, 2 };
+    geometry.projectionsPixelsSpacing = { 0.5F, 0.5F };
+    geometry.projectionsOriginInWorld = { { 0.F, 0.F, -10.F }, { 1.F, 0.F, -10.F } };
+    geometry.sourcesPositions = { { 0.F, 0.F, 600.F }, { 50.F, 0.F, 600.F } };
+    const auto projections = RandomBuffer( geometry.GetProjectionsPixelsNumber(), 50U );
+    const auto volume = RandomBuffer( geometry.GetVolumeVoxelsNumber(), 51U );
+
+    CheckpointOptions options;
+    options.filePath = ( std::filesystem::temp_directory_path() / "kevernals_checkpoint_test.ckpt" ).string();
+    options.iterationStep = 3;
+    std::filesystem::remove( options.filePath );
+    const CheckpointState state{ 6, 2, 4, 1, ProjectorBackend::CpuMatched };
+    ReconstructionCheckpoint checkpoint( options, "OSEM", geometry, projections.data(), projections.size() );
+    EXPECT_FALSE( checkpoint.IsIterationSaved( 1 ) );
+    EXPECT_TRUE( checkpoint.IsIterationSaved( 5 ) );
+    std::vector<float> resumedVolume( volume.size(), -1.F );
+    EXPECT_FALSE( checkpoint.Resume( state, resumedVolume.data() ).has_value() );
+    ASSERT_TRUE( checkpoint.Save( state, volume.data() ) );
+    EXPECT_EQ( std::filesystem::file_size( options.filePath ), 128U + volume.size() * sizeof( float ) );
+
+    const auto resumedState = checkpoint.Resume( CheckpointState{ 0, 0, 4, 1, ProjectorBackend::CpuMatched }, resumedVolume.data() );
+    ASSERT_TRUE( resumedState.has_value() );
+    EXPECT_EQ( resumedState->nextIteration, 6 );
+    EXPECT_EQ( resumedState->subsetCursor, 2 );
+    EXPECT_EQ( resumedVolume, volume );
+
+    // another normalizations key, algorithm or projections: ignored, the volume is unchanged
+    std::fill( resumedVolume.begin(), resumedVolume.end(), -1.F );
+    EXPECT_FALSE( checkpoint.Resume( CheckpointState{ 0, 0, 8, 1, ProjectorBackend::CpuMatched }, resumedVolume.data() ).has_value() );
+    EXPECT_FALSE( ReconstructionCheckpoint( options, "MLEM", geometry, projections.data(), projections.size() ).Resume( state, resumedVolume.data() ).has_value() );
+    auto otherProjections = projections;
+    otherProjections[7] += 1.F;
+    EXPECT_FALSE( ReconstructionCheckpoint( options, "OSEM", geometry, otherProjections.data(), otherProjections.size() ).Resume( state, resumedVolume.data() ).has_value() );
+    EXPECT_TRUE( std::all_of( resumedVolume.cbegin(), resumedVolume.cend(), []( float p_value ) { return p_value == -1.F; } ) );
+
+    // no resume requested
+    options.resume = false;
+    EXPECT_FALSE( ReconstructionCheckpoint( options, "OSEM", geometry, projections.data(), projections.size() ).Resume( state, resumedVolume.data() ).has_value() );
+    std::filesystem::remove( options.filePath );
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+// Data shared by the reconstruction module tests, the including test defining KEVERNALS_RESOURCES_DIR
+
+// All the *.xml geometries of the resources directory
+inline std::vector<std::filesystem::path> GeometriesFilesPaths()
+{
+    std::vector<std::filesystem::path> paths;
+    for( const auto & entry : std::filesystem::directory_iterator( KEVERNALS_RESOURCES_DIR ) )
+    {
+        if( entry.is_regular_file() && entry.path().extension() == ".xml" )
+        {
+            paths.push_back( entry.path() );
+        }
+    }
+    std::sort( paths.begin(), paths.end() );
+    return paths;
+}
+
+// Synthetic geometry the resources ones cannot express: sources moving along x and y with wide angles, anisotropic voxels
+// and pixels, detector shifted under each source
+inline ProjectorGeometry ObliqueGeometry()
+{
+    constexpr auto nbProjections{ 5 };
+    constexpr auto sourcesZ = 120.F;
+    constexpr auto detectorsZ = -15.F;
+
+    ProjectorGeometry geometry;
+    geometry.volumeDimension = { 16, 12, 6 };
+    geometry.volumeVoxelsSpacing = { 0.6F, 0.9F, 1.7F };
+    geometry.projectionsDimension = { 20, 18, nbProjections };
+    geometry.projectionsPixelsSpacing = { 0.7F, 0.55F };
+    for( auto projectionIndex{ 0 }; projectionIndex < nbProjections; projectionIndex++ )
+    {
+        const Float3 source{ 40.F - 20.F * projectionIndex, -150.F + 75.F * projectionIndex, sourcesZ };
+        // shadow of the volume center, the detector being slightly off center
+        const auto magnification = -detectorsZ / sourcesZ;
+        const auto shadowX = -source.x * magnification + 0.3F * projectionIndex;
+        const auto shadowY = -source.y * magnification - 0.2F * projectionIndex;
+        geometry.sourcesPositions.push_back( source );
+        geometry.projectionsOriginInWorld.push_back( { shadowX - 0.5F * geometry.projectionsDimension.x * geometry.projectionsPixelsSpacing.x,
+                                                       shadowY - 0.5F * geometry.projectionsDimension.y * geometry.projectionsPixelsSpacing.y, detectorsZ } );
+    }
+    return geometry;
+}
+
+inline std::vector<float> RandomBuffer( int p_size, unsigned int p_seed )
+{
+    std::mt19937 generator( p_seed );
+    std::uniform_real_distribution<float> distribution( 0.F, 1.F );
+    std::vector<float> buffer( p_size );
+    std::generate( buffer.begin(), buffer.end(), [&]() { return distribution( generator ); } );
+    return buffer;
+}
+
+inline std::vector<float> SmoothVolume( const ProjectorGeometry & p_geometry )
+{
+    const auto & dimension = p_geometry.volumeDimension;
+    std::vector<float> volume( p_geometry.GetVolumeVoxelsNumber() );
+    for( auto z{ 0 }; z < dimension.z; z++ )
+    {
+        for( auto y{ 0 }; y < dimension.y; y++ )
+        {
+            for( auto x{ 0 }; x < dimension.x; x++ )
+            {
+                const auto value = 1. + 0.5 * std::sin( 0.2 * x ) * std::cos( 0.15 * y ) + 0.4 * z / dimension.z;
+                volume[( z * dimension.y + y ) * dimension.x + x] = static_cast<float>( value );
+            }
+        }
+    }
+    return volume;
+}
+
+inline double Dot( const std::vector<float> & p_first, const std::vector<float> & p_second )
+{
+    auto dot{ 0. };
+    for( auto index{ 0U }; index < p_first.size(); index++ )
+    {
+        dot += static_cast<double>( p_first[index] ) * static_cast<double>( p_second[index] );
+    }
+    return dot;
+}
@@ -4,16 +4,29 @@
 #include "commons/Result.h"
 #include "modules/dataHandling/PhantomMaker.h"
 #include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ConvergenceMonitor.h"
+#include "modules/reconstruction/ElementWise.h"
+#include "modules/reconstruction/FilteredBackProjection.h"
+#include "modules/reconstruction/LeastSquares.h"
+#include "modules/reconstruction/MatrixInversionTomosynthesis.h"
+#include "modules/reconstruction/Multiresolution.h"
+#include "modules/reconstruction/OrderedSubsets.h"
 #include "modules/reconstruction/Projector.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+#include "modules/reconstruction/ReconstructionCheckpoint.h"
 #include "modules/reconstruction/ReconstructorsErrorCode.h"
+#include "modules/reconstruction/ShiftAndAdd.h"
+#include "modules/reconstruction/TotalVariation.h"
+#include "modules/reconstruction/VerboseImageWriter.h"
 
-#include <vtkExtractVOI.h>
-#include <vtkImageAppend.h>
-#include <vtkImageConstantPad.h>
-#include <vtkImageTranslateExtent.h>
-#include <vtkImageWeightedSum.h>
 #include <vtkTIFFWriter.h>
 
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <functional>
+#include <numeric>
+
 namespace recons
 {
 Result<ImageDataPtr> ART( TomoGeometry * p_tomoGeometry,
@@ -21,7 +34,10 @@ Result<ImageDataPtr> ART( TomoGeometry * p_tomoGeometry,
                           int p_iterationNumber,
                           float p_relaxationCoefficient,
                           std::optional<ImageDataPtr> p_initialVolume,
-                          std::optional<std::string> p_outputDirectoryPath )
+                          std::optional<std::string> p_outputDirectoryPath,
+                          const StoppingCriteria & p_stoppingCriteria = StoppingCriteria{},
+                          const VerboseOutputOptions & p_verboseOptions = VerboseOutputOptions{},
+                          const CheckpointOptions & p_checkpointOptions = CheckpointOptions{} )
 {
     ImageDataPtr resultingVolume;
 
@@ -42,14 +58,12 @@ Result<ImageDataPtr> ART( TomoGeometry * p_tomoGeometry,
         return make_error_code( ReconstructorsErrorCode::ART );
     }
 
-    auto verboseMode = p_outputDirectoryPath.has_value();
-
-    if( verboseMode )
+    // verbose mode images are written in the background, all of them before returning
+    std::optional<VerboseImageWriter> verboseWriter;
+    if( p_outputDirectoryPath.has_value() )
     {
-        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "initialVolume.tiff" ).c_str() );
-        tiffWriterPhantom->SetInputData( resultingVolume );
-        tiffWriterPhantom->Write();
+        verboseWriter.emplace( p_outputDirectoryPath.value(), p_verboseOptions );
+        verboseWriter->WriteVolume( resultingVolume, "initialVolume.tiff" );
     }
 
 
@@ -60,74 +74,85 @@ Result<ImageDataPtr> ART( TomoGeometry * p_tomoGeometry,
     auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
 
 
-    Projector projector{ p_tomoGeometry };
+    // geometry tables, work buffers and iteration images are allocated once
+    ProjectorPlan projectorPlan{ p_tomoGeometry };
+    auto currentProjection = projectorPlan.CreateProjectionsImage();
+    auto errorBackProjection = projectorPlan.CreateVolumeImage();
+
+    // residual norms are accumulated in the error pass, volume changes in the update pass
+    const auto projectionsPixelsNumber = projectionsImageDimensions[0] * projectionsImageDimensions[1] * projectionsImageDimensions[2];
+    ConvergenceMonitor convergenceMonitor( p_stoppingCriteria, std::sqrt( elementwise::SquaredNorm( projectionsImageBuffer, projectionsPixelsNumber ) ) );
+
+    // a checkpoint file of the same reconstruction restarts it at the saved iteration
+    ReconstructionCheckpoint checkpoint( p_checkpointOptions, "ART", projectorPlan.GetGeometry(), projectionsImageBuffer, projectionsPixelsNumber );
+    auto firstIteration{ 0 };
+    if( const auto resumedState = checkpoint.Resume( CheckpointState{ 0, 0, 0, 0, projectorPlan.GetBackend() }, resultingVolumeBuffer ) )
+    {
+        firstIteration = resumedState->nextIteration;
+        std::cout << "ART: resumed at iteration " << std::to_string( firstIteration ) << " from " << p_checkpointOptions.filePath << std::endl;
+    }
     std::cout << "ART: reconstruction started" << std::endl;
-    for( auto iteration{ 0 }; iteration < p_iterationNumber; iteration++ )
+    for( auto iteration = firstIteration; iteration < p_iterationNumber; iteration++ )
     {
-        // step 1. projection
-        auto currentProjection = projector.PerformProjection( resultingVolume );
+        const auto isIterationWritten = verboseWriter.has_value() && verboseWriter->IsIterationWritten( iteration );
 
-        if( currentProjection == nullptr )
+        // step 1. projection
+        if( !projectorPlan.Project( resultingVolume, currentProjection ) )
         {
-            std::cout << "ART: current projection is nullptr" << std::endl;
+            std::cout << "ART: current projection failed" << std::endl;
             return make_error_code( ReconstructorsErrorCode::ART );
         }
 
-        if( verboseMode )
+        if( isIterationWritten )
         {
-            auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-            tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "currentProjectionStep" + std::to_string( iteration ) + ".tiff" ).c_str() );
-            tiffWriterPhantom->SetInputData( currentProjection );
-            tiffWriterPhantom->Write();
+            verboseWriter->WriteProjections( currentProjection, "currentProjectionStep" + std::to_string( iteration ) + ".tiff" );
         }
 
         // step 2. error computation
+        auto squaredResidualNorm{ 0. };
         auto currentDimensions = currentProjection->GetDimensions();
         auto currentBuffer = static_cast<float *>( currentProjection->GetScalarPointer() );
         if( currentDimensions[0] == projectionsImageDimensions[0] && currentDimensions[1] == projectionsImageDimensions[1] && currentDimensions[2] == projectionsImageDimensions[2] )
         {
-            auto totalDim = currentDimensions[0] * currentDimensions[1] * currentDimensions[2];
-            for( auto voxelIndex{ 0 }; voxelIndex < totalDim; voxelIndex++ )
-            {
-                currentBuffer[voxelIndex] = p_relaxationCoefficient * ( projectionsImageBuffer[voxelIndex] - currentBuffer[voxelIndex] );
-            }
+            squaredResidualNorm = elementwise::Residual( projectionsImageBuffer, nullptr, p_relaxationCoefficient, currentBuffer, projectionsPixelsNumber );
         }
 
-        if( verboseMode )
+        if( isIterationWritten )
         {
-            auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-            tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "currentCorrectedProjectionStep" + std::to_string( iteration ) + ".tiff" ).c_str() );
-            tiffWriterPhantom->SetInputData( currentProjection );
-            tiffWriterPhantom->Write();
+            verboseWriter->WriteProjections( currentProjection, "currentCorrectedProjectionStep" + std::to_string( iteration ) + ".tiff" );
         }
 
         // step 3. error backProjection
-        auto errorBackProjection = projector.PerformBackProjection( currentProjection );
-
-        if( errorBackProjection == nullptr )
+        if( !projectorPlan.BackProject( currentProjection, errorBackProjection ) )
         {
-            std::cout << "ART: current backprojection is nullptr" << std::endl;
+            std::cout << "ART: current backprojection failed" << std::endl;
             return make_error_code( ReconstructorsErrorCode::ART );
         }
         // step 4. add backProjectedError
+        elementwise::UpdateNorms updateNorms;
         auto errorBackProjectionDimensions = errorBackProjection->GetDimensions();
         auto errorBackProjectioncurrentBuffer = static_cast<float *>( errorBackProjection->GetScalarPointer() );
         if( errorBackProjectionDimensions[0] == resultingVolumeDimensions[0] && errorBackProjectionDimensions[1] == resultingVolumeDimensions[1] && errorBackProjectionDimensions[2] == resultingVolumeDimensions[2] )
         {
             auto totalDim = errorBackProjectionDimensions[0] * errorBackProjectionDimensions[1] * errorBackProjectionDimensions[2];
-            for( auto voxelIndex{ 0 }; voxelIndex < totalDim; voxelIndex++ )
-            {
-                resultingVolumeBuffer[voxelIndex] += errorBackProjectioncurrentBuffer[voxelIndex];
-            }
+            updateNorms = elementwise::Axpy( 1.F, errorBackProjectioncurrentBuffer, nullptr, resultingVolumeBuffer, totalDim, convergenceMonitor.IsVolumeChangeMonitored() );
         }
 
 
-        if( verboseMode )
+        if( isIterationWritten )
+        {
+            verboseWriter->WriteVolume( resultingVolume, "reconstructionstep" + std::to_string( iteration ) + ".tiff" );
+        }
+        if( checkpoint.IsIterationSaved( iteration ) )
+        {
+            checkpoint.Save( CheckpointState{ iteration + 1, 0, 0, 0, projectorPlan.GetBackend() }, resultingVolumeBuffer );
+        }
+
+        const auto relativeVolumeChange = updateNorms.squaredNorm > 0. ? std::sqrt( updateNorms.squaredChangeNorm / updateNorms.squaredNorm ) : 0.;
+        if( convergenceMonitor.Update( iteration, std::sqrt( squaredResidualNorm ), relativeVolumeChange ) )
         {
-            auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-            tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "reconstructionstep" + std::to_string( iteration ) + ".tiff" ).c_str() );
-            tiffWriterPhantom->SetInputData( resultingVolume );
-            tiffWriterPhantom->Write();
+            std::cout << "ART: stopped after iteration " << std::to_string( iteration ) << ", " << ToString( convergenceMonitor.GetStoppingReason() ) << std::endl;
+            break;
         }
     }
     return resultingVolume;
@@ -138,7 +163,10 @@ Result<ImageDataPtr> MLEM( TomoGeometry * p_tomoGeometry,
                            int p_iterationNumber,
                            float p_relaxationCoefficient,
                            std::optional<ImageDataPtr> p_initialVolume,
-                           std::optional<std::string> p_outputDirectoryPath )
+                           std::optional<std::string> p_outputDirectoryPath,
+                           const StoppingCriteria & p_stoppingCriteria = StoppingCriteria{},
+                           const VerboseOutputOptions & p_verboseOptions = VerboseOutputOptions{},
+                           const CheckpointOptions & p_checkpointOptions = CheckpointOptions{} )
 {
     ImageDataPtr resultingVolume;
 
@@ -159,14 +187,12 @@ Result<ImageDataPtr> MLEM( TomoGeometry * p_tomoGeometry,
         return make_error_code( ReconstructorsErrorCode::ART );
     }
 
-    auto verboseMode = p_outputDirectoryPath.has_value();
-
-    if( verboseMode )
+    // verbose mode images are written in the background, all of them before returning
+    std::optional<VerboseImageWriter> verboseWriter;
+    if( p_outputDirectoryPath.has_value() )
     {
-        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "initialVolume.tiff" ).c_str() );
-        tiffWriterPhantom->SetInputData( resultingVolume );
-        tiffWriterPhantom->Write();
+        verboseWriter.emplace( p_outputDirectoryPath.value(), p_verboseOptions );
+        verboseWriter->WriteVolume( resultingVolume, "initialVolume.tiff" );
     }
 
 
@@ -177,205 +203,873 @@ Result<ImageDataPtr> MLEM( TomoGeometry * p_tomoGeometry,
     auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
 
 
-    Projector projector{ p_tomoGeometry };
+    // geometry tables, work buffers and iteration images are allocated once
+    ProjectorPlan projectorPlan{ p_tomoGeometry };
+    auto currentProjection = projectorPlan.CreateProjectionsImage();
+    auto errorBackProjection = projectorPlan.CreateVolumeImage();
+
+    // residual norms are accumulated in the error pass, volume changes in the update pass
+    const auto projectionsPixelsNumber = projectionsImageDimensions[0] * projectionsImageDimensions[1] * projectionsImageDimensions[2];
+    ConvergenceMonitor convergenceMonitor( p_stoppingCriteria, std::sqrt( elementwise::SquaredNorm( projectionsImageBuffer, projectionsPixelsNumber ) ) );
+
+    // a checkpoint file of the same reconstruction restarts it at the saved iteration
+    ReconstructionCheckpoint checkpoint( p_checkpointOptions, "MLEM", projectorPlan.GetGeometry(), projectionsImageBuffer, projectionsPixelsNumber );
+    auto firstIteration{ 0 };
+    if( const auto resumedState = checkpoint.Resume( CheckpointState{ 0, 0, 0, 0, projectorPlan.GetBackend() }, resultingVolumeBuffer ) )
+    {
+        firstIteration = resumedState->nextIteration;
+        std::cout << "MLEM: resumed at iteration " << std::to_string( firstIteration ) << " from " << p_checkpointOptions.filePath << std::endl;
+    }
     std::cout << "MLEM: reconstruction started" << std::endl;
-    for( auto iteration{ 0 }; iteration < p_iterationNumber; iteration++ )
+    for( auto iteration = firstIteration; iteration < p_iterationNumber; iteration++ )
     {
-        // step 1. projection
-        auto currentProjection = projector.PerformProjection( resultingVolume );
+        const auto isIterationWritten = verboseWriter.has_value() && verboseWriter->IsIterationWritten( iteration );
 
-        if( currentProjection == nullptr )
+        // step 1. projection
+        if( !projectorPlan.Project( resultingVolume, currentProjection ) )
         {
-            std::cout << "MLEM: current projection is nullptr" << std::endl;
+            std::cout << "MLEM: current projection failed" << std::endl;
             return make_error_code( ReconstructorsErrorCode::ART );
         }
 
-        if( verboseMode )
+        if( isIterationWritten )
         {
-            auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-            tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "currentProjectionStep" + std::to_string( iteration ) + ".tiff" ).c_str() );
-            tiffWriterPhantom->SetInputData( currentProjection );
-            tiffWriterPhantom->Write();
+            verboseWriter->WriteProjections( currentProjection, "currentProjectionStep" + std::to_string( iteration ) + ".tiff" );
         }
 
         // step 2. error computation
+        auto squaredResidualNorm{ 0. };
         auto currentDimensions = currentProjection->GetDimensions();
         auto currentBuffer = static_cast<float *>( currentProjection->GetScalarPointer() );
         if( currentDimensions[0] == projectionsImageDimensions[0] && currentDimensions[1] == projectionsImageDimensions[1] && currentDimensions[2] == projectionsImageDimensions[2] )
         {
-            auto totalDim = currentDimensions[0] * currentDimensions[1] * currentDimensions[2];
-            for( auto voxelIndex{ 0 }; voxelIndex < totalDim; voxelIndex++ )
-            {
-                if( !AlmostEqualRelative( currentBuffer[voxelIndex], 0.F ) )
-                {
-                    currentBuffer[voxelIndex] = p_relaxationCoefficient * ( projectionsImageBuffer[voxelIndex] / currentBuffer[voxelIndex] );
-                }
-            }
+            // null projections stay null
+            squaredResidualNorm = elementwise::Ratio( projectionsImageBuffer, p_relaxationCoefficient, 0.F, currentBuffer, projectionsPixelsNumber );
         }
 
-        if( verboseMode )
+        if( isIterationWritten )
         {
-            auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-            tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "currentCorrectedProjectionStep" + std::to_string( iteration ) + ".tiff" ).c_str() );
-            tiffWriterPhantom->SetInputData( currentProjection );
-            tiffWriterPhantom->Write();
+            verboseWriter->WriteProjections( currentProjection, "currentCorrectedProjectionStep" + std::to_string( iteration ) + ".tiff" );
         }
 
         // step 3. error backProjection
-        auto errorBackProjection = projector.PerformBackProjection( currentProjection );
-
-        if( errorBackProjection == nullptr )
+        if( !projectorPlan.BackProject( currentProjection, errorBackProjection ) )
         {
-            std::cout << "MLEM: current backprojection is nullptr" << std::endl;
+            std::cout << "MLEM: current backprojection failed" << std::endl;
             return make_error_code( ReconstructorsErrorCode::ART );
         }
         // step 4. add backProjectedError
+        elementwise::UpdateNorms updateNorms;
         auto errorBackProjectionDimensions = errorBackProjection->GetDimensions();
         auto errorBackProjectioncurrentBuffer = static_cast<float *>( errorBackProjection->GetScalarPointer() );
         if( errorBackProjectionDimensions[0] == resultingVolumeDimensions[0] && errorBackProjectionDimensions[1] == resultingVolumeDimensions[1] && errorBackProjectionDimensions[2] == resultingVolumeDimensions[2] )
         {
             auto totalDim = errorBackProjectionDimensions[0] * errorBackProjectionDimensions[1] * errorBackProjectionDimensions[2];
-            for( auto voxelIndex{ 0 }; voxelIndex < totalDim; voxelIndex++ )
+            updateNorms = elementwise::Multiply( errorBackProjectioncurrentBuffer, nullptr, 1.F, resultingVolumeBuffer, totalDim, convergenceMonitor.IsVolumeChangeMonitored() );
+        }
+
+        if( isIterationWritten )
+        {
+            verboseWriter->WriteVolume( resultingVolume, "reconstructionstep" + std::to_string( iteration ) + ".tiff" );
+        }
+        if( checkpoint.IsIterationSaved( iteration ) )
+        {
+            checkpoint.Save( CheckpointState{ iteration + 1, 0, 0, 0, projectorPlan.GetBackend() }, resultingVolumeBuffer );
+        }
+
+        const auto relativeVolumeChange = updateNorms.squaredNorm > 0. ? std::sqrt( updateNorms.squaredChangeNorm / updateNorms.squaredNorm ) : 0.;
+        if( convergenceMonitor.Update( iteration, std::sqrt( squaredResidualNorm ), relativeVolumeChange ) )
+        {
+            std::cout << "MLEM: stopped after iteration " << std::to_string( iteration ) << ", " << ToString( convergenceMonitor.GetStoppingReason() ) << std::endl;
+            break;
+        }
+    }
+    return resultingVolume;
+}
+
+// Iterative reconstructor driven by Multiresolution: ( geometry, projections, iteration number, initial volume, output directory )
+using IterativeReconstructor = std::function<Result<ImageDataPtr>( TomoGeometry *, ImageDataPtr, int, std::optional<ImageDataPtr>, std::optional<std::string> )>;
+
+// Coarse-to-fine reconstruction: the levels run p_reconstructor (e.g. ART or MLEM) on a copy of p_tomoGeometry whose
+// volume grid is downsampled by their factor, each result being trilinearly upsampled as the initial volume of the next
+// level. The low frequencies converge on the cheap grids, the full resolution iterations only refine the details. The
+// projections are kept at full resolution, p_tomoGeometry is not changed. In verbose mode, the images of level i are
+// written with the prefix "level<i>_"
+Result<ImageDataPtr> Multiresolution( TomoGeometry * p_tomoGeometry,
+                                      ImageDataPtr p_projectionImages,
+                                      const std::vector<MultiresolutionLevel> & p_levels,
+                                      const IterativeReconstructor & p_reconstructor,
+                                      std::optional<ImageDataPtr> p_initialVolume,
+                                      std::optional<std::string> p_outputDirectoryPath )
+{
+    if( p_tomoGeometry == nullptr || p_levels.empty() )
+    {
+        std::cout << "Multiresolution: no geometry or no level" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::Multiresolution );
+    }
+
+    auto currentVolume = p_initialVolume;
+    for( auto levelIndex{ 0 }; levelIndex < static_cast<int>( p_levels.size() ); levelIndex++ )
+    {
+        const auto & level = p_levels[levelIndex];
+        std::cout << "Multiresolution: level " << std::to_string( levelIndex ) << ", downsampling " << std::to_string( level.downsamplingFactor ) << std::endl;
+        auto levelGeometry = multiresolution::CoarseGeometry( *p_tomoGeometry, level.downsamplingFactor );
+
+        // previous result (or given initial volume) brought to the grid of the level
+        const auto volumeSize = levelGeometry.volumeSize3D();
+        const auto voxelSpacing = levelGeometry.volumeVoxelSpacing();
+        if( currentVolume.has_value() && currentVolume.value() != nullptr )
+        {
+            auto previousDimensions = currentVolume.value()->GetDimensions();
+            if( previousDimensions[0] != volumeSize.x || previousDimensions[1] != volumeSize.y || previousDimensions[2] != volumeSize.z )
             {
-                resultingVolumeBuffer[voxelIndex] *= errorBackProjectioncurrentBuffer[voxelIndex];
+                auto levelVolume = ImageDataPtr::New();
+                levelVolume->SetDimensions( volumeSize.x, volumeSize.y, volumeSize.z );
+                levelVolume->SetSpacing( voxelSpacing.x, voxelSpacing.y, voxelSpacing.z );
+                levelVolume->AllocateScalars( VTK_FLOAT, 1 );
+                multiresolution::ResampleVolume( static_cast<const float *>( currentVolume.value()->GetScalarPointer() ),
+                                                 { previousDimensions[0], previousDimensions[1], previousDimensions[2] },
+                                                 static_cast<float *>( levelVolume->GetScalarPointer() ),
+                                                 { volumeSize.x, volumeSize.y, volumeSize.z } );
+                currentVolume = levelVolume;
             }
         }
 
-        if( verboseMode )
+        std::optional<std::string> levelOutputDirectoryPath;
+        if( p_outputDirectoryPath.has_value() )
+        {
+            levelOutputDirectoryPath = p_outputDirectoryPath.value() + "level" + std::to_string( levelIndex ) + "_";
+        }
+        auto levelResult = p_reconstructor( &levelGeometry, p_projectionImages, level.iterationNumber, currentVolume, levelOutputDirectoryPath );
+        if( levelResult.has_error() )
         {
-            auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
-            tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "reconstructionstep" + std::to_string( iteration ) + ".tiff" ).c_str() );
-            tiffWriterPhantom->SetInputData( resultingVolume );
-            tiffWriterPhantom->Write();
+            std::cout << "Multiresolution: level " << std::to_string( levelIndex ) << " failed" << std::endl;
+            return levelResult;
+        }
+        currentVolume = levelResult.value();
+    }
+    return currentVolume.value();
+}
+
+// OS-SART: for each subset s of the ordered subsets, x += lambda * C_s ( A_s^T ( R_s ( b - A_s x ) ) ),
+// R and C_s being the inverse rays sums and subset voxels sums cached by p_orderedSubsetsProjector.
+// The projector can then be reused by the next reconstructions of its geometry, but not by concurrent ones.
+// Checkpoints record the next subset (CheckpointOptions::subsetStep), so that a run can resume within an iteration.
+// The residual norm given to the stopping criteria is accumulated over the subsets of an iteration, each subset being
+// measured at the volume it is projected from, and the volume change is bounded by the sum of the subsets changes.
+// A resumed iteration which does not start at the first subset is not monitored.
+Result<ImageDataPtr> OSSART( OrderedSubsetsProjector & p_orderedSubsetsProjector,
+                             ImageDataPtr p_projectionImages,
+                             int p_iterationNumber,
+                             float p_relaxationCoefficient,
+                             std::optional<ImageDataPtr> p_initialVolume,
+                             std::optional<std::string> p_outputDirectoryPath,
+                             const StoppingCriteria & p_stoppingCriteria = StoppingCriteria{},
+                             const VerboseOutputOptions & p_verboseOptions = VerboseOutputOptions{},
+                             const CheckpointOptions & p_checkpointOptions = CheckpointOptions{} )
+{
+    if( !p_orderedSubsetsProjector.IsValid() )
+    {
+        std::cout << "OS-SART: invalid ordered subsets projector" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSSART );
+    }
+    const auto & geometry = p_orderedSubsetsProjector.GetGeometry();
+    if( p_projectionImages == nullptr || p_projectionImages->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << "OS-SART: projections are not float images" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSSART );
+    }
+    auto projectionsImageDimensions = p_projectionImages->GetDimensions();
+    if( projectionsImageDimensions[0] != geometry.projectionsDimension.x || projectionsImageDimensions[1] != geometry.projectionsDimension.y || projectionsImageDimensions[2] != geometry.projectionsDimension.z )
+    {
+        std::cout << "OS-SART: projections dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSSART );
+    }
+
+    ImageDataPtr resultingVolume;
+
+    std::cout << "OS-SART: initial volume retrieval" << std::endl;
+    if( p_initialVolume.has_value() )
+    {
+        resultingVolume = p_initialVolume.value();
+    }
+    else
+    {
+        resultingVolume = p_orderedSubsetsProjector.CreateVolumeImage();
+        auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
+        std::fill( resultingVolumeBuffer, resultingVolumeBuffer + geometry.GetVolumeVoxelsNumber(), 0.F );
+    }
+
+    if( resultingVolume == nullptr )
+    {
+        std::cout << "OS-SART: initial data is nullptr" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSSART );
+    }
+    auto resultingVolumeDimensions = resultingVolume->GetDimensions();
+    if( resultingVolumeDimensions[0] != geometry.volumeDimension.x || resultingVolumeDimensions[1] != geometry.volumeDimension.y || resultingVolumeDimensions[2] != geometry.volumeDimension.z )
+    {
+        std::cout << "OS-SART: initial volume dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSSART );
+    }
+
+    // verbose mode images are written in the background, all of them before returning
+    std::optional<VerboseImageWriter> verboseWriter;
+    if( p_outputDirectoryPath.has_value() )
+    {
+        verboseWriter.emplace( p_outputDirectoryPath.value(), p_verboseOptions );
+        verboseWriter->WriteVolume( resultingVolume, "initialVolume.tiff" );
+    }
+
+    auto projectionsImageBuffer = static_cast<float *>( p_projectionImages->GetScalarPointer() );
+    auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
+    const auto & raysInverseSums = p_orderedSubsetsProjector.GetRaysInverseSums();
+    const auto projectionPixelsNumber = geometry.projectionsDimension.x * geometry.projectionsDimension.y;
+
+    // iteration images are allocated once
+    auto currentProjection = p_orderedSubsetsProjector.CreateProjectionsImage();
+    auto errorBackProjection = p_orderedSubsetsProjector.CreateVolumeImage();
+    auto currentBuffer = static_cast<float *>( currentProjection->GetScalarPointer() );
+    auto errorBackProjectionBuffer = static_cast<float *>( errorBackProjection->GetScalarPointer() );
+
+    // residual norms are accumulated per projection in the error pass of their subset, volume changes in the update pass
+    ConvergenceMonitor convergenceMonitor( p_stoppingCriteria, std::sqrt( elementwise::SquaredNorm( projectionsImageBuffer, geometry.GetProjectionsPixelsNumber() ) ) );
+    std::vector<double> projectionsSquaredResiduals( geometry.projectionsDimension.z, 0. );
+
+    // a checkpoint file of the same reconstruction, with the same subsets, restarts it at the saved subset
+    const auto nbSubsets = p_orderedSubsetsProjector.GetNbSubsets();
+    const auto ordering = static_cast<int>( p_orderedSubsetsProjector.GetOrdering() );
+    const auto backend = p_orderedSubsetsProjector.GetBackend();
+    ReconstructionCheckpoint checkpoint( p_checkpointOptions, "OS-SART", geometry, projectionsImageBuffer, geometry.GetProjectionsPixelsNumber() );
+    auto firstIteration{ 0 };
+    auto firstSubset{ 0 };
+    if( const auto resumedState = checkpoint.Resume( CheckpointState{ 0, 0, nbSubsets, ordering, backend }, resultingVolumeBuffer ) )
+    {
+        firstIteration = resumedState->nextIteration;
+        firstSubset = resumedState->subsetCursor;
+        std::cout << "OS-SART: resumed at iteration " << std::to_string( firstIteration ) << ", subset " << std::to_string( firstSubset ) << " from " << p_checkpointOptions.filePath << std::endl;
+    }
+    std::cout << "OS-SART: reconstruction started" << std::endl;
+    for( auto iteration = firstIteration; iteration < p_iterationNumber; iteration++ )
+    {
+        const auto isIterationWritten = verboseWriter.has_value() && verboseWriter->IsIterationWritten( iteration );
+        const auto isIterationMonitored = iteration != firstIteration || firstSubset == 0;
+        auto volumeChangeNorm{ 0. };
+        auto squaredVolumeNorm{ 0. };
+        for( auto subsetIndex = iteration == firstIteration ? firstSubset : 0; subsetIndex < nbSubsets; subsetIndex++ )
+        {
+            auto & projectorPlan = p_orderedSubsetsProjector.GetPlan( subsetIndex );
+            const auto & subset = projectorPlan.GetProjectionsSubset();
+
+            // step 1. projection of the subset
+            if( !projectorPlan.Project( resultingVolume, currentProjection ) )
+            {
+                std::cout << "OS-SART: current projection failed" << std::endl;
+                return make_error_code( ReconstructorsErrorCode::OSSART );
+            }
+
+            // step 2. normalized error on the subset projections, in one pass
+            std::for_each( std::execution::par, subset.cbegin(), subset.cend(), [&]( int p_projectionIndex ) {
+                const auto offset = static_cast<size_t>( p_projectionIndex ) * projectionPixelsNumber;
+                projectionsSquaredResiduals[p_projectionIndex] = elementwise::Residual( projectionsImageBuffer + offset, raysInverseSums.data() + offset, 1.F, currentBuffer + offset, projectionPixelsNumber );
+            } );
+
+            // step 3. error backProjection
+            if( !projectorPlan.BackProject( currentProjection, errorBackProjection ) )
+            {
+                std::cout << "OS-SART: current backprojection failed" << std::endl;
+                return make_error_code( ReconstructorsErrorCode::OSSART );
+            }
+
+            // step 4. normalized and relaxed update, in one pass
+            const auto & voxelsInverseSums = p_orderedSubsetsProjector.GetVoxelsInverseSums( subsetIndex );
+            const auto updateNorms = elementwise::Axpy( p_relaxationCoefficient, errorBackProjectionBuffer, voxelsInverseSums.data(), resultingVolumeBuffer, geometry.GetVolumeVoxelsNumber(), convergenceMonitor.IsVolumeChangeMonitored() );
+            volumeChangeNorm += std::sqrt( updateNorms.squaredChangeNorm );
+            squaredVolumeNorm = updateNorms.squaredNorm;
+            if( checkpoint.IsSubsetSaved( subsetIndex, nbSubsets ) )
+            {
+                checkpoint.Save( CheckpointState{ iteration, subsetIndex + 1, nbSubsets, ordering, backend }, resultingVolumeBuffer );
+            }
+        }
+
+        if( isIterationWritten )
+        {
+            verboseWriter->WriteVolume( resultingVolume, "reconstructionstep" + std::to_string( iteration ) + ".tiff" );
+        }
+        if( checkpoint.IsIterationSaved( iteration ) )
+        {
+            checkpoint.Save( CheckpointState{ iteration + 1, 0, nbSubsets, ordering, backend }, resultingVolumeBuffer );
+        }
+
+        if( !isIterationMonitored )
+        {
+            continue;
+        }
+        const auto squaredResidualNorm = std::accumulate( projectionsSquaredResiduals.cbegin(), projectionsSquaredResiduals.cend(), 0. );
+        const auto relativeVolumeChange = squaredVolumeNorm > 0. ? volumeChangeNorm / std::sqrt( squaredVolumeNorm ) : 0.;
+        if( convergenceMonitor.Update( iteration, std::sqrt( squaredResidualNorm ), relativeVolumeChange ) )
+        {
+            std::cout << "OS-SART: stopped after iteration " << std::to_string( iteration ) << ", " << ToString( convergenceMonitor.GetStoppingReason() ) << std::endl;
+            break;
         }
     }
     return resultingVolume;
 }
 
+Result<ImageDataPtr> OSSART( TomoGeometry * p_tomoGeometry,
+                             ImageDataPtr p_projectionImages,
+                             int p_iterationNumber,
+                             int p_nbSubsets,
+                             float p_relaxationCoefficient,
+                             std::optional<ImageDataPtr> p_initialVolume,
+                             std::optional<std::string> p_outputDirectoryPath,
+                             const StoppingCriteria & p_stoppingCriteria = StoppingCriteria{},
+                             const VerboseOutputOptions & p_verboseOptions = VerboseOutputOptions{},
+                             const CheckpointOptions & p_checkpointOptions = CheckpointOptions{} )
+{
+    // normalizations are computed at the first reconstruction of the geometry only, the cached projector being lent to
+    // this reconstruction alone
+    auto orderedSubsetsProjector = OrderedSubsetsProjectorCache::Instance().Get( p_tomoGeometry, DefaultProjectorBackend(), p_nbSubsets, SubsetsOrdering::InterleavedBitReversed );
+    if( orderedSubsetsProjector == nullptr )
+    {
+        return make_error_code( ReconstructorsErrorCode::OSSART );
+    }
+    return OSSART( *orderedSubsetsProjector, p_projectionImages, p_iterationNumber, p_relaxationCoefficient, p_initialVolume, p_outputDirectoryPath, p_stoppingCriteria, p_verboseOptions, p_checkpointOptions );
+}
 
-Result<ImageDataPtr> BackProjection( TomoGeometry * p_tomoGeometry,
-                                     ImageDataPtr p_projectionImages )
+// OSEM: for each subset s of the ordered subsets, x *= ( S_s ( A_s^T ( b / A_s x ) ) )^h, S_s being the inverse
+// sensitivity image of the subset (A_s^T 1) cached by p_orderedSubsetsProjector.
+// h = 1 is the plain OSEM update; h in ]1, 2[ over-relaxes it (power acceleration) while keeping the volume nonnegative.
+// Voxels seen by no ray of the subset, and rays with a null projection, are left out of the update.
+// As for OS-SART, the projector can be reused by the next reconstructions of its geometry, but not by concurrent ones,
+// checkpoints can be saved between subsets, and the stopping criteria are applied to the norms accumulated over the
+// subsets of an iteration.
+Result<ImageDataPtr> OSEM( OrderedSubsetsProjector & p_orderedSubsetsProjector,
+                           ImageDataPtr p_projectionImages,
+                           int p_iterationNumber,
+                           float p_accelerationExponent,
+                           std::optional<ImageDataPtr> p_initialVolume,
+                           std::optional<std::string> p_outputDirectoryPath,
+                           const StoppingCriteria & p_stoppingCriteria = StoppingCriteria{},
+                           const VerboseOutputOptions & p_verboseOptions = VerboseOutputOptions{},
+                           const CheckpointOptions & p_checkpointOptions = CheckpointOptions{} )
 {
-    Projector projector{ p_tomoGeometry };
-    return projector.PerformBackProjection( p_projectionImages );
+    constexpr auto projectionFloatTolerance = 0.000001F;
+    if( !p_orderedSubsetsProjector.IsValid() )
+    {
+        std::cout << "OSEM: invalid ordered subsets projector" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSEM );
+    }
+    if( p_accelerationExponent < 1.F || p_accelerationExponent >= 2.F )
+    {
+        std::cout << "OSEM: acceleration exponent " << std::to_string( p_accelerationExponent ) << " is not in [1, 2[" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSEM );
+    }
+    const auto & geometry = p_orderedSubsetsProjector.GetGeometry();
+    if( p_projectionImages == nullptr || p_projectionImages->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << "OSEM: projections are not float images" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSEM );
+    }
+    auto projectionsImageDimensions = p_projectionImages->GetDimensions();
+    if( projectionsImageDimensions[0] != geometry.projectionsDimension.x || projectionsImageDimensions[1] != geometry.projectionsDimension.y || projectionsImageDimensions[2] != geometry.projectionsDimension.z )
+    {
+        std::cout << "OSEM: projections dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSEM );
+    }
+
+    ImageDataPtr resultingVolume;
+
+    std::cout << "OSEM: initial volume retrieval" << std::endl;
+    if( p_initialVolume.has_value() )
+    {
+        resultingVolume = p_initialVolume.value();
+    }
+    else
+    {
+        resultingVolume = p_orderedSubsetsProjector.CreateVolumeImage();
+        auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
+        std::fill( resultingVolumeBuffer, resultingVolumeBuffer + geometry.GetVolumeVoxelsNumber(), 1.F );
+    }
+
+    if( resultingVolume == nullptr )
+    {
+        std::cout << "OSEM: initial data is nullptr" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSEM );
+    }
+    auto resultingVolumeDimensions = resultingVolume->GetDimensions();
+    if( resultingVolumeDimensions[0] != geometry.volumeDimension.x || resultingVolumeDimensions[1] != geometry.volumeDimension.y || resultingVolumeDimensions[2] != geometry.volumeDimension.z )
+    {
+        std::cout << "OSEM: initial volume dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::OSEM );
+    }
+
+    // verbose mode images are written in the background, all of them before returning
+    std::optional<VerboseImageWriter> verboseWriter;
+    if( p_outputDirectoryPath.has_value() )
+    {
+        verboseWriter.emplace( p_outputDirectoryPath.value(), p_verboseOptions );
+        verboseWriter->WriteVolume( resultingVolume, "initialVolume.tiff" );
+    }
+
+    auto projectionsImageBuffer = static_cast<float *>( p_projectionImages->GetScalarPointer() );
+    auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
+    const auto projectionPixelsNumber = geometry.projectionsDimension.x * geometry.projectionsDimension.y;
+
+    // iteration images are allocated once
+    auto currentProjection = p_orderedSubsetsProjector.CreateProjectionsImage();
+    auto ratioBackProjection = p_orderedSubsetsProjector.CreateVolumeImage();
+    auto currentBuffer = static_cast<float *>( currentProjection->GetScalarPointer() );
+    auto ratioBackProjectionBuffer = static_cast<float *>( ratioBackProjection->GetScalarPointer() );
+
+    // residual norms are accumulated per projection in the error pass of their subset, volume changes in the update pass
+    ConvergenceMonitor convergenceMonitor( p_stoppingCriteria, std::sqrt( elementwise::SquaredNorm( projectionsImageBuffer, geometry.GetProjectionsPixelsNumber() ) ) );
+    std::vector<double> projectionsSquaredResiduals( geometry.projectionsDimension.z, 0. );
+
+    // a checkpoint file of the same reconstruction, with the same subsets, restarts it at the saved subset
+    const auto nbSubsets = p_orderedSubsetsProjector.GetNbSubsets();
+    const auto ordering = static_cast<int>( p_orderedSubsetsProjector.GetOrdering() );
+    const auto backend = p_orderedSubsetsProjector.GetBackend();
+    ReconstructionCheckpoint checkpoint( p_checkpointOptions, "OSEM", geometry, projectionsImageBuffer, geometry.GetProjectionsPixelsNumber() );
+    auto firstIteration{ 0 };
+    auto firstSubset{ 0 };
+    if( const auto resumedState = checkpoint.Resume( CheckpointState{ 0, 0, nbSubsets, ordering, backend }, resultingVolumeBuffer ) )
+    {
+        firstIteration = resumedState->nextIteration;
+        firstSubset = resumedState->subsetCursor;
+        std::cout << "OSEM: resumed at iteration " << std::to_string( firstIteration ) << ", subset " << std::to_string( firstSubset ) << " from " << p_checkpointOptions.filePath << std::endl;
+    }
+    std::cout << "OSEM: reconstruction started" << std::endl;
+    for( auto iteration = firstIteration; iteration < p_iterationNumber; iteration++ )
+    {
+        const auto isIterationWritten = verboseWriter.has_value() && verboseWriter->IsIterationWritten( iteration );
+        const auto isIterationMonitored = iteration != firstIteration || firstSubset == 0;
+        auto volumeChangeNorm{ 0. };
+        auto squaredVolumeNorm{ 0. };
+        for( auto subsetIndex = iteration == firstIteration ? firstSubset : 0; subsetIndex < nbSubsets; subsetIndex++ )
+        {
+            auto & projectorPlan = p_orderedSubsetsProjector.GetPlan( subsetIndex );
+            const auto & subset = projectorPlan.GetProjectionsSubset();
+
+            // step 1. projection of the subset
+            if( !projectorPlan.Project( resultingVolume, currentProjection ) )
+            {
+                std::cout << "OSEM: current projection failed" << std::endl;
+                return make_error_code( ReconstructorsErrorCode::OSEM );
+            }
+
+            // step 2. ratio on the subset projections, in one pass
+            std::for_each( std::execution::par, subset.cbegin(), subset.cend(), [&]( int p_projectionIndex ) {
+                const auto offset = static_cast<size_t>( p_projectionIndex ) * projectionPixelsNumber;
+                projectionsSquaredResiduals[p_projectionIndex] = elementwise::Ratio( projectionsImageBuffer + offset, 1.F, projectionFloatTolerance, currentBuffer + offset, projectionPixelsNumber );
+            } );
+
+            // step 3. ratio backProjection
+            if( !projectorPlan.BackProject( currentProjection, ratioBackProjection ) )
+            {
+                std::cout << "OSEM: current backprojection failed" << std::endl;
+                return make_error_code( ReconstructorsErrorCode::OSEM );
+            }
+
+            // step 4. sensitivity normalized multiplicative update, in one pass
+            const auto & inverseSensitivity = p_orderedSubsetsProjector.GetVoxelsInverseSums( subsetIndex );
+            const auto updateNorms = elementwise::Multiply( ratioBackProjectionBuffer, inverseSensitivity.data(), p_accelerationExponent, resultingVolumeBuffer, geometry.GetVolumeVoxelsNumber(), convergenceMonitor.IsVolumeChangeMonitored() );
+            volumeChangeNorm += std::sqrt( updateNorms.squaredChangeNorm );
+            squaredVolumeNorm = updateNorms.squaredNorm;
+            if( checkpoint.IsSubsetSaved( subsetIndex, nbSubsets ) )
+            {
+                checkpoint.Save( CheckpointState{ iteration, subsetIndex + 1, nbSubsets, ordering, backend }, resultingVolumeBuffer );
+            }
+        }
+
+        if( isIterationWritten )
+        {
+            verboseWriter->WriteVolume( resultingVolume, "reconstructionstep" + std::to_string( iteration ) + ".tiff" );
+        }
+        if( checkpoint.IsIterationSaved( iteration ) )
+        {
+            checkpoint.Save( CheckpointState{ iteration + 1, 0, nbSubsets, ordering, backend }, resultingVolumeBuffer );
+        }
+
+        if( !isIterationMonitored )
+        {
+            continue;
+        }
+        const auto squaredResidualNorm = std::accumulate( projectionsSquaredResiduals.cbegin(), projectionsSquaredResiduals.cend(), 0. );
+        const auto relativeVolumeChange = squaredVolumeNorm > 0. ? volumeChangeNorm / std::sqrt( squaredVolumeNorm ) : 0.;
+        if( convergenceMonitor.Update( iteration, std::sqrt( squaredResidualNorm ), relativeVolumeChange ) )
+        {
+            std::cout << "OSEM: stopped after iteration " << std::to_string( iteration ) << ", " << ToString( convergenceMonitor.GetStoppingReason() ) << std::endl;
+            break;
+        }
+    }
+    return resultingVolume;
 }
 
-Result<ImageDataPtr> ShiftAndAdd( TomoGeometry * p_tomoGeometry,
-                                  ImageDataPtr p_projectionImages,
-                                  std::optional<std::string> p_outputDirectoryPath )
+Result<ImageDataPtr> OSEM( TomoGeometry * p_tomoGeometry,
+                           ImageDataPtr p_projectionImages,
+                           int p_iterationNumber,
+                           int p_nbSubsets,
+                           float p_accelerationExponent,
+                           std::optional<ImageDataPtr> p_initialVolume,
+                           std::optional<std::string> p_outputDirectoryPath,
+                           const StoppingCriteria & p_stoppingCriteria = StoppingCriteria{},
+                           const VerboseOutputOptions & p_verboseOptions = VerboseOutputOptions{},
+                           const CheckpointOptions & p_checkpointOptions = CheckpointOptions{} )
 {
+    // sensitivity images are computed at the first reconstruction of the geometry only, the cached projector being
+    // lent to this reconstruction alone
+    auto orderedSubsetsProjector = OrderedSubsetsProjectorCache::Instance().Get( p_tomoGeometry, DefaultProjectorBackend(), p_nbSubsets, SubsetsOrdering::InterleavedBitReversed );
+    if( orderedSubsetsProjector == nullptr )
+    {
+        return make_error_code( ReconstructorsErrorCode::OSEM );
+    }
+    return OSEM( *orderedSubsetsProjector, p_projectionImages, p_iterationNumber, p_accelerationExponent, p_initialVolume, p_outputDirectoryPath, p_stoppingCriteria, p_verboseOptions, p_checkpointOptions );
+}
+
+
+// Least squares reconstruction min || b - A x || by CGLS or LSQR, with the matched (adjoint) projector pair.
+// The residual norm of each iteration is reported
+Result<ImageDataPtr> LeastSquares( TomoGeometry * p_tomoGeometry,
+                                   ImageDataPtr p_projectionImages,
+                                   LeastSquaresMethod p_method,
+                                   int p_iterationNumber,
+                                   std::optional<ImageDataPtr> p_initialVolume,
+                                   std::optional<std::string> p_outputDirectoryPath )
+{
+    const std::string methodName = p_method == LeastSquaresMethod::LSQR ? "LSQR" : "CGLS";
+    LeastSquaresSolver solver( p_tomoGeometry );
+    if( !solver.IsValid() )
+    {
+        std::cout << methodName << ": invalid projector plan" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::LeastSquares );
+    }
+    const auto & geometry = solver.GetPlan().GetGeometry();
+    if( p_projectionImages == nullptr || p_projectionImages->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << methodName << ": projections are not float images" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::LeastSquares );
+    }
+    auto projectionsImageDimensions = p_projectionImages->GetDimensions();
+    if( projectionsImageDimensions[0] != geometry.projectionsDimension.x || projectionsImageDimensions[1] != geometry.projectionsDimension.y || projectionsImageDimensions[2] != geometry.projectionsDimension.z )
+    {
+        std::cout << methodName << ": projections dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::LeastSquares );
+    }
+
     ImageDataPtr resultingVolume;
 
-    //  For notations used in the following code
-    //  see article https://pubmed.ncbi.nlm.nih.gov/14579853/
-    //  Digital x-ray tomosynthesis: current state of the art and clinical potential
-    //  James T Dobbins 3rd 1, Devon J Godfrey
+    std::cout << methodName << ": initial volume retrieval" << std::endl;
+    if( p_initialVolume.has_value() )
+    {
+        resultingVolume = p_initialVolume.value();
+    }
+    else
+    {
+        resultingVolume = solver.GetPlan().CreateVolumeImage();
+        auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
+        std::fill( resultingVolumeBuffer, resultingVolumeBuffer + geometry.GetVolumeVoxelsNumber(), 0.F );
+    }
 
-    auto nbReconstructedSlices = p_tomoGeometry->volumeSize3D().z;
-    if( nbReconstructedSlices <= 1 )
+    if( resultingVolume == nullptr )
     {
-        std::cout << "ShiftAndAdd: required nb of slices in reconstruction " << std::to_string( nbReconstructedSlices ) << " <= 1" << std::endl;
-        return make_error_code( ReconstructorsErrorCode::ShiftAndAdd );
+        std::cout << methodName << ": initial data is nullptr" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::LeastSquares );
     }
-    auto nbProjections = p_tomoGeometry->nbProjections();
-    if( nbProjections <= 1 )
+    auto resultingVolumeDimensions = resultingVolume->GetDimensions();
+    if( resultingVolumeDimensions[0] != geometry.volumeDimension.x || resultingVolumeDimensions[1] != geometry.volumeDimension.y || resultingVolumeDimensions[2] != geometry.volumeDimension.z )
     {
-        std::cout << "ShiftAndAdd: required nb of projections " << std::to_string( nbProjections ) << " <= 1" << std::endl;
-        return make_error_code( ReconstructorsErrorCode::ShiftAndAdd );
+        std::cout << methodName << ": initial volume dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::LeastSquares );
+    }
+
+    auto verboseMode = p_outputDirectoryPath.has_value();
+
+    if( verboseMode )
+    {
+        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "initialVolume.tiff" ).c_str() );
+        tiffWriterPhantom->SetInputData( resultingVolume );
+        tiffWriterPhantom->Write();
+    }
+
+    std::cout << methodName << ": reconstruction started" << std::endl;
+    const auto residualNorms = solver.Solve( p_method,
+                                             static_cast<const float *>( p_projectionImages->GetScalarPointer() ),
+                                             p_iterationNumber,
+                                             static_cast<float *>( resultingVolume->GetScalarPointer() ) );
+    for( auto iteration{ 0U }; iteration < residualNorms.size(); iteration++ )
+    {
+        std::cout << methodName << ": iteration " << std::to_string( iteration ) << " residual norm " << std::to_string( residualNorms[iteration] ) << std::endl;
+    }
+
+    if( verboseMode )
+    {
+        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "reconstruction.tiff" ).c_str() );
+        tiffWriterPhantom->SetInputData( resultingVolume );
+        tiffWriterPhantom->Write();
+    }
+    return resultingVolume;
+}
+
+Result<ImageDataPtr> CGLS( TomoGeometry * p_tomoGeometry,
+                           ImageDataPtr p_projectionImages,
+                           int p_iterationNumber,
+                           std::optional<ImageDataPtr> p_initialVolume,
+                           std::optional<std::string> p_outputDirectoryPath )
+{
+    return LeastSquares( p_tomoGeometry, p_projectionImages, LeastSquaresMethod::CGLS, p_iterationNumber, p_initialVolume, p_outputDirectoryPath );
+}
+
+Result<ImageDataPtr> LSQR( TomoGeometry * p_tomoGeometry,
+                           ImageDataPtr p_projectionImages,
+                           int p_iterationNumber,
+                           std::optional<ImageDataPtr> p_initialVolume,
+                           std::optional<std::string> p_outputDirectoryPath )
+{
+    return LeastSquares( p_tomoGeometry, p_projectionImages, LeastSquaresMethod::LSQR, p_iterationNumber, p_initialVolume, p_outputDirectoryPath );
+}
+
+// TV regularized reconstruction min 1/2 || A x - b ||^2 + weight TV( x ) by the Chambolle-Pock primal-dual algorithm,
+// with the matched (adjoint) projector pair. The volume is kept nonnegative
+Result<ImageDataPtr> ChambollePockTV( TomoGeometry * p_tomoGeometry,
+                                      ImageDataPtr p_projectionImages,
+                                      int p_iterationNumber,
+                                      float p_totalVariationWeight,
+                                      std::optional<ImageDataPtr> p_initialVolume,
+                                      std::optional<std::string> p_outputDirectoryPath )
+{
+    TotalVariationSolver solver( p_tomoGeometry );
+    if( !solver.IsValid() )
+    {
+        std::cout << "ChambollePockTV: invalid projector plan" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::TotalVariation );
+    }
+    const auto & geometry = solver.GetPlan().GetGeometry();
+    if( p_projectionImages == nullptr || p_projectionImages->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << "ChambollePockTV: projections are not float images" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::TotalVariation );
+    }
+    auto projectionsImageDimensions = p_projectionImages->GetDimensions();
+    if( projectionsImageDimensions[0] != geometry.projectionsDimension.x || projectionsImageDimensions[1] != geometry.projectionsDimension.y || projectionsImageDimensions[2] != geometry.projectionsDimension.z )
+    {
+        std::cout << "ChambollePockTV: projections dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::TotalVariation );
+    }
+
+    ImageDataPtr resultingVolume;
+
+    std::cout << "ChambollePockTV: initial volume retrieval" << std::endl;
+    if( p_initialVolume.has_value() )
+    {
+        resultingVolume = p_initialVolume.value();
+    }
+    else
+    {
+        resultingVolume = solver.GetPlan().CreateVolumeImage();
+        auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
+        std::fill( resultingVolumeBuffer, resultingVolumeBuffer + geometry.GetVolumeVoxelsNumber(), 0.F );
     }
 
-    auto zF = p_tomoGeometry->fulcrum().z;
+    if( resultingVolume == nullptr )
+    {
+        std::cout << "ChambollePockTV: initial data is nullptr" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::TotalVariation );
+    }
+    auto resultingVolumeDimensions = resultingVolume->GetDimensions();
+    if( resultingVolumeDimensions[0] != geometry.volumeDimension.x || resultingVolumeDimensions[1] != geometry.volumeDimension.y || resultingVolumeDimensions[2] != geometry.volumeDimension.z )
+    {
+        std::cout << "ChambollePockTV: initial volume dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::TotalVariation );
+    }
 
     auto verboseMode = p_outputDirectoryPath.has_value();
+
     if( verboseMode )
     {
-        std::cout << "zF = " << std::to_string( zF ) << std::endl;
+        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "initialVolume.tiff" ).c_str() );
+        tiffWriterPhantom->SetInputData( resultingVolume );
+        tiffWriterPhantom->Write();
+    }
+
+    std::cout << "ChambollePockTV: step sizes estimation" << std::endl;
+    std::cout << "ChambollePockTV: operator norm " << std::to_string( solver.GetOperatorNorm() ) << std::endl;
+    std::cout << "ChambollePockTV: reconstruction started" << std::endl;
+    const auto residualNorms = solver.Solve( static_cast<const float *>( p_projectionImages->GetScalarPointer() ),
+                                             p_iterationNumber,
+                                             p_totalVariationWeight,
+                                             true,
+                                             static_cast<float *>( resultingVolume->GetScalarPointer() ) );
+    if( residualNorms.empty() && p_iterationNumber > 0 )
+    {
+        return make_error_code( ReconstructorsErrorCode::TotalVariation );
+    }
+    for( auto iteration{ 0U }; iteration < residualNorms.size(); iteration++ )
+    {
+        std::cout << "ChambollePockTV: iteration " << std::to_string( iteration ) << " residual norm " << std::to_string( residualNorms[iteration] ) << std::endl;
     }
-    auto sid = p_tomoGeometry->sid();
 
     if( verboseMode )
     {
-        std::cout << "sid = " << std::to_string( sid ) << std::endl;
+        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "reconstruction.tiff" ).c_str() );
+        tiffWriterPhantom->SetInputData( resultingVolume );
+        tiffWriterPhantom->Write();
     }
+    return resultingVolume;
+}
 
-    if( AlmostEqualRelative( zF, sid ) )
+// Filtered back projection: ramp, apodization and slice thickness filtering of the projections along the sources sweep,
+// then back projection. Single pass, no initial volume. The volume is a relative attenuation map (see FilteredBackProjector).
+// p_filteredBackProjector keeps the filter and the plan: it can be reused by the next reconstructions of its geometry
+Result<ImageDataPtr> FBP( FilteredBackProjector & p_filteredBackProjector,
+                          ImageDataPtr p_projectionImages,
+                          std::optional<std::string> p_outputDirectoryPath )
+{
+    if( !p_filteredBackProjector.IsValid() )
     {
-        std::cout << "ShiftAndAdd: Fulcrum and imager are at the same height: impossible" << std::endl;
-        return make_error_code( ReconstructorsErrorCode::ShiftAndAdd );
+        std::cout << "FBP: invalid projector plan" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::FilteredBackProjection );
+    }
+    const auto & geometry = p_filteredBackProjector.GetPlan().GetGeometry();
+    if( p_projectionImages == nullptr || p_projectionImages->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << "FBP: projections are not float images" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::FilteredBackProjection );
+    }
+    auto projectionsImageDimensions = p_projectionImages->GetDimensions();
+    if( projectionsImageDimensions[0] != geometry.projectionsDimension.x || projectionsImageDimensions[1] != geometry.projectionsDimension.y || projectionsImageDimensions[2] != geometry.projectionsDimension.z )
+    {
+        std::cout << "FBP: projections dimensions do not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::FilteredBackProjection );
     }
 
+    auto resultingVolume = p_filteredBackProjector.GetPlan().CreateVolumeImage();
+    std::cout << "FBP: reconstruction started" << std::endl;
+    if( !p_filteredBackProjector.Reconstruct( static_cast<const float *>( p_projectionImages->GetScalarPointer() ), static_cast<float *>( resultingVolume->GetScalarPointer() ) ) )
+    {
+        std::cout << "FBP: projections filtering failed" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::FilteredBackProjection );
+    }
+
+    if( p_outputDirectoryPath.has_value() )
+    {
+        auto filteredProjections = p_filteredBackProjector.GetPlan().CreateProjectionsImage();
+        const auto & filteredProjectionsBuffer = p_filteredBackProjector.GetFilteredProjections();
+        std::copy( filteredProjectionsBuffer.cbegin(), filteredProjectionsBuffer.cend(), static_cast<float *>( filteredProjections->GetScalarPointer() ) );
+        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "filteredProjections.tiff" ).c_str() );
+        tiffWriterPhantom->SetInputData( filteredProjections );
+        tiffWriterPhantom->Write();
+    }
+    return resultingVolume;
+}
+
+// FBP with the default backend, the filter and the plan being built for this reconstruction only
+Result<ImageDataPtr> FBP( TomoGeometry * p_tomoGeometry,
+                          ImageDataPtr p_projectionImages,
+                          const FilterParameters & p_filterParameters,
+                          std::optional<std::string> p_outputDirectoryPath )
+{
+    FilteredBackProjector filteredBackProjector( p_tomoGeometry, DefaultProjectorBackend(), p_filterParameters );
+    return FBP( filteredBackProjector, p_projectionImages, p_outputDirectoryPath );
+}
 
-    auto mF = sid / ( sid - zF );
+Result<ImageDataPtr> BackProjection( TomoGeometry * p_tomoGeometry,
+                                     ImageDataPtr p_projectionImages )
+{
+    Projector projector{ p_tomoGeometry };
+    return projector.PerformBackProjection( p_projectionImages );
+}
 
-#ifdef verboseMode
-    qInfo() << "mF = " << QString::number( mF );
-#endif
+Result<ImageDataPtr> ShiftAndAdd( TomoGeometry * p_tomoGeometry,
+                                  ImageDataPtr p_projectionImages,
+                                  std::optional<std::string> p_outputDirectoryPath )
+{
+    auto verboseMode = p_outputDirectoryPath.has_value();
+    if( verboseMode )
+    {
+        std::cout << "sid = " << std::to_string( p_tomoGeometry->sid() ) << std::endl;
+    }
 
-    auto imagesAppender = vtkSmartPointer<vtkImageAppend>::New();
-    imagesAppender->SetAppendAxis( 2 );
-    auto yVolumePixelSpacing = p_tomoGeometry->volumeVoxelSpacing().y;
-    for( auto reconstructionZ : p_tomoGeometry->volumeZs() )
+    ShiftAndAddEngine shiftAndAddEngine( p_tomoGeometry );
+    if( !shiftAndAddEngine.IsValid() )
     {
-        if( AlmostEqualRelative( reconstructionZ, sid ) )
-        {
-            std::cout << "ShiftAndAdd: reconstruction slice and imager are at the same height: impossible" << std::endl;
-            return make_error_code( ReconstructorsErrorCode::ShiftAndAdd );
-        }
-        auto mZ = sid / ( sid - reconstructionZ );
-        auto translationYCoeff = ( mZ - mF );
-        std::vector<int> translationYs;
-        for( auto sourceY : p_tomoGeometry->sourcesYPositions() )
-        {
-            auto realWorldTranslationY = sourceY * translationYCoeff;
-            translationYs.push_back( static_cast<int>( realWorldTranslationY / yVolumePixelSpacing ) );
-        }
-        auto maxTranslation = std::max_element( translationYs.cbegin(), translationYs.cend() );
-        auto minTranslation = std::min_element( translationYs.cbegin(), translationYs.cend() );
+        return make_error_code( ReconstructorsErrorCode::ShiftAndAdd );
+    }
 
+    if( p_projectionImages == nullptr || p_projectionImages->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << "ShiftAndAdd: projections are not float images" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::ShiftAndAdd );
+    }
+    auto projectionsDimensions = p_projectionImages->GetDimensions();
+    if( projectionsDimensions[2] != shiftAndAddEngine.GetNbProjections() )
+    {
+        std::cout << "ShiftAndAdd: nb of projection images " << std::to_string( projectionsDimensions[2] ) << " does not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::ShiftAndAdd );
+    }
 
-        auto sumFilter = vtkSmartPointer<vtkImageWeightedSum>::New();
+    // slices have the projections size, spacing and origin
+    auto resultingVolume = ImageDataPtr::New();
+    resultingVolume->SetDimensions( projectionsDimensions[0], projectionsDimensions[1], shiftAndAddEngine.GetNbSlices() );
+    resultingVolume->SetSpacing( p_projectionImages->GetSpacing() );
+    resultingVolume->SetOrigin( p_projectionImages->GetOrigin() );
+    resultingVolume->AllocateScalars( VTK_FLOAT, 1 );
 
+    shiftAndAddEngine.Perform( static_cast<float *>( p_projectionImages->GetScalarPointer() ),
+                               projectionsDimensions[0],
+                               projectionsDimensions[1],
+                               static_cast<float *>( resultingVolume->GetScalarPointer() ) );
+    return resultingVolume;
+}
 
-        auto imageConstantPad = vtkSmartPointer<vtkImageConstantPad>::New();
-        imageConstantPad->SetInputData( p_projectionImages );
-        auto projectionsExtent = p_projectionImages->GetExtent();
+// Matrix Inversion Tomosynthesis: Shift-and-Add slices deblurred by the inversion, frequency by frequency along the
+// sweep, of the blur of the other slices. The inversion operators are cached per geometry (MitsEngineCache)
+Result<ImageDataPtr> MITS( TomoGeometry * p_tomoGeometry,
+                           ImageDataPtr p_projectionImages,
+                           float p_regularization,
+                           std::optional<std::string> p_outputDirectoryPath )
+{
+    if( p_projectionImages == nullptr || p_projectionImages->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << "MITS: projections are not float images" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::MatrixInversionTomosynthesis );
+    }
+    auto projectionsDimensions = p_projectionImages->GetDimensions();
+    auto mitsEngine = MitsEngineCache::Instance().Get( p_tomoGeometry, projectionsDimensions[1], p_regularization );
+    if( mitsEngine == nullptr )
+    {
+        return make_error_code( ReconstructorsErrorCode::MatrixInversionTomosynthesis );
+    }
+    const auto & shiftAndAddEngine = mitsEngine->GetShiftAndAddEngine();
+    if( projectionsDimensions[2] != shiftAndAddEngine.GetNbProjections() )
+    {
+        std::cout << "MITS: nb of projection images " << std::to_string( projectionsDimensions[2] ) << " does not match the geometry" << std::endl;
+        return make_error_code( ReconstructorsErrorCode::MatrixInversionTomosynthesis );
+    }
 
-        // qDebug() << "demanded padded projections extent:    " << projectionsExtent[0] << " " << projectionsExtent[1]
-        //          << " " << projectionsExtent[2] + minTranslation << " " << projectionsExtent[3] + maxTranslation
-        //          << " " << projectionsExtent[4] << " " << projectionsExtent[5];
-        imageConstantPad->SetOutputWholeExtent( projectionsExtent[0], projectionsExtent[1], projectionsExtent[2] + *minTranslation, projectionsExtent[3] + *maxTranslation, projectionsExtent[4], projectionsExtent[5] );
-        imageConstantPad->UpdateWholeExtent();
-        // auto paddedExtent = imageConstantPad->GetOutput()->GetExtent();
-        // qDebug() << "global padded projections extent:    " << paddedExtent[0] << " " << paddedExtent[1]
-        //          << " " << paddedExtent[2] << " " << paddedExtent[3]
-        //          << " " << paddedExtent[4] << " " << paddedExtent[5];
-        int projectionIndex = 0;
-        for( auto translationY : translationYs )
-        {
-            auto voiExtractor = vtkSmartPointer<vtkExtractVOI>::New();
-            // voiExtractor->SetVOI( voiExtentForSummation[0], voiExtentForSummation[1], voiExtentForSummation[2] + translationsInPixels[reconstructionSliceIndex], voiExtentForSummation[3] + translationsInPixels[reconstructionSliceIndex], reconstructionSliceIndex, reconstructionSliceIndex );
-            voiExtractor->SetVOI( projectionsExtent[0], projectionsExtent[1], projectionsExtent[2] + translationY, projectionsExtent[3] + translationY, projectionIndex, projectionIndex );
-            voiExtractor->SetInputConnection( imageConstantPad->GetOutputPort() );
-            voiExtractor->UpdateWholeExtent();
-            auto previousExtent = voiExtractor->GetOutput()->GetExtent();
-            // qDebug() << "projection extraction extent:    " << previousExtent[0] << " " << previousExtent[1]
-            //          << " " << previousExtent[2] << " " << previousExtent[3]
-            //          << " " << previousExtent[4] << " " << previousExtent[5];
-
-
-            auto translateExtent = vtkSmartPointer<vtkImageTranslateExtent>::New();
-            translateExtent->SetTranslation( -previousExtent[0], -previousExtent[2], -previousExtent[4] );
-            translateExtent->SetInputConnection( voiExtractor->GetOutputPort() );
-
-            sumFilter->SetWeight( projectionIndex, 1. / static_cast<double>( nbProjections ) );
-            sumFilter->AddInputConnection( translateExtent->GetOutputPort() );
-            projectionIndex++;
-        }
+    // slices have the projections size, spacing and origin
+    auto resultingVolume = ImageDataPtr::New();
+    resultingVolume->SetDimensions( projectionsDimensions[0], projectionsDimensions[1], shiftAndAddEngine.GetNbSlices() );
+    resultingVolume->SetSpacing( p_projectionImages->GetSpacing() );
+    resultingVolume->SetOrigin( p_projectionImages->GetOrigin() );
+    resultingVolume->AllocateScalars( VTK_FLOAT, 1 );
+    auto resultingVolumeBuffer = static_cast<float *>( resultingVolume->GetScalarPointer() );
 
-        imagesAppender->AddInputConnection( sumFilter->GetOutputPort() );
+    std::cout << "MITS: reconstruction started" << std::endl;
+    shiftAndAddEngine.Perform( static_cast<float *>( p_projectionImages->GetScalarPointer() ), projectionsDimensions[0], projectionsDimensions[1], resultingVolumeBuffer );
+    if( p_outputDirectoryPath.has_value() )
+    {
+        auto tiffWriterPhantom = vtkSmartPointer<vtkTIFFWriter>::New();
+        tiffWriterPhantom->SetFileName( ( p_outputDirectoryPath.value() + "shiftAndAddSlices.tiff" ).c_str() );
+        tiffWriterPhantom->SetInputData( resultingVolume );
+        tiffWriterPhantom->Write();
     }
-    imagesAppender->Update();
-    return imagesAppender->GetOutput();
+    mitsEngine->Deblur( resultingVolumeBuffer, projectionsDimensions[0] );
+    return resultingVolume;
 }
 
 
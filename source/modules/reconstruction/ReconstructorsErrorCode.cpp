@@ -47,6 +47,20 @@ std::string ReconstructorsErrorCodeCategory::message( int p_condition ) const
             return "MLEM reconstruction failed";
         case ReconstructorsErrorCode::ShiftAndAdd:
             return "Shift and Add reconstruction failed";
+        case ReconstructorsErrorCode::OSSART:
+            return "OS-SART reconstruction failed";
+        case ReconstructorsErrorCode::OSEM:
+            return "OSEM reconstruction failed";
+        case ReconstructorsErrorCode::LeastSquares:
+            return "Least squares (CGLS, LSQR) reconstruction failed";
+        case ReconstructorsErrorCode::TotalVariation:
+            return "Total variation (Chambolle-Pock) reconstruction failed";
+        case ReconstructorsErrorCode::FilteredBackProjection:
+            return "Filtered back projection failed";
+        case ReconstructorsErrorCode::MatrixInversionTomosynthesis:
+            return "Matrix inversion tomosynthesis failed";
+        case ReconstructorsErrorCode::Multiresolution:
+            return "Multiresolution reconstruction failed";
     }
 
     assert( "Missing value for enum TomoGeometryErrorCode in TomoGeometryErrorCodeCategory::message" );
@@ -61,6 +75,13 @@ std::error_condition ReconstructorsErrorCodeCategory::default_error_condition( i
         case ReconstructorsErrorCode::ProjectionFailed:
         case ReconstructorsErrorCode::MLEM:
         case ReconstructorsErrorCode::ShiftAndAdd:
+        case ReconstructorsErrorCode::OSSART:
+        case ReconstructorsErrorCode::OSEM:
+        case ReconstructorsErrorCode::LeastSquares:
+        case ReconstructorsErrorCode::TotalVariation:
+        case ReconstructorsErrorCode::FilteredBackProjection:
+        case ReconstructorsErrorCode::MatrixInversionTomosynthesis:
+        case ReconstructorsErrorCode::Multiresolution:
             return make_error_condition( TomoErrorCondition::TomosynthesisReconstructorError );
     }
 
@@ -22,7 +22,14 @@ enum class ReconstructorsErrorCode
     BackProjectionFailed,
     ProjectionFailed,
     MLEM,
-    ShiftAndAdd
+    ShiftAndAdd,
+    OSSART,
+    OSEM,
+    LeastSquares,
+    TotalVariation,
+    FilteredBackProjection,
+    MatrixInversionTomosynthesis,
+    Multiresolution
 };
 
 namespace std
@@ -0,0 +1,127 @@
+#include "modules/reconstruction/ShiftAndAdd.h"
+
+#include "commons/Maths.h"
+#include "modules/geometry/IndexedIterator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <iostream>
+#include <string>
+
+namespace    // anonymous namespace
+{
+// p_sliceRow += p_weight * p_projectionRow
+inline void AddWeightedRow( const float * p_projectionRow, float p_weight, int p_nbColumns, float * p_sliceRow )
+{
+    for( auto column{ 0 }; column < p_nbColumns; column++ )
+    {
+        p_sliceRow[column] += p_weight * p_projectionRow[column];
+    }
+}
+}    // end of anonymous namespace
+
+ShiftAndAddEngine::ShiftAndAddEngine( TomoGeometry const * p_tomoGeometry )
+{
+    if( p_tomoGeometry == nullptr )
+    {
+        return;
+    }
+    m_nbSlices = p_tomoGeometry->volumeSize3D().z;
+    if( m_nbSlices <= 1 )
+    {
+        std::cout << "ShiftAndAdd: required nb of slices in reconstruction " << std::to_string( m_nbSlices ) << " <= 1" << std::endl;
+        return;
+    }
+    m_nbProjections = p_tomoGeometry->nbProjections();
+    if( m_nbProjections <= 1 )
+    {
+        std::cout << "ShiftAndAdd: required nb of projections " << std::to_string( m_nbProjections ) << " <= 1" << std::endl;
+        return;
+    }
+
+    // heights are measured from the detectors plane
+    auto detectorsZ = p_tomoGeometry->detectorsZCommonPosition();
+    auto sid = p_tomoGeometry->sid();
+
+    auto sourcesYs = p_tomoGeometry->sourcesYPositions();
+    auto projectionsBottomLeftPositions = p_tomoGeometry->projectionsRoisBottomLeftPositions();
+    if( static_cast<int>( sourcesYs.size() ) != m_nbProjections || static_cast<int>( projectionsBottomLeftPositions.size() ) != m_nbProjections )
+    {
+        std::cout << "ShiftAndAdd: nb of sources or of projections rois does not match the nb of projections" << std::endl;
+        return;
+    }
+    auto yPixelSpacing = p_tomoGeometry->projectionsPixelSpacing().y;
+    // volumeZs are the bottoms of the slices
+    auto halfSliceThickness = 0.5F * p_tomoGeometry->volumeVoxelSpacing().z;
+    m_shifts.reserve( m_nbSlices * m_nbProjections );
+    for( auto reconstructionZ : p_tomoGeometry->volumeZs() )
+    {
+        auto sliceHeight = reconstructionZ + halfSliceThickness - detectorsZ;
+        if( AlmostEqualRelative( sliceHeight, sid ) )
+        {
+            std::cout << "ShiftAndAdd: reconstruction slice and imager are at the same height: impossible" << std::endl;
+            m_shifts.clear();
+            return;
+        }
+        // the shadow of a point of the slice moves by sourceY * ( 1 - mZ ) with the source, the slices having the rows of
+        // the first projection
+        auto mZ = sid / ( sid - sliceHeight );
+        for( auto projectionIndex{ 0 }; projectionIndex < m_nbProjections; projectionIndex++ )
+        {
+            auto realWorldShift = sourcesYs[projectionIndex] * ( 1.F - mZ ) + projectionsBottomLeftPositions[0].y - projectionsBottomLeftPositions[projectionIndex].y;
+            m_shifts.push_back( realWorldShift / yPixelSpacing );
+        }
+    }
+    m_isValid = static_cast<int>( m_shifts.size() ) == m_nbSlices * m_nbProjections;
+}
+
+void ShiftAndAddEngine::Perform( const float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, float * p_volumeBuffer ) const
+{
+    if( !m_isValid )
+    {
+        return;
+    }
+    const auto sliceSize = static_cast<size_t>( p_nbColumns ) * p_nbRows;
+    auto slicesIndices = IndexRange{ m_nbSlices };
+    std::for_each( std::execution::par, slicesIndices.begin(), slicesIndices.end(), [&]( int p_sliceIndex ) {
+        this->PerformSlice( p_projectionsBuffer, p_nbColumns, p_nbRows, p_sliceIndex, p_volumeBuffer + p_sliceIndex * sliceSize );
+    } );
+}
+
+void ShiftAndAddEngine::PerformSlice( const float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, int p_sliceIndex, float * p_sliceBuffer ) const
+{
+    if( !m_isValid )
+    {
+        return;
+    }
+    const auto projectionSize = static_cast<size_t>( p_nbColumns ) * p_nbRows;
+    const auto projectionWeight = 1.F / static_cast<float>( m_nbProjections );
+    std::fill( p_sliceBuffer, p_sliceBuffer + projectionSize, 0.F );
+
+    for( auto projectionIndex{ 0 }; projectionIndex < m_nbProjections; projectionIndex++ )
+    {
+        // slice row r is the projection row r + shift, linearly interpolated, the rows outside the projection being 0
+        const auto shift = this->GetShift( p_sliceIndex, projectionIndex );
+        const auto wholeShift = static_cast<int>( std::floor( shift ) );
+        const auto secondRowWeight = ( shift - static_cast<float>( wholeShift ) ) * projectionWeight;
+        const auto firstRowWeight = projectionWeight - secondRowWeight;
+
+        const auto * projectionBuffer = p_projectionsBuffer + projectionIndex * projectionSize;
+        const auto rowBegin = std::clamp( -wholeShift - 1, 0, p_nbRows );
+        const auto rowEnd = std::clamp( p_nbRows - wholeShift, rowBegin, p_nbRows );
+        for( auto row{ rowBegin }; row < rowEnd; row++ )
+        {
+            auto * sliceRow = p_sliceBuffer + static_cast<size_t>( row ) * p_nbColumns;
+            const auto firstRow = row + wholeShift;
+            if( firstRow >= 0 )
+            {
+                AddWeightedRow( projectionBuffer + static_cast<size_t>( firstRow ) * p_nbColumns, firstRowWeight, p_nbColumns, sliceRow );
+            }
+            if( firstRow + 1 < p_nbRows )
+            {
+                AddWeightedRow( projectionBuffer + static_cast<size_t>( firstRow + 1 ) * p_nbColumns, secondRowWeight, p_nbColumns, sliceRow );
+            }
+        }
+    }
+}
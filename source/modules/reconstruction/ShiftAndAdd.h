@@ -0,0 +1,39 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+
+#include <vector>
+
+// Native Shift-and-Add engine.
+// For notations see article https://pubmed.ncbi.nlm.nih.gov/14579853/
+// Digital x-ray tomosynthesis: current state of the art and clinical potential, James T Dobbins 3rd, Devon J Godfrey
+// Slice s is the mean of the projections shifted along y by sourceY * (1 - mZ), mZ = sid / (sid - z) being the
+// magnification of the slice plane (z measured from the detectors), so that a point of the slice is at the same row in
+// every shifted projection. The slices have the pixels grid of the first projection, the other rois being registered on it.
+// The shifts are computed once in the constructor, in fractional pixels, and applied with linear interpolation.
+class ShiftAndAddEngine
+{
+public:
+    ShiftAndAddEngine( TomoGeometry const * p_tomoGeometry );
+    ~ShiftAndAddEngine() = default;
+
+    // false if the geometry does not allow a Shift-and-Add reconstruction (the reason is printed)
+    bool IsValid() const { return m_isValid; }
+    int GetNbSlices() const { return m_nbSlices; }
+    int GetNbProjections() const { return m_nbProjections; }
+    // y shift (in pixels) of projection p_projectionIndex when it is added to slice p_sliceIndex
+    float GetShift( int p_sliceIndex, int p_projectionIndex ) const { return m_shifts[p_sliceIndex * m_nbProjections + p_projectionIndex]; }
+    const std::vector<float> & GetShifts() const { return m_shifts; }
+
+    // p_projectionsBuffer holds GetNbProjections() projections of p_nbColumns x p_nbRows pixels, p_volumeBuffer receives
+    // GetNbSlices() slices of the same size. Slices are computed in parallel
+    void Perform( const float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, float * p_volumeBuffer ) const;
+    // Computes the slice p_sliceIndex only
+    void PerformSlice( const float * p_projectionsBuffer, int p_nbColumns, int p_nbRows, int p_sliceIndex, float * p_sliceBuffer ) const;
+
+private:
+    bool m_isValid{ false };
+    int m_nbSlices{ 0 };
+    int m_nbProjections{ 0 };
+    std::vector<float> m_shifts;    // slice major
+};
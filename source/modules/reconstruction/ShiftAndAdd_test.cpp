@@ -0,0 +1,93 @@
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectorCpu.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "modules/reconstruction/ShiftAndAdd.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <vector>
+
+constexpr int pointHalfWidth = 2;                // the point is a small square of the slice, in voxels
+constexpr double inFocusSpreadTolerance = 0.75;  // max spread of the point rows seen by the projections in its slice, in pixels
+constexpr double outOfFocusMinSpread = 2.;       // min spread in the slice half a volume away, in pixels
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+namespace    // anonymous namespace
+{
+// Rows of the point in slice p_sliceIndex, as brought by each projection alone: their centroids, the projections not
+// seeing the point being skipped
+std::vector<double> PointRowsInSlice( const ShiftAndAddEngine & p_engine, const ProjectorGeometry & p_geometry, const std::vector<float> & p_projections, int p_sliceIndex )
+{
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto projectionSize = static_cast<size_t>( projectionsDimension.x ) * projectionsDimension.y;
+    std::vector<double> rows;
+    std::vector<float> slice( projectionSize );
+    for( auto projectionIndex{ 0 }; projectionIndex < projectionsDimension.z; projectionIndex++ )
+    {
+        std::vector<float> projection( p_projections.size(), 0.F );
+        std::copy( p_projections.cbegin() + projectionIndex * projectionSize, p_projections.cbegin() + ( projectionIndex + 1 ) * projectionSize, projection.begin() + projectionIndex * projectionSize );
+        p_engine.PerformSlice( projection.data(), projectionsDimension.x, projectionsDimension.y, p_sliceIndex, slice.data() );
+
+        auto mass{ 0. };
+        auto rowsMoment{ 0. };
+        for( auto pixelIndex{ 0U }; pixelIndex < projectionSize; pixelIndex++ )
+        {
+            mass += slice[pixelIndex];
+            rowsMoment += static_cast<double>( slice[pixelIndex] ) * ( pixelIndex / projectionsDimension.x );
+        }
+        if( mass > 0. )
+        {
+            rows.push_back( rowsMoment / mass );
+        }
+    }
+    return rows;
+}
+
+double Spread( const std::vector<double> & p_values )
+{
+    const auto [minimum, maximum] = std::minmax_element( p_values.cbegin(), p_values.cend() );
+    return *maximum - *minimum;
+}
+}    // end of anonymous namespace
+
+TEST( ShiftAndAddTest, PointIsInFocusInItsSlice )
+{
+    // the projections of a point of each slice are computed by the ray-driven projector: in its slice, every shifted
+    // projection brings the point at the same row, in a distant slice the rows spread along the sources sweep
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        const auto geometry = ProjectorGeometry::FromTomoGeometry( &tomoGeometry );
+        const auto & volumeDimension = geometry.volumeDimension;
+        ShiftAndAddEngine engine( &tomoGeometry );
+        ASSERT_TRUE( engine.IsValid() ) << path;
+        ASSERT_EQ( engine.GetNbSlices(), volumeDimension.z ) << path;
+
+        for( auto sliceIndex{ 0 }; sliceIndex < volumeDimension.z; sliceIndex++ )
+        {
+            std::vector<float> volume( geometry.GetVolumeVoxelsNumber(), 0.F );
+            for( auto y{ volumeDimension.y / 2 - pointHalfWidth }; y <= volumeDimension.y / 2 + pointHalfWidth; y++ )
+            {
+                for( auto x{ volumeDimension.x / 2 - pointHalfWidth }; x <= volumeDimension.x / 2 + pointHalfWidth; x++ )
+                {
+                    volume[( sliceIndex * volumeDimension.y + y ) * volumeDimension.x + x] = 1.F;
+                }
+            }
+            std::vector<float> projections( geometry.GetProjectionsPixelsNumber() );
+            cpuprojector::PerformIncrementalProjection( volume.data(), geometry, projections.data() );
+
+            const auto inFocusRows = PointRowsInSlice( engine, geometry, projections, sliceIndex );
+            ASSERT_GT( inFocusRows.size(), 1U ) << path << " slice " << sliceIndex;
+            EXPECT_LT( Spread( inFocusRows ), inFocusSpreadTolerance ) << path << " slice " << sliceIndex;
+
+            const auto distantSliceIndex = ( sliceIndex + volumeDimension.z / 2 ) % volumeDimension.z;
+            const auto outOfFocusRows = PointRowsInSlice( engine, geometry, projections, distantSliceIndex );
+            EXPECT_GT( Spread( outOfFocusRows ), outOfFocusMinSpread ) << path << " slice " << sliceIndex << " seen in slice " << distantSliceIndex;
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// Compile-time side of the runtime SIMD dispatch (see DetectSimdLevel in ProjectorSimd.h):
+// the AVX2/AVX-512 kernels are only built on x86-64 and are tagged with their target so that the rest of the build
+// keeps the baseline instruction set
+#if defined( _M_X64 ) || defined( __x86_64__ )
+#define TOMO_WITH_X86_SIMD
+#include <immintrin.h>
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles the intrinsics without any target option, gcc and clang need them on the function
+#if defined( _MSC_VER )
+#define TOMO_TARGET_AVX2
+#define TOMO_TARGET_AVX512
+#else
+#define TOMO_TARGET_AVX2 __attribute__( ( target( "avx2,fma" ) ) )
+#define TOMO_TARGET_AVX512 __attribute__( ( target( "avx512f" ) ) )
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/ProjectorDistanceDriven.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+
+// Drivers shared by the distance-driven and separable footprint projectors.
+// Their weights are separable: the weight of a voxel and a pixel is the product of an x entry (OverlapTable of the voxel
+// columns) and of a y entry (table of the voxel rows), both tables being built per slice and per projection.
+// A y table type provides its entries ordered by pixel through PixelsEntries and pixelsOffsets, and ordered by voxel
+// through VoxelsEntries and voxelsOffsets.
+namespace cpuprojector
+{
+// Builds the x and y tables of the slice p_sliceIndex seen from the source of p_projectionIndex, returns false if the
+// slice is not seen
+template <typename YTable>
+using SliceTablesFunction = bool ( * )( const ProjectorGeometry & p_geometry, int p_projectionIndex, int p_sliceIndex, OverlapTable & p_xTable, YTable & p_yTable );
+
+// The overlaps along y are ordered both by pixel and by voxel
+inline const std::vector<OverlapEntry> & PixelsEntries( const OverlapTable & p_table )
+{
+    return p_table.entries;
+}
+
+inline const std::vector<OverlapEntry> & VoxelsEntries( const OverlapTable & p_table )
+{
+    return p_table.entries;
+}
+
+// p_projectionsBuffer = W p_volumeBuffer, without normalization. A null p_volumeBuffer stands for a volume of ones,
+// giving the total weight of each ray.
+// Parallelized over the slices (tables) then over the detector rows, projection after projection
+template <typename YTable>
+void ProjectSlicesTables( const float * p_volumeBuffer, const ProjectorGeometry & p_geometry, SliceTablesFunction<YTable> p_computeSliceTables, float * p_projectionsBuffer )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto sliceSize = static_cast<size_t>( volumeDimension.x ) * volumeDimension.y;
+
+    // tables reused from one projection to the next
+    std::vector<OverlapTable> xTables( volumeDimension.z );
+    std::vector<YTable> yTables( volumeDimension.z );
+    std::vector<char> slicesSeen( volumeDimension.z );
+    auto slicesIndices = IndexRange{ volumeDimension.z };
+    auto rowsIndices = IndexRange{ projectionsDimension.y };
+
+    for( auto projectionIndex{ 0 }; projectionIndex < projectionsDimension.z; projectionIndex++ )
+    {
+        // tables of all the slices for this source
+        std::for_each( std::execution::par, slicesIndices.begin(), slicesIndices.end(), [&]( int p_sliceIndex ) {
+            slicesSeen[p_sliceIndex] = p_computeSliceTables( p_geometry, projectionIndex, p_sliceIndex, xTables[p_sliceIndex], yTables[p_sliceIndex] );
+        } );
+
+        // one task per detector row
+        auto rowProjector = [&]( int p_yProjPixel ) {
+            auto * rowBuffer = p_projectionsBuffer + ( static_cast<size_t>( projectionIndex ) * projectionsDimension.y + p_yProjPixel ) * projectionsDimension.x;
+            std::fill( rowBuffer, rowBuffer + projectionsDimension.x, 0.F );
+
+            for( auto sliceIndex{ 0 }; sliceIndex < volumeDimension.z; sliceIndex++ )
+            {
+                if( !slicesSeen[sliceIndex] )
+                {
+                    continue;
+                }
+                const auto & xEntries = xTables[sliceIndex].entries;
+                const auto & yTable = yTables[sliceIndex];
+                const auto & yEntries = PixelsEntries( yTable );
+                for( auto yEntryIndex{ yTable.pixelsOffsets[p_yProjPixel] }; yEntryIndex < yTable.pixelsOffsets[p_yProjPixel + 1]; yEntryIndex++ )
+                {
+                    const auto & yEntry = yEntries[yEntryIndex];
+                    if( p_volumeBuffer == nullptr )
+                    {
+                        for( const auto & xEntry : xEntries )
+                        {
+                            rowBuffer[xEntry.pixel] += yEntry.weight * xEntry.weight;
+                        }
+                        continue;
+                    }
+                    const auto * volumeRow = p_volumeBuffer + sliceIndex * sliceSize + static_cast<size_t>( yEntry.voxel ) * volumeDimension.x;
+                    for( const auto & xEntry : xEntries )
+                    {
+                        rowBuffer[xEntry.pixel] += yEntry.weight * xEntry.weight * volumeRow[xEntry.voxel];
+                    }
+                }
+            }
+        };
+        std::for_each( std::execution::par, rowsIndices.begin(), rowsIndices.end(), rowProjector );
+    }
+}
+
+// p_volumeBuffer = W^T p_projectionsBuffer: the same weights as ProjectSlicesTables, scattered back to the voxels.
+// A null p_projectionsBuffer stands for projections of ones, giving the total weight of each voxel.
+// Parallelized over the volume slices, each slice being owned by a single task
+template <typename YTable>
+void BackProjectSlicesTables( const float * p_projectionsBuffer, const ProjectorGeometry & p_geometry, SliceTablesFunction<YTable> p_computeSliceTables, float * p_volumeBuffer )
+{
+    const auto & volumeDimension = p_geometry.volumeDimension;
+    const auto & projectionsDimension = p_geometry.projectionsDimension;
+    const auto sliceSize = static_cast<size_t>( volumeDimension.x ) * volumeDimension.y;
+    const auto projectionSize = static_cast<size_t>( projectionsDimension.x ) * projectionsDimension.y;
+
+    auto slicesIndices = IndexRange{ volumeDimension.z };
+    auto sliceBackProjector = [&]( int p_sliceIndex ) {
+        auto * sliceBuffer = p_volumeBuffer + p_sliceIndex * sliceSize;
+        std::fill( sliceBuffer, sliceBuffer + sliceSize, 0.F );
+        // tables of the worker thread, reused by its next slices
+        thread_local OverlapTable xTable;
+        thread_local YTable yTable;
+
+        for( auto projectionIndex{ 0 }; projectionIndex < projectionsDimension.z; projectionIndex++ )
+        {
+            if( !p_computeSliceTables( p_geometry, projectionIndex, p_sliceIndex, xTable, yTable ) )
+            {
+                continue;
+            }
+            const auto & yEntries = VoxelsEntries( yTable );
+            for( auto yVoxel{ 0 }; yVoxel < volumeDimension.y; yVoxel++ )
+            {
+                auto * volumeRow = sliceBuffer + static_cast<size_t>( yVoxel ) * volumeDimension.x;
+                for( auto yEntryIndex{ yTable.voxelsOffsets[yVoxel] }; yEntryIndex < yTable.voxelsOffsets[yVoxel + 1]; yEntryIndex++ )
+                {
+                    const auto & yEntry = yEntries[yEntryIndex];
+                    if( p_projectionsBuffer == nullptr )
+                    {
+                        for( const auto & xEntry : xTable.entries )
+                        {
+                            volumeRow[xEntry.voxel] += yEntry.weight * xEntry.weight;
+                        }
+                        continue;
+                    }
+                    const auto * projectionRow = p_projectionsBuffer + projectionIndex * projectionSize + static_cast<size_t>( yEntry.pixel ) * projectionsDimension.x;
+                    for( const auto & xEntry : xTable.entries )
+                    {
+                        volumeRow[xEntry.voxel] += yEntry.weight * xEntry.weight * projectionRow[xEntry.pixel];
+                    }
+                }
+            }
+        }
+    };
+    std::for_each( std::execution::par, slicesIndices.begin(), slicesIndices.end(), sliceBackProjector );
+}
+}    // namespace cpuprojector
@@ -0,0 +1,400 @@
+#include "modules/reconstruction/TotalVariation.h"
+
+#include "modules/geometry/IndexedIterator.h"
+#include "modules/reconstruction/ElementWise.h"
+#include "modules/reconstruction/ProjectorSimd.h"
+#include "modules/reconstruction/SimdTargets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <iostream>
+#include <numeric>
+
+namespace    // anonymous namespace
+{
+using namespace totalvariation;
+
+constexpr auto nbPowerIterations{ 20 };
+constexpr auto stepSafetyFactor{ 0.99F };
+
+Float3 InverseSpacing( const Float3 & p_spacing )
+{
+    return { 1.F / p_spacing.x, 1.F / p_spacing.y, 1.F / p_spacing.z };
+}
+
+// p_rowFunction( z, y, offset of the row ) on every row of the volume, in parallel over the slices
+template <typename RowFunction>
+void ForEachRow( const Int3 & p_dimension, RowFunction p_rowFunction )
+{
+    const auto slices = IndexRange{ p_dimension.z };
+    std::for_each( std::execution::par, slices.begin(), slices.end(), [&]( int p_z ) {
+        for( auto y{ 0 }; y < p_dimension.y; y++ )
+        {
+            p_rowFunction( p_z, y, ( static_cast<size_t>( p_z ) * p_dimension.y + y ) * p_dimension.x );
+        }
+    } );
+}
+
+// Rows of the dual step. The next rows along y and z are the row itself on the last row and slice, which gives null differences
+struct DualRows
+{
+    const float * volume;
+    const float * nextYVolume;
+    const float * nextZVolume;
+    float * xField;
+    float * yField;
+    float * zField;
+};
+
+// Rows of the primal step. The field rows before the first ones, and the ones of the last row and slice, are weighted by 0
+struct PrimalRows
+{
+    const float * dataGradient;
+    const float * xField;
+    const float * yField;
+    const float * previousYField;
+    float yFieldWeight;
+    float previousYFieldWeight;
+    const float * zField;
+    const float * previousZField;
+    float zFieldWeight;
+    float previousZFieldWeight;
+    float * volume;
+    float * extrapolatedVolume;
+};
+
+void UpdateDualRow( const DualRows & p_rows, int p_begin, int p_end, int p_nbColumns, const Float3 & p_inverseSpacing, float p_sigma, float p_weight )
+{
+    for( auto x{ p_begin }; x < p_end; x++ )
+    {
+        const auto value = p_rows.volume[x];
+        const auto xGradient = x + 1 < p_nbColumns ? ( p_rows.volume[x + 1] - value ) * p_inverseSpacing.x : 0.F;
+        const auto xField = p_rows.xField[x] + p_sigma * xGradient;
+        const auto yField = p_rows.yField[x] + p_sigma * ( p_rows.nextYVolume[x] - value ) * p_inverseSpacing.y;
+        const auto zField = p_rows.zField[x] + p_sigma * ( p_rows.nextZVolume[x] - value ) * p_inverseSpacing.z;
+        const auto norm = std::sqrt( xField * xField + yField * yField + zField * zField );
+        const auto scale = p_weight / std::max( norm, p_weight );
+        p_rows.xField[x] = scale * xField;
+        p_rows.yField[x] = scale * yField;
+        p_rows.zField[x] = scale * zField;
+    }
+}
+
+void UpdatePrimalRow( const PrimalRows & p_rows, int p_begin, int p_end, int p_nbColumns, const Float3 & p_inverseSpacing, float p_tau, bool p_isNonNegative )
+{
+    for( auto x{ p_begin }; x < p_end; x++ )
+    {
+        const auto xField = x + 1 < p_nbColumns ? p_rows.xField[x] : 0.F;
+        const auto previousXField = x > 0 ? p_rows.xField[x - 1] : 0.F;
+        const auto divergence = ( xField - previousXField ) * p_inverseSpacing.x
+                                + ( p_rows.yFieldWeight * p_rows.yField[x] - p_rows.previousYFieldWeight * p_rows.previousYField[x] ) * p_inverseSpacing.y
+                                + ( p_rows.zFieldWeight * p_rows.zField[x] - p_rows.previousZFieldWeight * p_rows.previousZField[x] ) * p_inverseSpacing.z;
+        const auto value = p_rows.volume[x];
+        auto newValue = value - p_tau * ( p_rows.dataGradient[x] - divergence );
+        if( p_isNonNegative )
+        {
+            newValue = std::max( newValue, 0.F );
+        }
+        p_rows.extrapolatedVolume[x] = 2.F * newValue - value;
+        p_rows.volume[x] = newValue;
+    }
+}
+
+#ifdef TOMO_WITH_X86_SIMD
+// UpdateDualRow with 8 voxels per step, on the voxels having a next voxel along x
+TOMO_TARGET_AVX2 void UpdateDualRowAvx2( const DualRows & p_rows, int p_nbColumns, const Float3 & p_inverseSpacing, float p_sigma, float p_weight )
+{
+    constexpr auto width{ 8 };
+    const auto xStep = _mm256_set1_ps( p_sigma * p_inverseSpacing.x );
+    const auto yStep = _mm256_set1_ps( p_sigma * p_inverseSpacing.y );
+    const auto zStep = _mm256_set1_ps( p_sigma * p_inverseSpacing.z );
+    const auto weight = _mm256_set1_ps( p_weight );
+
+    auto x{ 0 };
+    for( ; x + width < p_nbColumns; x += width )
+    {
+        const auto value = _mm256_loadu_ps( p_rows.volume + x );
+        const auto xField = _mm256_fmadd_ps( xStep, _mm256_sub_ps( _mm256_loadu_ps( p_rows.volume + x + 1 ), value ), _mm256_loadu_ps( p_rows.xField + x ) );
+        const auto yField = _mm256_fmadd_ps( yStep, _mm256_sub_ps( _mm256_loadu_ps( p_rows.nextYVolume + x ), value ), _mm256_loadu_ps( p_rows.yField + x ) );
+        const auto zField = _mm256_fmadd_ps( zStep, _mm256_sub_ps( _mm256_loadu_ps( p_rows.nextZVolume + x ), value ), _mm256_loadu_ps( p_rows.zField + x ) );
+        const auto squaredNorm = _mm256_fmadd_ps( xField, xField, _mm256_fmadd_ps( yField, yField, _mm256_mul_ps( zField, zField ) ) );
+        const auto scale = _mm256_div_ps( weight, _mm256_max_ps( _mm256_sqrt_ps( squaredNorm ), weight ) );
+        _mm256_storeu_ps( p_rows.xField + x, _mm256_mul_ps( scale, xField ) );
+        _mm256_storeu_ps( p_rows.yField + x, _mm256_mul_ps( scale, yField ) );
+        _mm256_storeu_ps( p_rows.zField + x, _mm256_mul_ps( scale, zField ) );
+    }
+    UpdateDualRow( p_rows, x, p_nbColumns, p_nbColumns, p_inverseSpacing, p_sigma, p_weight );
+}
+
+// UpdatePrimalRow with 8 voxels per step, on the voxels having a previous and a next voxel along x
+TOMO_TARGET_AVX2 void UpdatePrimalRowAvx2( const PrimalRows & p_rows, int p_nbColumns, const Float3 & p_inverseSpacing, float p_tau, bool p_isNonNegative )
+{
+    constexpr auto width{ 8 };
+    const auto xInverseSpacing = _mm256_set1_ps( p_inverseSpacing.x );
+    const auto yFieldWeight = _mm256_set1_ps( p_rows.yFieldWeight * p_inverseSpacing.y );
+    const auto previousYFieldWeight = _mm256_set1_ps( p_rows.previousYFieldWeight * p_inverseSpacing.y );
+    const auto zFieldWeight = _mm256_set1_ps( p_rows.zFieldWeight * p_inverseSpacing.z );
+    const auto previousZFieldWeight = _mm256_set1_ps( p_rows.previousZFieldWeight * p_inverseSpacing.z );
+    const auto tau = _mm256_set1_ps( p_tau );
+    const auto two = _mm256_set1_ps( 2.F );
+    const auto zero = _mm256_setzero_ps();
+
+    UpdatePrimalRow( p_rows, 0, std::min( 1, p_nbColumns ), p_nbColumns, p_inverseSpacing, p_tau, p_isNonNegative );
+    auto x{ 1 };
+    for( ; x + width < p_nbColumns; x += width )
+    {
+        auto divergence = _mm256_mul_ps( xInverseSpacing, _mm256_sub_ps( _mm256_loadu_ps( p_rows.xField + x ), _mm256_loadu_ps( p_rows.xField + x - 1 ) ) );
+        divergence = _mm256_fmadd_ps( yFieldWeight, _mm256_loadu_ps( p_rows.yField + x ), divergence );
+        divergence = _mm256_fnmadd_ps( previousYFieldWeight, _mm256_loadu_ps( p_rows.previousYField + x ), divergence );
+        divergence = _mm256_fmadd_ps( zFieldWeight, _mm256_loadu_ps( p_rows.zField + x ), divergence );
+        divergence = _mm256_fnmadd_ps( previousZFieldWeight, _mm256_loadu_ps( p_rows.previousZField + x ), divergence );
+        const auto value = _mm256_loadu_ps( p_rows.volume + x );
+        auto newValue = _mm256_fnmadd_ps( tau, _mm256_sub_ps( _mm256_loadu_ps( p_rows.dataGradient + x ), divergence ), value );
+        if( p_isNonNegative )
+        {
+            newValue = _mm256_max_ps( newValue, zero );
+        }
+        _mm256_storeu_ps( p_rows.extrapolatedVolume + x, _mm256_fmsub_ps( two, newValue, value ) );
+        _mm256_storeu_ps( p_rows.volume + x, newValue );
+    }
+    UpdatePrimalRow( p_rows, x, p_nbColumns, p_nbColumns, p_inverseSpacing, p_tau, p_isNonNegative );
+}
+#endif
+}    // end of anonymous namespace
+
+namespace totalvariation
+{
+void ComputeGradient( const float * p_volumeBuffer,
+                      const Int3 & p_dimension,
+                      const Float3 & p_spacing,
+                      float * p_xGradientBuffer,
+                      float * p_yGradientBuffer,
+                      float * p_zGradientBuffer )
+{
+    const auto inverseSpacing = InverseSpacing( p_spacing );
+    const auto sliceSize = static_cast<size_t>( p_dimension.x ) * p_dimension.y;
+    ForEachRow( p_dimension, [&]( int p_z, int p_y, size_t p_offset ) {
+        const auto nextYOffset = p_y + 1 < p_dimension.y ? p_offset + p_dimension.x : p_offset;
+        const auto nextZOffset = p_z + 1 < p_dimension.z ? p_offset + sliceSize : p_offset;
+        for( auto x{ 0 }; x < p_dimension.x; x++ )
+        {
+            const auto value = p_volumeBuffer[p_offset + x];
+            p_xGradientBuffer[p_offset + x] = x + 1 < p_dimension.x ? ( p_volumeBuffer[p_offset + x + 1] - value ) * inverseSpacing.x : 0.F;
+            p_yGradientBuffer[p_offset + x] = ( p_volumeBuffer[nextYOffset + x] - value ) * inverseSpacing.y;
+            p_zGradientBuffer[p_offset + x] = ( p_volumeBuffer[nextZOffset + x] - value ) * inverseSpacing.z;
+        }
+    } );
+}
+
+void ComputeDivergence( const float * p_xFieldBuffer,
+                        const float * p_yFieldBuffer,
+                        const float * p_zFieldBuffer,
+                        const Int3 & p_dimension,
+                        const Float3 & p_spacing,
+                        float * p_divergenceBuffer )
+{
+    const auto inverseSpacing = InverseSpacing( p_spacing );
+    const auto sliceSize = static_cast<size_t>( p_dimension.x ) * p_dimension.y;
+    ForEachRow( p_dimension, [&]( int p_z, int p_y, size_t p_offset ) {
+        const auto yFieldWeight = p_y + 1 < p_dimension.y ? 1.F : 0.F;
+        const auto previousYOffset = p_y > 0 ? p_offset - p_dimension.x : p_offset;
+        const auto previousYFieldWeight = p_y > 0 ? 1.F : 0.F;
+        const auto zFieldWeight = p_z + 1 < p_dimension.z ? 1.F : 0.F;
+        const auto previousZOffset = p_z > 0 ? p_offset - sliceSize : p_offset;
+        const auto previousZFieldWeight = p_z > 0 ? 1.F : 0.F;
+        for( auto x{ 0 }; x < p_dimension.x; x++ )
+        {
+            const auto xField = x + 1 < p_dimension.x ? p_xFieldBuffer[p_offset + x] : 0.F;
+            const auto previousXField = x > 0 ? p_xFieldBuffer[p_offset + x - 1] : 0.F;
+            p_divergenceBuffer[p_offset + x] = ( xField - previousXField ) * inverseSpacing.x
+                                               + ( yFieldWeight * p_yFieldBuffer[p_offset + x] - previousYFieldWeight * p_yFieldBuffer[previousYOffset + x] ) * inverseSpacing.y
+                                               + ( zFieldWeight * p_zFieldBuffer[p_offset + x] - previousZFieldWeight * p_zFieldBuffer[previousZOffset + x] ) * inverseSpacing.z;
+        }
+    } );
+}
+
+void UpdateDualField( const float * p_volumeBuffer,
+                      const Int3 & p_dimension,
+                      const Float3 & p_spacing,
+                      float p_sigma,
+                      float p_weight,
+                      float * p_xFieldBuffer,
+                      float * p_yFieldBuffer,
+                      float * p_zFieldBuffer )
+{
+    const auto voxelsNumber = static_cast<size_t>( p_dimension.x ) * p_dimension.y * p_dimension.z;
+    if( p_weight <= 0.F )
+    {
+        // no regularization: the field stays null
+        std::fill( p_xFieldBuffer, p_xFieldBuffer + voxelsNumber, 0.F );
+        std::fill( p_yFieldBuffer, p_yFieldBuffer + voxelsNumber, 0.F );
+        std::fill( p_zFieldBuffer, p_zFieldBuffer + voxelsNumber, 0.F );
+        return;
+    }
+    static const auto useAvx2 = cpuprojector::DetectSimdLevel() >= cpuprojector::SimdLevel::Avx2;
+    const auto inverseSpacing = InverseSpacing( p_spacing );
+    const auto sliceSize = static_cast<size_t>( p_dimension.x ) * p_dimension.y;
+    ForEachRow( p_dimension, [&]( int p_z, int p_y, size_t p_offset ) {
+        DualRows rows{ p_volumeBuffer + p_offset,
+                       p_volumeBuffer + ( p_y + 1 < p_dimension.y ? p_offset + p_dimension.x : p_offset ),
+                       p_volumeBuffer + ( p_z + 1 < p_dimension.z ? p_offset + sliceSize : p_offset ),
+                       p_xFieldBuffer + p_offset,
+                       p_yFieldBuffer + p_offset,
+                       p_zFieldBuffer + p_offset };
+#ifdef TOMO_WITH_X86_SIMD
+        if( useAvx2 )
+        {
+            UpdateDualRowAvx2( rows, p_dimension.x, inverseSpacing, p_sigma, p_weight );
+            return;
+        }
+#endif
+        UpdateDualRow( rows, 0, p_dimension.x, p_dimension.x, inverseSpacing, p_sigma, p_weight );
+    } );
+}
+
+void UpdatePrimalVolume( const float * p_dataGradientBuffer,
+                         const float * p_xFieldBuffer,
+                         const float * p_yFieldBuffer,
+                         const float * p_zFieldBuffer,
+                         const Int3 & p_dimension,
+                         const Float3 & p_spacing,
+                         float p_tau,
+                         bool p_isNonNegative,
+                         float * p_volumeBuffer,
+                         float * p_extrapolatedVolumeBuffer )
+{
+    static const auto useAvx2 = cpuprojector::DetectSimdLevel() >= cpuprojector::SimdLevel::Avx2;
+    const auto inverseSpacing = InverseSpacing( p_spacing );
+    const auto sliceSize = static_cast<size_t>( p_dimension.x ) * p_dimension.y;
+    ForEachRow( p_dimension, [&]( int p_z, int p_y, size_t p_offset ) {
+        PrimalRows rows{ p_dataGradientBuffer + p_offset,
+                         p_xFieldBuffer + p_offset,
+                         p_yFieldBuffer + p_offset,
+                         p_yFieldBuffer + ( p_y > 0 ? p_offset - p_dimension.x : p_offset ),
+                         p_y + 1 < p_dimension.y ? 1.F : 0.F,
+                         p_y > 0 ? 1.F : 0.F,
+                         p_zFieldBuffer + p_offset,
+                         p_zFieldBuffer + ( p_z > 0 ? p_offset - sliceSize : p_offset ),
+                         p_z + 1 < p_dimension.z ? 1.F : 0.F,
+                         p_z > 0 ? 1.F : 0.F,
+                         p_volumeBuffer + p_offset,
+                         p_extrapolatedVolumeBuffer + p_offset };
+#ifdef TOMO_WITH_X86_SIMD
+        if( useAvx2 )
+        {
+            UpdatePrimalRowAvx2( rows, p_dimension.x, inverseSpacing, p_tau, p_isNonNegative );
+            return;
+        }
+#endif
+        UpdatePrimalRow( rows, 0, p_dimension.x, p_dimension.x, inverseSpacing, p_tau, p_isNonNegative );
+    } );
+}
+}    // namespace totalvariation
+
+TotalVariationSolver::TotalVariationSolver( TomoGeometry const * p_tomoGeometry )
+  : m_plan{ p_tomoGeometry, ProjectorBackend::CpuMatched }
+{
+    if( !m_plan.IsValid() )
+    {
+        return;
+    }
+    const auto & geometry = m_plan.GetGeometry();
+    m_extrapolatedVolume.resize( geometry.GetVolumeVoxelsNumber() );
+    m_dataGradient.resize( geometry.GetVolumeVoxelsNumber() );
+    m_xField.resize( geometry.GetVolumeVoxelsNumber() );
+    m_yField.resize( geometry.GetVolumeVoxelsNumber() );
+    m_zField.resize( geometry.GetVolumeVoxelsNumber() );
+    m_dualProjections.resize( geometry.GetProjectionsPixelsNumber() );
+    m_currentProjections.resize( geometry.GetProjectionsPixelsNumber() );
+}
+
+float TotalVariationSolver::GetOperatorNorm()
+{
+    if( m_operatorNorm > 0.F || !this->IsValid() )
+    {
+        return m_operatorNorm;
+    }
+    const auto & geometry = m_plan.GetGeometry();
+
+    // v <- ( A^T A - div grad ) v / || . ||, the work buffers being free before any solve
+    auto & vector = m_extrapolatedVolume;
+    auto & image = m_dataGradient;
+    std::fill( vector.begin(), vector.end(), 1.F / std::sqrt( static_cast<float>( vector.size() ) ) );
+    auto eigenValue{ 0. };
+    for( auto iteration{ 0 }; iteration < nbPowerIterations; iteration++ )
+    {
+        m_plan.Project( vector.data(), m_currentProjections.data() );
+        m_plan.BackProject( m_currentProjections.data(), image.data() );
+        ComputeGradient( vector.data(), geometry.volumeDimension, geometry.volumeVoxelsSpacing, m_xField.data(), m_yField.data(), m_zField.data() );
+        ComputeDivergence( m_xField.data(), m_yField.data(), m_zField.data(), geometry.volumeDimension, geometry.volumeVoxelsSpacing, vector.data() );
+        eigenValue = std::sqrt( elementwise::Xpby( image.data(), -1.F, vector.data(), vector.size() ) );
+        if( eigenValue <= 0. )
+        {
+            break;
+        }
+        const auto inverseNorm = static_cast<float>( 1. / eigenValue );
+        elementwise::Scale( inverseNorm, vector.data(), vector.size() );
+    }
+    m_operatorNorm = static_cast<float>( std::sqrt( eigenValue ) );
+    return m_operatorNorm;
+}
+
+std::vector<double> TotalVariationSolver::Solve( const float * p_projectionsBuffer, int p_iterationNumber, float p_weight, bool p_isNonNegative, float * p_volumeBuffer )
+{
+    if( !this->IsValid() || this->GetOperatorNorm() <= 0.F )
+    {
+        std::cout << "TotalVariationSolver: invalid plan or null operator" << std::endl;
+        return {};
+    }
+    const auto & geometry = m_plan.GetGeometry();
+    const auto step = stepSafetyFactor / m_operatorNorm;
+    const auto sigma = step;
+    const auto tau = step;
+    const auto dualScale = 1.F / ( 1.F + sigma );
+
+    std::copy( p_volumeBuffer, p_volumeBuffer + geometry.GetVolumeVoxelsNumber(), m_extrapolatedVolume.begin() );
+    std::fill( m_xField.begin(), m_xField.end(), 0.F );
+    std::fill( m_yField.begin(), m_yField.end(), 0.F );
+    std::fill( m_zField.begin(), m_zField.end(), 0.F );
+    std::fill( m_dualProjections.begin(), m_dualProjections.end(), 0.F );
+
+    std::vector<double> residualNorms;
+    const auto projections = IndexRange{ geometry.projectionsDimension.z };
+    const auto projectionPixelsNumber = static_cast<size_t>( geometry.projectionsDimension.x ) * geometry.projectionsDimension.y;
+    std::vector<double> projectionsResidualSquaredNorms( projections.size() );
+    for( auto iteration{ 0 }; iteration < p_iterationNumber; iteration++ )
+    {
+        // data dual step q = ( q + sigma ( A x_bar - b ) ) / ( 1 + sigma ), with the residual norm, in one pass
+        m_plan.Project( m_extrapolatedVolume.data(), m_currentProjections.data() );
+        std::for_each( std::execution::par, projections.begin(), projections.end(), [&]( int p_projectionIndex ) {
+            auto residualSquaredNorm{ 0. };
+            const auto offset = p_projectionIndex * projectionPixelsNumber;
+            for( auto pixelIndex = offset; pixelIndex < offset + projectionPixelsNumber; pixelIndex++ )
+            {
+                const auto residual = m_currentProjections[pixelIndex] - p_projectionsBuffer[pixelIndex];
+                residualSquaredNorm += static_cast<double>( residual ) * residual;
+                m_dualProjections[pixelIndex] = dualScale * ( m_dualProjections[pixelIndex] + sigma * residual );
+            }
+            projectionsResidualSquaredNorms[p_projectionIndex] = residualSquaredNorm;
+        } );
+        residualNorms.push_back( std::sqrt( std::accumulate( projectionsResidualSquaredNorms.cbegin(), projectionsResidualSquaredNorms.cend(), 0. ) ) );
+
+        // TV dual step
+        UpdateDualField( m_extrapolatedVolume.data(), geometry.volumeDimension, geometry.volumeVoxelsSpacing, sigma, p_weight, m_xField.data(), m_yField.data(), m_zField.data() );
+
+        // primal step with A^T q
+        m_plan.BackProject( m_dualProjections.data(), m_dataGradient.data() );
+        UpdatePrimalVolume( m_dataGradient.data(),
+                            m_xField.data(),
+                            m_yField.data(),
+                            m_zField.data(),
+                            geometry.volumeDimension,
+                            geometry.volumeVoxelsSpacing,
+                            tau,
+                            p_isNonNegative,
+                            p_volumeBuffer,
+                            m_extrapolatedVolume.data() );
+    }
+    return residualNorms;
+}
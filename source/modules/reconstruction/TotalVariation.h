@@ -0,0 +1,81 @@
+#pragma once
+
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ProjectorGeometry.h"
+#include "modules/reconstruction/ProjectorPlan.h"
+
+#include <vector>
+
+// Discrete gradient and divergence on the volume grid (x fastest, then y, then z), with the voxels spacings:
+// the gradient is made of forward differences divided by the spacing, null on the last voxel of each axis (Neumann
+// boundary), and the divergence is exactly minus its adjoint. Volumes are processed by rows in parallel over the
+// slices, with AVX2 rows when available.
+namespace totalvariation
+{
+void ComputeGradient( const float * p_volumeBuffer,
+                      const Int3 & p_dimension,
+                      const Float3 & p_spacing,
+                      float * p_xGradientBuffer,
+                      float * p_yGradientBuffer,
+                      float * p_zGradientBuffer );
+void ComputeDivergence( const float * p_xFieldBuffer,
+                        const float * p_yFieldBuffer,
+                        const float * p_zFieldBuffer,
+                        const Int3 & p_dimension,
+                        const Float3 & p_spacing,
+                        float * p_divergenceBuffer );
+
+// Dual step of the isotropic TV: p = p + sigma grad( x ), then projected on the ball of radius p_weight, in one pass
+void UpdateDualField( const float * p_volumeBuffer,
+                      const Int3 & p_dimension,
+                      const Float3 & p_spacing,
+                      float p_sigma,
+                      float p_weight,
+                      float * p_xFieldBuffer,
+                      float * p_yFieldBuffer,
+                      float * p_zFieldBuffer );
+
+// Primal step: x_new = x - tau ( g - div( p ) ), clamped to 0 if p_isNonNegative, then x_bar = 2 x_new - x and x = x_new, in one pass
+void UpdatePrimalVolume( const float * p_dataGradientBuffer,
+                         const float * p_xFieldBuffer,
+                         const float * p_yFieldBuffer,
+                         const float * p_zFieldBuffer,
+                         const Int3 & p_dimension,
+                         const Float3 & p_spacing,
+                         float p_tau,
+                         bool p_isNonNegative,
+                         float * p_volumeBuffer,
+                         float * p_extrapolatedVolumeBuffer );
+}    // namespace totalvariation
+
+// Chambolle-Pock (primal-dual hybrid gradient) solver of min 1/2 || A x - b ||^2 + weight TV( x ), A being the
+// projection of a CpuMatched ProjectorPlan (its back projection is the adjoint A^T).
+// The step sizes are tau = sigma = 1 / L, L being the norm of [ A ; grad ] estimated by power iteration once per solver.
+// All the work buffers (five volumes, two projections stacks) are allocated in the constructor.
+class TotalVariationSolver
+{
+public:
+    TotalVariationSolver( TomoGeometry const * p_tomoGeometry );
+    ~TotalVariationSolver() = default;
+
+    bool IsValid() const { return m_plan.IsValid(); }
+    ProjectorPlan & GetPlan() { return m_plan; }
+
+    // power iteration on A^T A - div grad, computed at the first call only
+    float GetOperatorNorm();
+
+    // p_volumeBuffer is the initial guess and receives the solution.
+    // Return the data residual norms || A x_bar - b || of the iterations, x_bar being the extrapolated volume
+    std::vector<double> Solve( const float * p_projectionsBuffer, int p_iterationNumber, float p_weight, bool p_isNonNegative, float * p_volumeBuffer );
+
+private:
+    ProjectorPlan m_plan;
+    float m_operatorNorm{ 0.F };
+    std::vector<float> m_extrapolatedVolume;
+    std::vector<float> m_dataGradient;
+    std::vector<float> m_xField;
+    std::vector<float> m_yField;
+    std::vector<float> m_zField;
+    std::vector<float> m_dualProjections;
+    std::vector<float> m_currentProjections;
+};
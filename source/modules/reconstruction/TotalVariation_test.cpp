@@ -0,0 +1,74 @@
+#include "modules/geometry/TomoGeometry.h"
+#include "modules/reconstruction/ReconstructionTestUtils.h"
+#include "modules/reconstruction/TotalVariation.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+constexpr double adjointRelativeTolerance = 0.0001;    // | <Ax, y> - <x, A^T y> | / | <Ax, y> |
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( TotalVariationTest, TotalVariationDivergenceIsMinusGradientAdjoint )
+{
+    // anisotropic spacings, and rows long enough for the vectorized path and its tails
+    const Int3 dimension{ 21, 7, 5 };
+    const Float3 spacing{ 0.5F, 1.5F, 3.F };
+    const auto size = dimension.x * dimension.y * dimension.z;
+    const auto volume = RandomBuffer( size, 8U );
+    const auto xField = RandomBuffer( size, 9U );
+    const auto yField = RandomBuffer( size, 10U );
+    const auto zField = RandomBuffer( size, 11U );
+    std::vector<float> xGradient( size ), yGradient( size ), zGradient( size ), divergence( size );
+    totalvariation::ComputeGradient( volume.data(), dimension, spacing, xGradient.data(), yGradient.data(), zGradient.data() );
+    totalvariation::ComputeDivergence( xField.data(), yField.data(), zField.data(), dimension, spacing, divergence.data() );
+    const auto gradientDot = Dot( xGradient, xField ) + Dot( yGradient, yField ) + Dot( zGradient, zField );
+    EXPECT_NEAR( gradientDot, -Dot( volume, divergence ), adjointRelativeTolerance * std::fabs( gradientDot ) );
+
+    // fused primal step with tau = 1 and a null data term: x_new = x + div( p )
+    std::vector<float> updatedVolume( volume );
+    std::vector<float> extrapolatedVolume( size );
+    const std::vector<float> nullDataGradient( size, 0.F );
+    totalvariation::UpdatePrimalVolume( nullDataGradient.data(), xField.data(), yField.data(), zField.data(), dimension, spacing, 1.F, false, updatedVolume.data(), extrapolatedVolume.data() );
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        ASSERT_NEAR( updatedVolume[index], volume[index] + divergence[index], 0.0001 );
+        ASSERT_NEAR( extrapolatedVolume[index], volume[index] + 2.F * divergence[index], 0.0001 );
+    }
+
+    // fused dual step with a huge weight and sigma = 1: p_new = p + grad( x )
+    std::vector<float> updatedXField( xField ), updatedYField( yField ), updatedZField( zField );
+    totalvariation::UpdateDualField( volume.data(), dimension, spacing, 1.F, 1.e6F, updatedXField.data(), updatedYField.data(), updatedZField.data() );
+    for( auto index{ 0 }; index < size; index++ )
+    {
+        ASSERT_NEAR( updatedXField[index], xField[index] + xGradient[index], 0.0001 );
+        ASSERT_NEAR( updatedYField[index], yField[index] + yGradient[index], 0.0001 );
+        ASSERT_NEAR( updatedZField[index], zField[index] + zGradient[index], 0.0001 );
+    }
+}
+
+TEST( TotalVariationTest, TotalVariationSolverDecreasesResidual )
+{
+    for( const auto & path : GeometriesFilesPaths() )
+    {
+        TomoGeometry tomoGeometry( path.string() );
+        TotalVariationSolver solver( &tomoGeometry );
+        ASSERT_TRUE( solver.IsValid() ) << path;
+        EXPECT_GT( solver.GetOperatorNorm(), 0.F ) << path;
+        const auto & geometry = solver.GetPlan().GetGeometry();
+        const auto volume = SmoothVolume( geometry );
+        std::vector<float> projections( geometry.GetProjectionsPixelsNumber() );
+        solver.GetPlan().Project( volume.data(), projections.data() );
+
+        std::vector<float> solution( volume.size(), 0.F );
+        const auto residualNorms = solver.Solve( projections.data(), 30, 0.001F, true, solution.data() );
+        ASSERT_EQ( residualNorms.size(), 30U ) << path;
+        EXPECT_LT( residualNorms.back(), 0.5 * residualNorms.front() ) << path;
+        EXPECT_TRUE( std::all_of( solution.cbegin(), solution.cend(), []( float p_value ) { return p_value >= 0.F; } ) ) << path;
+    }
+}
@@ -0,0 +1,165 @@
+#include "modules/reconstruction/VerboseImageWriter.h"
+
+#include <vtkTIFFWriter.h>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+void WriteTiff( vtkImageData * p_image, const std::string & p_filePath )
+{
+    auto tiffWriter = vtkSmartPointer<vtkTIFFWriter>::New();
+    tiffWriter->SetFileName( p_filePath.c_str() );
+    tiffWriter->SetInputData( p_image );
+    tiffWriter->Write();
+}
+
+VerboseImageWriter::VerboseImageWriter( const std::string & p_outputDirectoryPath, const VerboseOutputOptions & p_options, ImageFileWriter p_fileWriter )
+  : m_outputDirectoryPath{ p_outputDirectoryPath }
+  , m_options{ p_options }
+  , m_fileWriter{ std::move( p_fileWriter ) }
+{
+    m_options.iterationStep = std::max( 1, m_options.iterationStep );
+    m_options.queueCapacity = std::max( 1, m_options.queueCapacity );
+    m_worker = std::thread( &VerboseImageWriter::Run, this );
+}
+
+VerboseImageWriter::~VerboseImageWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_isStopping = true;
+    }
+    m_queueChanged.notify_all();
+    m_worker.join();
+}
+
+bool VerboseImageWriter::IsIterationWritten( int p_iteration ) const
+{
+    return p_iteration % m_options.iterationStep == 0;
+}
+
+void VerboseImageWriter::WriteVolume( vtkImageData * p_volume, const std::string & p_fileName )
+{
+    this->WriteSnapshot( p_volume, m_options.volumeSlices, p_fileName );
+}
+
+void VerboseImageWriter::WriteProjections( vtkImageData * p_projections, const std::string & p_fileName )
+{
+    this->WriteSnapshot( p_projections, m_options.projectionIndices, p_fileName );
+}
+
+void VerboseImageWriter::WriteUnmodified( ImageDataPtr p_image, const std::string & p_fileName )
+{
+    if( p_image == nullptr )
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_queueChanged.wait( lock, [this]() { return m_nbPendingJobs < m_options.queueCapacity; } );
+    m_nbPendingJobs++;
+    m_queue.push_back( Job{ p_image, m_outputDirectoryPath + p_fileName, false } );
+    m_queueChanged.notify_all();
+}
+
+void VerboseImageWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_queueChanged.wait( lock, [this]() { return m_nbPendingJobs == 0; } );
+}
+
+void VerboseImageWriter::WriteSnapshot( vtkImageData * p_image, const std::vector<int> & p_slices, const std::string & p_fileName )
+{
+    if( p_image == nullptr )
+    {
+        return;
+    }
+    if( p_image->GetScalarType() != VTK_FLOAT )
+    {
+        std::cout << "VerboseImageWriter: " << p_fileName << " is not a float image, it is not written" << std::endl;
+        return;
+    }
+    int dimensions[3];
+    p_image->GetDimensions( dimensions );
+    std::vector<int> slices;
+    for( auto slice : p_slices )
+    {
+        if( slice >= 0 && slice < dimensions[2] )
+        {
+            slices.push_back( slice );
+        }
+    }
+    if( p_slices.empty() )
+    {
+        slices.resize( dimensions[2] );
+        std::iota( slices.begin(), slices.end(), 0 );
+    }
+    if( slices.empty() )
+    {
+        return;
+    }
+
+    // the slot is taken before the copy, so that the snapshots stay within the queue capacity
+    ImageDataPtr snapshot;
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_queueChanged.wait( lock, [this]() { return m_nbPendingJobs < m_options.queueCapacity; } );
+        m_nbPendingJobs++;
+        const auto freeSnapshot = std::find_if( m_freeSnapshots.begin(), m_freeSnapshots.end(), [&]( const ImageDataPtr & p_snapshot ) {
+            const auto snapshotDimensions = p_snapshot->GetDimensions();
+            return snapshotDimensions[0] == dimensions[0] && snapshotDimensions[1] == dimensions[1] && snapshotDimensions[2] == static_cast<int>( slices.size() );
+        } );
+        if( freeSnapshot != m_freeSnapshots.end() )
+        {
+            snapshot = *freeSnapshot;
+            m_freeSnapshots.erase( freeSnapshot );
+        }
+    }
+    if( snapshot == nullptr )
+    {
+        snapshot = ImageDataPtr::New();
+        snapshot->SetDimensions( dimensions[0], dimensions[1], static_cast<int>( slices.size() ) );
+        snapshot->AllocateScalars( VTK_FLOAT, 1 );
+    }
+    snapshot->SetSpacing( p_image->GetSpacing() );
+    snapshot->SetOrigin( p_image->GetOrigin() );
+
+    const auto sliceSize = static_cast<size_t>( dimensions[0] ) * dimensions[1];
+    const auto sourceBuffer = static_cast<const float *>( p_image->GetScalarPointer() );
+    auto snapshotBuffer = static_cast<float *>( snapshot->GetScalarPointer() );
+    for( size_t index{ 0 }; index < slices.size(); index++ )
+    {
+        std::copy_n( sourceBuffer + slices[index] * sliceSize, sliceSize, snapshotBuffer + index * sliceSize );
+    }
+    snapshot->Modified();
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_queue.push_back( Job{ snapshot, m_outputDirectoryPath + p_fileName, true } );
+    m_queueChanged.notify_all();
+}
+
+void VerboseImageWriter::Run()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while( true )
+    {
+        m_queueChanged.wait( lock, [this]() { return !m_queue.empty() || m_isStopping; } );
+        if( m_queue.empty() )
+        {
+            return;
+        }
+        auto job = std::move( m_queue.front() );
+        m_queue.pop_front();
+
+        lock.unlock();
+        m_fileWriter( job.image, job.filePath );
+        lock.lock();
+
+        if( job.isSnapshot && static_cast<int>( m_freeSnapshots.size() ) < m_options.queueCapacity )
+        {
+            m_freeSnapshots.push_back( job.image );
+        }
+        m_nbPendingJobs--;
+        m_queueChanged.notify_all();
+    }
+}
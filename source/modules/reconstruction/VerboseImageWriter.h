@@ -0,0 +1,72 @@
+#pragma once
+
+#include "commons/ImageDataPtr.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// What the reconstructors write in verbose mode
+struct VerboseOutputOptions
+{
+    int iterationStep{ 1 };                // the iterations 0, N, 2N, ... are written
+    std::vector<int> volumeSlices;         // written slices of the volumes (empty: all)
+    std::vector<int> projectionIndices;    // written projections of the projections stacks (empty: all)
+    int queueCapacity{ 4 };                // images waiting for their writing, the reconstruction waits beyond
+};
+
+// writing of an image to a file path, vtkTIFFWriter by default
+using ImageFileWriter = std::function<void( vtkImageData *, const std::string & )>;
+
+void WriteTiff( vtkImageData * p_image, const std::string & p_filePath );
+
+// Background writer of the verbose mode images: the reconstruction thread only copies the selected slices into a
+// recycled snapshot image, the file writing is done by a worker thread. The queue is bounded by queueCapacity, which
+// also bounds the snapshots memory. The queued images are all written at Flush or destruction
+class VerboseImageWriter
+{
+public:
+    VerboseImageWriter( const std::string & p_outputDirectoryPath, const VerboseOutputOptions & p_options, ImageFileWriter p_fileWriter = WriteTiff );
+    ~VerboseImageWriter();
+    VerboseImageWriter( const VerboseImageWriter & ) = delete;
+    VerboseImageWriter & operator=( const VerboseImageWriter & ) = delete;
+
+    bool IsIterationWritten( int p_iteration ) const;
+
+    // snapshot of the selected slices (resp. projections), written as <output directory><p_fileName>
+    void WriteVolume( vtkImageData * p_volume, const std::string & p_fileName );
+    void WriteProjections( vtkImageData * p_projections, const std::string & p_fileName );
+
+    // queued without copy: p_image must not be modified before Flush or the writer destruction
+    void WriteUnmodified( ImageDataPtr p_image, const std::string & p_fileName );
+
+    // wait until the queued images are written
+    void Flush();
+
+private:
+    struct Job
+    {
+        ImageDataPtr image;
+        std::string filePath;
+        bool isSnapshot{ false };    // recycled once written
+    };
+
+    void WriteSnapshot( vtkImageData * p_image, const std::vector<int> & p_slices, const std::string & p_fileName );
+    void Run();
+
+    std::string m_outputDirectoryPath;
+    VerboseOutputOptions m_options;
+    ImageFileWriter m_fileWriter;
+
+    std::mutex m_mutex;
+    std::condition_variable m_queueChanged;
+    std::deque<Job> m_queue;
+    int m_nbPendingJobs{ 0 };    // queued or being written
+    std::vector<ImageDataPtr> m_freeSnapshots;
+    bool m_isStopping{ false };
+    std::thread m_worker;
+};
@@ -0,0 +1,67 @@
+#include "modules/reconstruction/VerboseImageWriter.h"
+#include "test_utils/TestInitializer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main( int p_argc, char ** p_argv )
+{
+    return LaunchTest( p_argc, p_argv );
+}
+
+TEST( VerboseImageWriterTest, VerboseImageWriterSnapshotsSelectedSlices )
+{
+    // slow writes, so that the queue fills up
+    std::mutex writtenMutex;
+    std::map<std::string, std::vector<float>> writtenImages;
+    std::map<std::string, std::vector<int>> writtenDimensions;
+    const auto fileWriter = [&]( vtkImageData * p_image, const std::string & p_filePath ) {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+        const auto dimensions = p_image->GetDimensions();
+        const auto buffer = static_cast<const float *>( p_image->GetScalarPointer() );
+        std::lock_guard<std::mutex> lock( writtenMutex );
+        writtenImages[p_filePath].assign( buffer, buffer + dimensions[0] * dimensions[1] * dimensions[2] );
+        writtenDimensions[p_filePath] = { dimensions[0], dimensions[1], dimensions[2] };
+    };
+
+    auto volume = ImageDataPtr::New();
+    volume->SetDimensions( 3, 2, 4 );
+    volume->AllocateScalars( VTK_FLOAT, 1 );
+    auto volumeBuffer = static_cast<float *>( volume->GetScalarPointer() );
+
+    VerboseOutputOptions options;
+    options.iterationStep = 2;
+    options.volumeSlices = { 3, 1, 7 };    // 7 is out of the volume
+    options.queueCapacity = 2;
+    {
+        VerboseImageWriter writer( "out/", options, fileWriter );
+        for( auto iteration{ 0 }; iteration < 6; iteration++ )
+        {
+            // the snapshot is taken at the call: the volume can be modified right after
+            std::fill( volumeBuffer, volumeBuffer + 24, static_cast<float>( iteration ) );
+            volumeBuffer[3 * 6] = 100.F + iteration;
+            if( writer.IsIterationWritten( iteration ) )
+            {
+                writer.WriteVolume( volume, "step" + std::to_string( iteration ) + ".tiff" );
+                writer.WriteProjections( volume, "projections" + std::to_string( iteration ) + ".tiff" );
+            }
+        }
+        writer.Flush();
+        EXPECT_EQ( writtenImages.size(), 6U );
+    }
+
+    for( auto iteration : { 0, 2, 4 } )
+    {
+        const auto & slices = writtenImages["out/step" + std::to_string( iteration ) + ".tiff"];
+        EXPECT_EQ( writtenDimensions["out/step" + std::to_string( iteration ) + ".tiff"], std::vector<int>( { 3, 2, 2 } ) );
+        ASSERT_EQ( slices.size(), 12U );
+        EXPECT_EQ( slices[0], 100.F + iteration );
+        EXPECT_TRUE( std::all_of( slices.cbegin() + 1, slices.cend(), [iteration]( float p_value ) { return p_value == static_cast<float>( iteration ); } ) );
+        EXPECT_EQ( writtenImages["out/projections" + std::to_string( iteration ) + ".tiff"].size(), 24U );
+    }
+}